@@ -273,7 +273,7 @@
 (defn print-jump-table
   [defs]
   (let [code-prims (->> defs (filter-vals :code?) sort-defs vals)
-        all-token-values (zipmap (range 0x70)
+        all-token-values (zipmap (range 0x78)
                                  (repeat nil))
         token-value-names (zipmap (map :token-value code-prims)
                                   (map :token-name code-prims))
@@ -26,13 +26,19 @@
 #include <stddef.h>
 #include <string.h>
 
+/* SIMD includes. */
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /* AVR includes. */
 #ifdef __AVR__
 #include <avr/pgmspace.h>
+#include <util/atomic.h>
 #else
 #define PROGMEM
 #define pgm_read_byte(p) (*(uint8_t*)(p))
-#define pgm_read_word(p) (*(int *)(p))
+#define pgm_read_word(p) (*(uintptr_t *)(p))
 #endif
 
 /* Enforth includes. */
@@ -48,29 +54,20 @@ typedef enum EnforthToken
 {
 #include "enforth_tokens.h"
 
-    /* Tokens 0x70-0x7f are reserved for jump labels to the "CFA"
+    /* Tokens 0x78-0x7f are reserved for jump labels to the "CFA"
      * primitives.  The token names themselves do not need to be defined
      * because they are never referenced (we're just reserving space in
      * the token list and Address Interpreter jump table, in other
      * words), but we do list them here in order to make it easier to
      * turn raw tokens into enum values in the debugger. */
-    DOCOLON = 0x70,
+    DOCOLON = 0x78,
     DOCOLONROM,
     DOCONSTANT,
     DOCREATE,
     DOVARIABLE,
+    DOFFI,
+    DOROMFFI,
     /* Unused */
-    /* Unused */
-    /* Unused */
-
-    DOFFI0 = 0x78,
-    DOFFI1,
-    DOFFI2,
-    DOFFI3,
-    DOFFI4,
-    DOFFI5,
-    DOFFI6,
-    DOFFI7,
 } EnforthToken;
 
 
@@ -84,22 +81,83 @@ typedef enum EnforthToken
 #define kNFAtoCFA (1 /* PSF+namelen */ + 2 /* LFA */)
 #define kNFAtoPFA (1 /* PSF+namelen */ + 2 /* LFA */ + 2 /* CFA */)
 
+/* Double-cell numbers are stored on the stack with the most significant
+ * cell on top; this is the distance to shift that cell. */
+#define kEnforthCellBits (sizeof(EnforthUnsigned) * 8)
+
 #define kTaskUserVariableSize 8
+
+/* Task user variables holding the task's scheduling state and what the
+ * task is waiting for in that state: the handle of an asynchronous FFI
+ * call (pending), the tick count (see EnforthVM.ticks) at which the
+ * task will wake up (sleeping), the mask of the host event (see
+ * enforth_signal) that it is blocked on (blocked), the dictionary
+ * offset of the mailbox that it is parked on (parked), or the address
+ * of the host channel that it is awaiting (awaiting). */
+#define kTaskUserState 3
+#define kTaskUserWaitFor 4
+
+#define kTaskStateRunnable 0
+#define kTaskStatePending 1
+#define kTaskStateSleeping 2
+#define kTaskStateBlocked 3
+#define kTaskStateParked 4
+#define kTaskStateAwaiting 5
+
+/* Task user variable that is non-zero while a thread is running the
+ * task or looking at its state (see claim_task). */
+#define kTaskUserClaim 5
+
+/* Task user variable holding the change count of the mailbox that the
+ * task last failed to send to or receive from. */
+#define kTaskUserMailboxChanges 6
+
+/* Task user variable holding the size (in cells) of the task's return
+ * stack in its high byte and of its data stack in its low byte.  The
+ * return stack follows the user variables and is followed by the data
+ * stack; both stacks grow downward. */
+#define kTaskUserStackSizes 7
+
+/* Mailboxes (see MAILBOX) are a header followed by a ring buffer of
+ * capacity cells.  Changes counts the messages that have been sent to
+ * or received from the mailbox; tasks that are parked on the mailbox
+ * wait for it to change. */
+#define kMailboxCapacity 0
+#define kMailboxCount 1
+#define kMailboxHead 2
+#define kMailboxChanges 3
+#define kMailboxHeaderSize 4
+
+/* Stack sizes used by TASK and by the operator task. */
 #define kTaskReturnStackSize 32
 #define kTaskDataStackSize 24
+#define kOperatorTaskSize (kEnforthCellSize * (kTaskUserVariableSize + kTaskReturnStackSize + kTaskDataStackSize))
 
-#define kTaskStartToReturnTop ((kEnforthCellSize * kTaskUserVariableSize) + (kEnforthCellSize * (kTaskReturnStackSize - 1)))
-#define kTaskStartToDataTop ((kEnforthCellSize * kTaskUserVariableSize) + (kEnforthCellSize * kTaskReturnStackSize) + (kEnforthCellSize * (kTaskDataStackSize - 1)))
+/* DP, LASTTASK, PREVTASK, SAVEDSP, and the IP and RSP saved on each
+ * task's stack are stored as offsets from the start of the dictionary
+ * so that the dictionary can be loaded at a different address.  Saved
+ * IPs that point into the ROM definitions are instead stored as offsets
+ * from the start of the definitions, with kSavedIPInROM set. */
+#define kSavedIPInROM ((EnforthUnsigned)1 << (kEnforthCellBits - 1))
 
+/* The dictionary begins with the image header, which is followed by the
+ * DP, LATEST, and LASTTASK cells and then the operator task. */
+#define DICT_CELLS(vm) ((EnforthCell*)((vm)->dictionary.ram + sizeof(EnforthImageHeader)))
+#define kDictionaryToOperatorTask (sizeof(EnforthImageHeader) + (kEnforthCellSize * 3))
 
+#define DICT_REL(vm, p) ((EnforthUnsigned)((uint8_t*)(p) - (vm)->dictionary.ram))
+#define DICT_ABS(vm, u) ((vm)->dictionary.ram + (u))
 
-/* -------------------------------------
- * Enforth globals.
- */
+/* Returns the VM that owns the dictionary: the VM itself, or the owner
+ * of a worker context. */
+#define OWNER_VM(vm) ((vm)->owner != NULL ? (vm)->owner : (vm))
 
-#if ENABLE_TRACING
-static int gTraceLevel = 0;
-#endif
+/* Returns the sizes of a task's stacks and the addresses of the top
+ * (highest) cells of those stacks. */
+#define TASK_RETURN_STACK_SIZE(task) (((EnforthCell*)(task))[kTaskUserStackSizes].u >> 8)
+#define TASK_DATA_STACK_SIZE(task) (((EnforthCell*)(task))[kTaskUserStackSizes].u & 0xFF)
+#define TASK_RETURN_TOP(task) ((EnforthCell*)(task) + kTaskUserVariableSize + TASK_RETURN_STACK_SIZE(task) - 1)
+#define TASK_DATA_TOP(task) (TASK_RETURN_TOP(task) + TASK_DATA_STACK_SIZE(task))
 
 
 
@@ -117,305 +175,1461 @@ static const int8_t definitions[] PROGMEM = {
 
 
 /* -------------------------------------
- * Public functions.
+ * Private functions.
  */
 
-void enforth_init(
-        EnforthVM * const vm,
-        uint8_t * const dictionary, int dictionary_size,
-        const EnforthFFIDef * const last_ffi,
-        int (*keyq)(void), char (*key)(void), void (*emit)(char),
-        int (*load)(uint8_t*, int), int (*save)(uint8_t*, int))
-{
-    vm->last_ffi = last_ffi;
-
-    vm->keyq = keyq;
-    vm->key = key;
-    vm->emit = emit;
-    vm->load = load;
-    vm->save = save;
-
-    vm->dictionary.ram = dictionary;
-    vm->dictionary_size.u = dictionary_size;
+/* The text interpreter treats all control characters as whitespace
+ * when parsing space-delimited words (Forth-2012 3.4.1.1); every other
+ * delimiter must match exactly.  The scanning functions below are the
+ * only place where that rule is implemented. */
+#define IS_WHITESPACE(c) ((c) <= ' ')
 
-    enforth_reset(vm);
+#ifdef __SSE2__
+/* Returns a 16-bit mask with a bit set for each of the 16 bytes at p
+ * that is whitespace. */
+static int whitespace_mask(const uint8_t * const p)
+{
+    __m128i bytes = _mm_loadu_si128((const __m128i *)p);
+    return _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(' ')), bytes));
 }
+#endif
 
-void enforth_reset(EnforthVM * const vm)
+/* Returns the address of the first character in [p, end) that is
+ * whitespace (if findWhitespace is non-zero) or that is not whitespace
+ * (if findWhitespace is zero), or end if there is no such character.
+ * Hosts scan sixteen characters at a time; everything else (the AVR,
+ * for example) falls back to a simple loop. */
+static uint8_t * scan_whitespace(uint8_t * p, uint8_t * const end, const int findWhitespace)
 {
-    /* Initialize the dictionary, which contains the DP, LATEST, and
-     * LASTTASK cells, and the default task.  The user-accessible
-     * portion of the dictionary starts after that block of data.  DP is
-     * reset to point after that block, LATEST points at ROMDEF_LAST,
-     * and LASTTASK points to the default task. */
-    /* TODO The DP and LASTTASK cells should be dictionary-relative so
-     * that the dictionary can be loaded into RAM at a different
-     * location across SAVE/LOADs. */
-    ((EnforthCell*)vm->dictionary.ram)[0].ram
-        = vm->dictionary.ram
-        + kEnforthCellSize /* DP */
-        + kEnforthCellSize /* LATEST */
-        + kEnforthCellSize /* LASTTASK */
-        + (kEnforthCellSize * 64); /* Task Control Block */
-
-    ((EnforthCell*)vm->dictionary.ram)[1].u
-        = ROMDEF_LAST;
-
-    vm->cur_task.ram
-        = vm->dictionary.ram
-        + (kEnforthCellSize * 3);
-    ((EnforthCell*)vm->dictionary.ram)[2].ram
-        = vm->cur_task.ram;
-
-    /* Reset the globals. */
-    vm->hld = NULL;
-    vm->state = 0;
-
-    /* Reset the task. */
-    /* TODO These should be dictionary-relative so that they can
-     * relocate with the dictionary. */
-    ((EnforthCell*)vm->cur_task.ram)[0].u = 0; /* User: PREVTASK */
-    ((EnforthCell*)vm->cur_task.ram)[1].u = 0; /* User: SAVEDSP */
-    ((EnforthCell*)vm->cur_task.ram)[2].u = 10; /* User: BASE */
-
-    /* TODO This entire block below isn't really necessary since people
-     * aren't allowed to call enforth_resume on their own.  Instead,
-     * they should always call enforth_evaluate or enforth_go.  But if
-     * they call enforth_evaluate then enforth_evaluate needs to have an
-     * IP and RSP to pop from the stack and so enforth_reset needs to
-     * prepare the stack.
-     *
-     * What we really need is some sort of vm->status enum that tells us
-     * if the VM is halted and can be resumed (and therefore has IP and
-     * RSP stack items) or has never been run and therefore
-     * enforth_evaluate doesn't need to clean anything up. */
+#ifdef __SSE2__
+    while (end - p >= 16)
+    {
+        int mask = whitespace_mask(p);
+        if (!findWhitespace)
+        {
+            mask ^= 0xffff;
+        }
 
-    /* Clear both stacks. */
-    EnforthCell * sp = (EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop - kEnforthCellSize);
-    EnforthCell * rsp = (EnforthCell*)(vm->cur_task.ram + kTaskStartToReturnTop - kEnforthCellSize);
+        if (mask != 0)
+        {
+            return p + __builtin_ctz(mask);
+        }
 
-    /* Set the IP to the beginning of COLD. */
-#ifdef __AVR__
-    uint8_t* ip = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_COLD&0x3FFF) + kNFAtoPFA));
-#else
-    uint8_t* ip = (uint8_t*)definitions + (ROMDEF_COLD&0x3FFF) + kNFAtoPFA;
+        p += 16;
+    }
 #endif
 
-    /* Push RSP and IP to the stack. */
-    (--sp)->ram = (uint8_t*)rsp;
-    (--sp)->ram = ip;
+    if (findWhitespace)
+    {
+        while ((p < end) && !IS_WHITESPACE(*p))
+        {
+            p++;
+        }
+    }
+    else
+    {
+        while ((p < end) && IS_WHITESPACE(*p))
+        {
+            p++;
+        }
+    }
 
-    /* Save the stack pointer. */
-    /* TODO This should be dictionary-relative so that it can relocate
-     * with the dictionary. */
-    ((EnforthCell*)vm->cur_task.ram)[1].ram = (uint8_t*)sp;
+    return p;
 }
 
-void enforth_evaluate(EnforthVM * const vm, const char * const text)
+/* Returns the address of the first character in [p, end) that is not
+ * the delimiter, or end if the range only contains delimiters. */
+static uint8_t * skip_delimiters(uint8_t * p, uint8_t * const end, const uint8_t delim)
 {
-    /* Clear the return stack. */
-    EnforthCell * rsp = (EnforthCell*)(vm->cur_task.ram + kTaskStartToReturnTop - kEnforthCellSize);
+    if (delim == ' ')
+    {
+        return scan_whitespace(p, end, 0);
+    }
 
-    /* Push the address of HALT onto the return stack so that we exit
-     * the interpreter after EVALUATE is done. */
-#ifdef __AVR__
-    (--rsp)->ram = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_HALT&0x3FFF) + kNFAtoPFA));
-#else
-    (--rsp)->ram = (uint8_t*)definitions + (ROMDEF_HALT&0x3FFF) + kNFAtoPFA;
-#endif
+    while ((p < end) && (*p == delim))
+    {
+        p++;
+    }
 
-    /* Set the IP to the beginning of EVALUATE. */
-#ifdef __AVR__
-    uint8_t* ip = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_EVALUATE&0x3FFF) + kNFAtoPFA));
-#else
-    uint8_t* ip = (uint8_t*)definitions + (ROMDEF_EVALUATE&0x3FFF) + kNFAtoPFA;
-#endif
+    return p;
+}
 
-    /* Restore the stack pointer. */
-    EnforthCell * sp = (EnforthCell*)((EnforthCell*)vm->cur_task.ram)[1].ram;
+/* Returns the address of the first delimiter in [p, end), or end if the
+ * range does not contain the delimiter.  memchr is vectorized by the C
+ * library on hosts and is a tight assembly loop in avr-libc. */
+static uint8_t * find_delimiter(uint8_t * p, uint8_t * const end, const uint8_t delim)
+{
+    if (delim == ' ')
+    {
+        return scan_whitespace(p, end, 1);
+    }
 
-    /* Pop the previous IP and RSP; we're about to replace them. */
-    ++sp; /* IP */
-    ++sp; /* RSP */
+    p = (uint8_t *)memchr(p, delim, end - p);
+    return p != NULL ? p : end;
+}
 
-    /* Push the text and text length onto the stack. */
-    (--sp)->ram = (uint8_t*)text;
-    (--sp)->u = strlen(text);
 
-    /* Push the new RSP and IP to the stack. */
-    (--sp)->ram = (uint8_t*)rsp;
-    (--sp)->ram = ip;
+/* Accumulates the digits in [p, end) into ud using the given base and
+ * returns the address of the first character that is not a valid digit
+ * in that base (or end if every character was converted). */
+static uint8_t * convert_digits(
+        EnforthDoubleUnsigned * const ud,
+        uint8_t * p, uint8_t * const end,
+        const EnforthUnsigned base)
+{
+    for (; p < end; p++)
+    {
+        EnforthUnsigned digit = *p;
+        if ((digit >= '0') && (digit <= '9'))
+        {
+            digit -= '0';
+        }
+        else if (((digit | 0x20) >= 'a') && ((digit | 0x20) <= 'z'))
+        {
+            digit = (digit | 0x20) - 'a' + 10;
+        }
+        else
+        {
+            break;
+        }
+
+        if (digit >= base)
+        {
+            break;
+        }
 
-    /* Update the saved the stack pointer now that we have modified the
-     * stack. */
-    /* TODO This should be dictionary-relative so that it can relocate
-     * with the dictionary. */
-    ((EnforthCell*)vm->cur_task.ram)[1].ram = (uint8_t*)sp;
+        *ud = (*ud * base) + digit;
+    }
 
-    /* Resume the interpreter. */
-    enforth_resume(vm);
+    return p;
 }
 
-void enforth_resume(EnforthVM * const vm)
+/* Consumes an optional leading sign and returns -1 if it was a minus
+ * sign, otherwise zero. */
+static int8_t parse_sign(uint8_t ** const p, uint8_t * const end)
 {
-    register uint8_t *ip;
-    register uint16_t xt;
-    register EnforthCell tos;
-    register EnforthCell *restDataStack; /* Points at the second item on the stack. */
-    register uint8_t *w;
-    register EnforthCell *returnTop;
+    if ((*p < end) && ((**p == '-') || (**p == '+')))
+    {
+        return *(*p)++ == '-' ? -1 : 0;
+    }
 
-#ifdef __AVR__
-    register int8_t inProgramSpace;
-#endif
+    return 0;
+}
 
-#if ENABLE_STACK_CHECKING
-    /* Check for available stack space and abort with a message if this
-     * operation would run out of space. */
-    /* TODO The overflow logic seems slightly too aggressive -- it
-     * probably needs a "- 1" in there given that we store TOS in a
-     * register. */
-#define CHECK_STACK(numArgs, numResults) \
-    { \
-        if (((EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop) - restDataStack) < numArgs) { \
-            goto STACK_UNDERFLOW; \
-        } else if ((((EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop) - restDataStack) - numArgs) + numResults > 32) { \
-            goto STACK_OVERFLOW; \
-        } \
+/* Closes the current input source (if it is an included file) and
+ * restores the enclosing input source specification. */
+static void pop_input_source(EnforthVM * const vm)
+{
+    if ((vm->source_id.i != 0) && (vm->source_id.i != -1)
+            && (vm->close_source != NULL))
+    {
+        vm->close_source(vm->source_id);
     }
-#else
-#define CHECK_STACK(numArgs, numResults)
-#endif
 
-    static const void * const primitive_table[128] PROGMEM = {
-#include "enforth_jumptable.h"
+    const EnforthInputSource * const saved
+        = &vm->saved_sources[--vm->source_depth];
+    vm->source_id = saved->source_id;
+    vm->source_len = saved->source_len;
+    vm->source = saved->source;
+    vm->to_in = saved->to_in;
+}
 
-        /* $70 - $77 */
-        &&DOCOLON,
-        &&DOCOLONROM,
-        &&DOCONSTANT,
-        &&DOCREATE,
 
-        &&DOVARIABLE,
-        0, /* Unused */
-        0, /* Unused */
-        0, /* Unused */
+/* Adds an FFI's name (and its terminator, so that adjacent names cannot
+ * run together) to an FNV-1a hash. */
+static uint32_t hash_ffi_name(uint32_t hash, const EnforthFFIDef * const ffidef)
+{
+    const char * name = (const char *)pgm_read_word(&ffidef->name);
+    char c;
 
-        /* $78 - $7F */
-        &&DOFFI0,
-        &&DOFFI1,
-        &&DOFFI2,
-        &&DOFFI3,
-
-        &&DOFFI4,
-        &&DOFFI5,
-        &&DOFFI6,
-        &&DOFFI7,
-    };
+    do
+    {
+        c = pgm_read_byte(name++);
+        hash = (hash ^ (uint8_t)c) * 16777619UL;
+    } while (c != '\0');
 
-UNPAUSE:
+    return hash;
+}
 
-    /* Restore the stack pointer. */
-    restDataStack = (EnforthCell*)((EnforthCell*)vm->cur_task.ram)[1].ram;
+/* Returns the FNV-1a hash of the ROM definitions and of the names of
+ * the host's FFIs and ROM FFI words, which identifies the tokens, ROM
+ * XTs, FFI indices (see link_ffi_words), and ROM FFI indices that an
+ * image was compiled against. */
+static uint32_t image_build_hash(const EnforthVM * const vm)
+{
+    uint32_t hash = 2166136261UL;
+    const EnforthFFIDef * ffidef;
+    const int8_t * p;
 
-    /* Pop IP and RSP from the stack. */
-    ip = (restDataStack++)->ram;
-#ifdef __AVR__
-    if (((unsigned int)ip & 0x8000) != 0)
+    for (p = definitions; p < definitions + sizeof(definitions); p++)
     {
-        /* This IP address points at a ROM definition; strip off that
-         * flag as part of popping the address. */
-        ip = (uint8_t*)((unsigned int)ip & 0x7FFF);
-        inProgramSpace = -1;
+        hash = (hash ^ (uint8_t)pgm_read_byte(p)) * 16777619UL;
     }
-    else
+
+    for (ffidef = vm->last_ffi;
+            ffidef != NULL;
+            ffidef = (const EnforthFFIDef *)pgm_read_word(&ffidef->prev))
     {
-        inProgramSpace = 0;
+        hash = hash_ffi_name(hash, ffidef);
     }
-#endif
-
-    returnTop = (EnforthCell *)(restDataStack++)->ram;
 
-    /* Pop TOS into our register. */
-    tos = *restDataStack++;
-
-    /* The inner interpreter. */
-    for (;;)
+    if (vm->rom_ffis != NULL)
     {
-        /* Get the next instruction, which could be one or two bytes
-         * depending on if this is a Code Primitive (one byte) or a
-         * Definition (two bytes).  The W ("Word") pointer needs to be
-         * set if this is a Definition. */
-        uint8_t token;
+        const EnforthFFIDef * const * entry;
 
-#ifdef __AVR__
-        if (inProgramSpace)
+        for (entry = vm->rom_ffis;
+                (ffidef = (const EnforthFFIDef *)pgm_read_word(entry)) != NULL;
+                entry++)
         {
-            token = pgm_read_byte(ip++);
-        }
-        else
-#endif
-        {
-            token = *ip++;
+            hash = hash_ffi_name(hash, ffidef);
         }
+    }
 
-        /* Is this actually a token (< 128)?  If so, dispatch the
-         * token. */
-        if (token < 128)
-        {
-            w = NULL;
-            goto DISPATCH_TOKEN;
-        }
-        else
+    return hash;
+}
+
+/* Returns the index of the ROM FFI word with the given name (ignoring
+ * case), or -1 if there is no such word. */
+static int find_rom_ffi(
+        const EnforthVM * const vm, const uint8_t * const name, int len)
+{
+    const EnforthFFIDef * ffidef;
+    int index;
+
+    if (vm->rom_ffis == NULL)
+    {
+        return -1;
+    }
+
+    for (index = 0;
+            (index < 255)
+                && ((ffidef = (const EnforthFFIDef *)pgm_read_word(&vm->rom_ffis[index])) != NULL);
+            index++)
+    {
+        const char * ffiname = (const char *)pgm_read_word(&ffidef->name);
+        int i;
+
+        for (i = 0; i < len; i++)
         {
-            /* Not a token, which means that this is a two-byte XT that
-             * points at the NFA of the word to be called. */
-            xt = token << 8;
+            char c1 = name[i];
+            char c2 = pgm_read_byte(ffiname + i);
 
-#ifdef __AVR__
-            if (inProgramSpace)
+            if ((c1 >= 'a') && (c1 <= 'z'))
             {
-                xt |= pgm_read_byte(ip++);
+                c1 -= 'a' - 'A';
             }
-            else
-#endif
+
+            if ((c2 >= 'a') && (c2 <= 'z'))
             {
-                xt |= *ip++;
+                c2 -= 'a' - 'A';
             }
 
-DISPATCH_XT:
-            /* This is a two-byte XT that points at another word.  We
-             * need to find the word that is being targeted by this XT
-             * and set W to that word's PFA.  We then need to dispatch
-             * to the word's Code Field.  The Code Field will almost
-             * always contain a DO* token, *unless the word was modified
-             * by a defining word.*  In that case, the Code Field will
-             * contain a full, two-byte XT and that XT will point to the
-             * runtime behavior of the defining word (the code after
-             * DOES> in the defining word).
-             *
-             * Note that ROM Definitions never use DOES> and so we can
-             * assume that the Code Field in a ROM Definition will
-             * always contain a token. */
-            if ((xt & 0xC000) == 0xC000) /* ROM Definition: 0xCxxx */
+            if (c1 != c2)
             {
-                /* Advance past the empty first byte in the Code Field,
-                 * then read the token in the second byte. */
-                /* TODO We could probably eliminate the first byte in
-                 * ROM Definitions. */
-                w = (uint8_t*)((uint8_t*)definitions + (xt & 0x3FFF) + kNFAtoCFA + 1);
-#ifdef __AVR__
-                token = pgm_read_byte(w++);
-#else
-                token = *w++;
-#endif
+                break;
             }
-            else /* User Definition: 0x8xxx */
-            {
-                /* Load the Code Field. */
-                w = (uint8_t*)(vm->dictionary.ram + (xt & 0x3FFF) + kNFAtoCFA);
-                xt = *w++ << 8;
-                xt |= *w++;
+        }
+
+        if ((i == len) && (pgm_read_byte(ffiname + len) == '\0'))
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+static int image_is_valid(
+        const EnforthVM * const vm,
+        const uint8_t * const image, const EnforthUnsigned dictionary_size)
+{
+    const EnforthImageHeader * const header = (const EnforthImageHeader *)image;
+
+    return (header->magic == kEnforthImageMagic)
+        && (header->version == kEnforthImageVersion)
+        && (header->cell_size == kEnforthCellSize)
+        && (header->extent >= kDictionaryToOperatorTask + kOperatorTaskSize)
+        && (header->extent <= dictionary_size)
+        && (header->build_hash == image_build_hash(vm));
+}
+
+/* Fills in the image header at the start of the dictionary, which
+ * makes the used portion of the dictionary a loadable image. */
+static EnforthImageHeader * fill_image_header(EnforthVM * const vm)
+{
+    EnforthImageHeader * const header = (EnforthImageHeader *)vm->dictionary.ram;
+    header->magic = kEnforthImageMagic;
+    header->build_hash = image_build_hash(vm);
+    header->extent = DICT_CELLS(vm)[0].u;
+    header->version = kEnforthImageVersion;
+    header->cell_size = kEnforthCellSize;
+    return header;
+}
+
+/* Hands any buffered output to the host. */
+static void flush_output(EnforthVM * const vm)
+{
+    if (vm->output_len > 0)
+    {
+        vm->type(vm->output_buffer, vm->output_len);
+        vm->output_len = 0;
+    }
+}
+
+/* Outputs a single character, buffering it if the host has a type
+ * callback.  Newlines flush the buffer so that complete lines are always
+ * visible. */
+static void emit_char(EnforthVM * const vm, const char ch)
+{
+    if (vm->type == NULL)
+    {
+        if (vm->emit != NULL)
+        {
+            vm->emit(ch);
+        }
+
+        return;
+    }
+
+    vm->output_buffer[vm->output_len++] = ch;
+    if ((ch == '\n') || (vm->output_len == ENFORTH_OUTPUT_BUFFER_SIZE))
+    {
+        flush_output(vm);
+    }
+}
+
+/* Outputs a string, which is buffered if it fits in the output buffer
+ * and otherwise passed directly to the type callback. */
+static void type_chars(EnforthVM * const vm, const char * text, EnforthUnsigned len)
+{
+    if (vm->type == NULL)
+    {
+        while (len-- > 0)
+        {
+            emit_char(vm, *text++);
+        }
+
+        return;
+    }
+
+    if (vm->output_len + len > ENFORTH_OUTPUT_BUFFER_SIZE)
+    {
+        flush_output(vm);
+    }
+
+    if (len >= ENFORTH_OUTPUT_BUFFER_SIZE)
+    {
+        vm->type(text, len);
+        return;
+    }
+
+    memcpy(vm->output_buffer + vm->output_len, text, len);
+    vm->output_len += len;
+}
+
+/* Returns the end of the pictured numeric output buffer: the space past
+ * HERE for the operator task, and the VM's own buffer for workers, whose
+ * tasks would otherwise build their numbers on top of each other's. */
+static uint8_t * hold_end(EnforthVM * const vm)
+{
+#ifndef __AVR__
+    if (vm->owner != NULL)
+    {
+        return vm->hold + ENFORTH_HOLD_SIZE;
+    }
+#endif
+
+    return vm->dictionary.ram + DICT_CELLS(vm)[0].u + ENFORTH_HOLD_SIZE;
+}
+
+/* Marks the dictionary pages that contain [addr, addr+len) as dirty so
+ * that the next SAVE writes them out.  Addresses outside of the
+ * dictionary are ignored.  Worker contexts mark their owner's pages,
+ * so on hosts the map is updated atomically. */
+static void mark_dirty(
+        EnforthVM * const vm, const uint8_t * addr, EnforthUnsigned len)
+{
+    uint8_t * const dirty_pages = OWNER_VM(vm)->dirty_pages;
+    const uint8_t * const dict_end = vm->dictionary.ram + vm->dictionary_size.u;
+    const uint8_t * end = addr + len;
+    EnforthUnsigned page, last_page;
+
+    if (addr < vm->dictionary.ram)
+    {
+        addr = vm->dictionary.ram;
+    }
+
+    if (end > dict_end)
+    {
+        end = dict_end;
+    }
+
+    if (addr >= end)
+    {
+        return;
+    }
+
+    last_page = (EnforthUnsigned)(end - 1 - vm->dictionary.ram) >> vm->page_shift;
+    for (page = (EnforthUnsigned)(addr - vm->dictionary.ram) >> vm->page_shift;
+            page <= last_page;
+            page++)
+    {
+#ifdef __AVR__
+        dirty_pages[page >> 3] |= 1 << (page & 7);
+#else
+        if ((__atomic_load_n(&dirty_pages[page >> 3], __ATOMIC_RELAXED) & (1 << (page & 7))) == 0)
+        {
+            __atomic_fetch_or(&dirty_pages[page >> 3], 1 << (page & 7), __ATOMIC_RELAXED);
+        }
+#endif
+    }
+}
+
+/* Marks the control blocks and stacks of every task as dirty.  The
+ * inner interpreter saves a task's registers and pushes to its stacks
+ * without marking the pages that it writes, so SAVE marks all of them
+ * instead. */
+static void mark_tasks_dirty(EnforthVM * const vm)
+{
+    EnforthCell * task = (EnforthCell*)DICT_ABS(vm, DICT_CELLS(vm)[2].u);
+
+    for (;;)
+    {
+        mark_dirty(
+                vm,
+                (uint8_t*)task,
+                kEnforthCellSize
+                    * (kTaskUserVariableSize
+                        + TASK_RETURN_STACK_SIZE(task)
+                        + TASK_DATA_STACK_SIZE(task)));
+
+        if (task[0].u == 0)
+        {
+            break;
+        }
+
+        task = (EnforthCell*)DICT_ABS(vm, task[0].u);
+    }
+}
+
+/* FFI words (see USE:) hold the address of their FFI definition, which
+ * is only meaningful to the build (and the process) that compiled them,
+ * followed by the index of that definition in the host's FFI list.
+ * Before an image is saved, record the indices (and mark the ones that
+ * changed as dirty); after an image has been loaded, look the
+ * definitions up again by index.  The build hash covers the names of
+ * the host's FFIs, so an index refers to the same FFI in both builds. */
+static void link_ffi_words(EnforthVM * const vm, const int8_t record)
+{
+    EnforthXT xt = DICT_CELLS(vm)[1].u;
+
+    /* User definitions have XTs of the form 0x8xxx; the chain ends in
+     * the ROM definitions, which do not contain any FFI words. */
+    while ((xt & 0xC000) == 0x8000)
+    {
+        uint8_t * const nfa = DICT_ABS(vm, xt & 0x3FFF);
+
+        if ((*nfa & 0x20) != 0)
+        {
+            EnforthCell * const body = (EnforthCell*)(nfa + kNFAtoPFA);
+            const EnforthFFIDef * ffidef = vm->last_ffi;
+            EnforthUnsigned index = 0;
+
+            if (record)
+            {
+                while ((ffidef != NULL) && ((uint8_t*)ffidef != body[0].ram))
+                {
+                    ffidef = (const EnforthFFIDef *)pgm_read_word(&ffidef->prev);
+                    index++;
+                }
+
+                if (body[1].u != index)
+                {
+                    body[1].u = index;
+                    mark_dirty(vm, (uint8_t*)&body[1], kEnforthCellSize);
+                }
+            }
+            else
+            {
+                for (index = body[1].u; (ffidef != NULL) && (index > 0); index--)
+                {
+                    ffidef = (const EnforthFFIDef *)pgm_read_word(&ffidef->prev);
+                }
+
+                /* Only write to the body if the address moved, so that
+                 * mapped images keep sharing the page. */
+                if (body[0].ram != (uint8_t*)ffidef)
+                {
+                    body[0].ram = (uint8_t*)ffidef;
+                }
+            }
+        }
+
+        xt = (nfa[1] << 8) | nfa[2];
+    }
+}
+
+/* Picks the smallest page size that allows the dirty page map to cover
+ * the dictionary and then marks every page as either clean (the
+ * dictionary matches the saved image of the given extent) or dirty
+ * (nothing has been saved yet). */
+static void reset_dirty_pages(
+        EnforthVM * const vm, const int dirty, const EnforthUnsigned saved_extent)
+{
+    vm->page_shift = 4;
+    while ((vm->dictionary_size.u >> vm->page_shift) >= (ENFORTH_DIRTY_MAP_SIZE * 8))
+    {
+        vm->page_shift++;
+    }
+
+    memset(vm->dirty_pages, dirty ? 0xff : 0x00, ENFORTH_DIRTY_MAP_SIZE);
+    vm->saved_extent = saved_extent;
+}
+
+/* Passes each run of dirty pages below the image's extent to the
+ * save_range callback.  Returns zero if any of the ranges could not be
+ * saved. */
+static int save_dirty_pages(EnforthVM * const vm, const EnforthUnsigned extent)
+{
+    EnforthUnsigned page = 0;
+
+    while ((page << vm->page_shift) < extent)
+    {
+        EnforthUnsigned offset, end;
+
+        /* Skip clean pages. */
+        if ((vm->dirty_pages[page >> 3] & (1 << (page & 7))) == 0)
+        {
+            page++;
+            continue;
+        }
+
+        /* Collect the run of dirty pages. */
+        offset = page << vm->page_shift;
+        do
+        {
+            page++;
+        } while (((page << vm->page_shift) < extent)
+                && ((vm->dirty_pages[page >> 3] & (1 << (page & 7))) != 0));
+
+        end = page << vm->page_shift;
+        if (end > extent)
+        {
+            end = extent;
+        }
+
+        if (!vm->save_range(vm->dictionary.ram, offset, end - offset, extent))
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/* Reads a cell that another thread (a worker context, or the host) may
+ * be storing to.  Loads acquire, and stores release, the memory that
+ * the other thread wrote before storing to the cell.  The AVR only
+ * needs to keep interrupt handlers from seeing half of a cell. */
+static EnforthUnsigned load_cell(EnforthCell * const cell)
+{
+#ifdef __AVR__
+    EnforthUnsigned u;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        u = cell->u;
+    }
+
+    return u;
+#else
+    return __atomic_load_n(&cell->u, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/* Stores to a cell that another thread may be reading (see
+ * load_cell). */
+static void store_cell(EnforthCell * const cell, const EnforthUnsigned u)
+{
+#ifdef __AVR__
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        cell->u = u;
+    }
+#else
+    __atomic_store_n(&cell->u, u, __ATOMIC_RELEASE);
+#endif
+}
+
+/* Stores desired in the cell and returns non-zero if the cell holds
+ * expected, otherwise returns zero and leaves the cell unchanged. */
+static int8_t compare_and_swap_cell(
+        EnforthCell * const cell,
+        EnforthUnsigned expected, const EnforthUnsigned desired)
+{
+#ifdef __AVR__
+    int8_t swapped = 0;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (cell->u == expected)
+        {
+            cell->u = desired;
+            swapped = -1;
+        }
+    }
+
+    return swapped;
+#else
+    return __atomic_compare_exchange_n(
+            &cell->u, &expected, desired,
+            0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ? -1 : 0;
+#endif
+}
+
+/* A thread claims a task before it looks at the task's state (and then
+ * runs the task if it is runnable), and releases the task once the
+ * task's registers have been saved.  Claims are what keep the VM and
+ * its worker contexts from running the same task at the same time;
+ * they also let enforth_complete, which can be called from any thread,
+ * update a waiting task.  Returns zero if another thread has already
+ * claimed the task. */
+static int8_t claim_task(EnforthCell * const task)
+{
+    return compare_and_swap_cell(&task[kTaskUserClaim], 0, 1);
+}
+
+static void release_task(EnforthCell * const task)
+{
+    store_cell(&task[kTaskUserClaim], 0);
+}
+
+/* Guards the contents of every mailbox in the dictionary.  Mailbox
+ * operations are short, so threads just spin; the AVR only ever runs
+ * one task at a time and does not need the lock. */
+static void lock_mailboxes(EnforthVM * const vm)
+{
+#ifndef __AVR__
+    uint8_t * const lock = &OWNER_VM(vm)->mailbox_lock;
+
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0)
+    {
+        while (__atomic_load_n(lock, __ATOMIC_RELAXED) != 0)
+        {
+        }
+    }
+#endif
+}
+
+static void unlock_mailboxes(EnforthVM * const vm)
+{
+#ifndef __AVR__
+    __atomic_store_n(&OWNER_VM(vm)->mailbox_lock, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+/* Clears the stacks of the current task and arranges for the task to
+ * start at COLD when it is resumed. */
+static void prepare_cold_start(EnforthVM * const vm)
+{
+    /* Clear both stacks. */
+    EnforthCell * sp = TASK_DATA_TOP(vm->cur_task.ram) - 1;
+    EnforthCell * rsp = TASK_RETURN_TOP(vm->cur_task.ram) - 1;
+
+    /* Push RSP and IP (the beginning of COLD) to the stack. */
+    (--sp)->u = DICT_REL(vm, rsp);
+    (--sp)->u = kSavedIPInROM | ((ROMDEF_COLD&0x3FFF) + kNFAtoPFA);
+
+    /* Save the stack pointer. */
+    ((EnforthCell*)vm->cur_task.ram)[1].u = DICT_REL(vm, sp);
+
+    /* The task is no longer waiting for anything. */
+    store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateRunnable);
+}
+
+/* Makes the previous task in the task list the current task, wrapping
+ * around to the last task after the first task.  SIZED-TASK publishes
+ * new tasks by storing to LASTTASK once the task is complete, so the
+ * task list can be walked while tasks are being created. */
+static void select_previous_task(EnforthVM * const vm)
+{
+    if (((EnforthCell*)vm->cur_task.ram)[0].u != 0)
+    {
+        vm->cur_task.ram = DICT_ABS(vm, ((EnforthCell*)vm->cur_task.ram)[0].u);
+    }
+    else
+    {
+        vm->cur_task.ram = DICT_ABS(vm, load_cell(&DICT_CELLS(vm)[2]));
+    }
+}
+
+/* Returns the current tick count, or zero if the host does not provide
+ * a tick source. */
+static EnforthUnsigned current_ticks(EnforthVM * const vm)
+{
+    return vm->ticks != NULL ? vm->ticks() : 0;
+}
+
+/* Clears the signaled events in mask and returns non-zero if any of
+ * them had been signaled.  enforth_signal can be called from another
+ * thread or an interrupt handler, so the events are taken atomically.
+ * Worker contexts take their owner's events. */
+static int8_t take_signals(EnforthVM * vm, const EnforthUnsigned mask)
+{
+    EnforthUnsigned taken;
+
+    vm = OWNER_VM(vm);
+
+#ifdef __AVR__
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        taken = vm->signals & mask;
+        vm->signals &= ~taken;
+    }
+#else
+    taken = __atomic_fetch_and(&vm->signals, ~mask, __ATOMIC_ACQ_REL) & mask;
+#endif
+
+    return taken != 0;
+}
+
+/* Returns the number of ticks until the current task, which must be
+ * claimed, can run: zero if the task is runnable and the maximum
+ * unsigned value if the task is waiting for an asynchronous FFI,
+ * blocked on a host event, parked on a mailbox, or awaiting a channel.
+ * Sleeping tasks whose wake time has arrived, blocked tasks whose event
+ * has been signaled, parked tasks whose mailbox has changed, and
+ * awaiting tasks whose channel is no longer empty are made runnable.
+ * Wake times are compared with a signed difference so that the tick
+ * count is allowed to wrap around. */
+static EnforthUnsigned ticks_until_runnable(EnforthVM * const vm)
+{
+    EnforthCell * const task = (EnforthCell*)vm->cur_task.ram;
+
+    switch (task[kTaskUserState].u)
+    {
+        case kTaskStateRunnable:
+            return 0;
+
+        case kTaskStateSleeping:
+        {
+            const EnforthInt remaining = (EnforthInt)(task[kTaskUserWaitFor].u - current_ticks(vm));
+            if (remaining > 0)
+            {
+                return (EnforthUnsigned)remaining;
+            }
+        }
+        break;
+
+        case kTaskStateBlocked:
+            if (!take_signals(vm, task[kTaskUserWaitFor].u))
+            {
+                return ~(EnforthUnsigned)0;
+            }
+            break;
+
+        /* Parked tasks poll their mailbox instead of being woken by the
+         * task that changes it, since that task may be running on
+         * another thread.  The mailbox changed since the task failed to
+         * use it if its change count is different. */
+        case kTaskStateParked:
+            if (load_cell(&((EnforthCell*)DICT_ABS(vm, task[kTaskUserWaitFor].u))[kMailboxChanges])
+                    == task[kTaskUserMailboxChanges].u)
+            {
+                return ~(EnforthUnsigned)0;
+            }
+            break;
+
+        /* Channels are polled for the same reason, and are only ever
+         * received from by the waiting task. */
+        case kTaskStateAwaiting:
+        {
+            EnforthChannel * const channel = (EnforthChannel*)task[kTaskUserWaitFor].ram;
+            if (load_cell(&channel->tail) == channel->head.u)
+            {
+                return ~(EnforthUnsigned)0;
+            }
+        }
+        break;
+
+        default:
+            return ~(EnforthUnsigned)0;
+    }
+
+    store_cell(&task[kTaskUserState], kTaskStateRunnable);
+    return 0;
+}
+
+/* Prepares the VM to run the image that is now in the dictionary: the
+ * text interpreter is reset and the operator task will start at COLD
+ * (and thus at the image's turnkey word). */
+static void start_image(EnforthVM * const vm)
+{
+    while (vm->source_depth > 0)
+    {
+        pop_input_source(vm);
+    }
+
+    vm->source_id.i = 0;
+    vm->hld = NULL;
+    vm->state = 0;
+
+    link_ffi_words(vm, 0);
+
+    /* The tasks that were running when the image was saved (the task
+     * that called SAVE, at least) are still claimed in the image. */
+    {
+        EnforthCell * task = (EnforthCell*)DICT_ABS(vm, DICT_CELLS(vm)[2].u);
+
+        for (;;)
+        {
+            release_task(task);
+
+            if (task[0].u == 0)
+            {
+                break;
+            }
+
+            task = (EnforthCell*)DICT_ABS(vm, task[0].u);
+        }
+    }
+
+    vm->cur_task.ram = vm->dictionary.ram + kDictionaryToOperatorTask;
+    prepare_cold_start(vm);
+}
+
+#if ENABLE_FFI_STATS
+/* Adds one call, which took elapsed ffi_clock ticks, to an FFI's
+ * statistics. */
+static void record_ffi_call(
+        const EnforthFFIDef * const ffidef, uint32_t elapsed)
+{
+    EnforthFFIStats * const stats = (EnforthFFIStats *)pgm_read_word(&ffidef->stats);
+    uint32_t bits = elapsed;
+    uint8_t bucket = 0;
+
+    while ((bits != 0) && (bucket < ENFORTH_FFI_STATS_BUCKETS - 1))
+    {
+        bucket++;
+        bits >>= 1;
+    }
+
+    /* FFI definitions are shared by every VM, and VMs can run on
+     * different threads, so hosts update the statistics atomically. */
+#ifdef __AVR__
+    stats->calls++;
+    stats->total_time += elapsed;
+
+    if (stats->histogram[bucket] != 0xFFFF)
+    {
+        stats->histogram[bucket]++;
+    }
+#else
+    __atomic_fetch_add(&stats->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->total_time, elapsed, __ATOMIC_RELAXED);
+
+    {
+        uint16_t count = __atomic_load_n(&stats->histogram[bucket], __ATOMIC_RELAXED);
+        while ((count != 0xFFFF)
+            && !__atomic_compare_exchange_n(&stats->histogram[bucket], &count, count + 1,
+                    0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            /* count now holds the current value; try again. */
+        }
+    }
+#endif
+}
+
+/* Clears an FFI's statistics. */
+static void clear_ffi_stats(const EnforthFFIDef * const ffidef)
+{
+    memset((EnforthFFIStats *)pgm_read_word(&ffidef->stats), 0, sizeof(EnforthFFIStats));
+}
+
+/* Outputs u in the current BASE. */
+static void type_unsigned(EnforthVM * const vm, uint32_t u)
+{
+    const EnforthUnsigned base = ((EnforthCell*)vm->cur_task.ram)[2].u; /* User: BASE */
+    char digits[32];
+    char * p = digits + sizeof(digits);
+
+    do
+    {
+        uint8_t digit = u % base;
+        u /= base;
+        *--p = digit > 9 ? digit - 10 + 'A' : digit + '0';
+    } while (u != 0);
+
+    type_chars(vm, p, digits + sizeof(digits) - p);
+}
+
+/* Outputs one line of .FFI-STATS: the FFI's name, call count, and
+ * total time, and then bucket:count for each non-empty histogram
+ * bucket.  FFIs that have not been called are skipped. */
+static void type_ffi_stats(
+        EnforthVM * const vm, const EnforthFFIDef * const ffidef)
+{
+    const EnforthFFIStats * const stats = (const EnforthFFIStats *)pgm_read_word(&ffidef->stats);
+    const char * name = (const char *)pgm_read_word(&ffidef->name);
+    char c;
+    int bucket;
+
+    if (stats->calls == 0)
+    {
+        return;
+    }
+
+    while ((c = pgm_read_byte(name++)) != '\0')
+    {
+        emit_char(vm, c);
+    }
+
+    emit_char(vm, ' ');
+    type_unsigned(vm, stats->calls);
+    emit_char(vm, ' ');
+    type_unsigned(vm, stats->total_time);
+
+    for (bucket = 0; bucket < ENFORTH_FFI_STATS_BUCKETS; bucket++)
+    {
+        if (stats->histogram[bucket] != 0)
+        {
+            emit_char(vm, ' ');
+            type_unsigned(vm, bucket);
+            emit_char(vm, ':');
+            type_unsigned(vm, stats->histogram[bucket]);
+        }
+    }
+
+    emit_char(vm, '\n');
+}
+
+/* Clears or displays one FFI's statistics for visit_ffis. */
+static void visit_ffi(
+        EnforthVM * const vm, const EnforthFFIDef * const ffidef, const int8_t clear)
+{
+    if (clear)
+    {
+        clear_ffi_stats(ffidef);
+    }
+    else
+    {
+        type_ffi_stats(vm, ffidef);
+    }
+}
+
+/* Clears (if clear is non-zero) or displays the statistics of every FFI
+ * known to the VM: the USE:-able FFIs and then the ROM FFI words that
+ * are not also USE:-able. */
+static void visit_ffis(EnforthVM * const vm, const int8_t clear)
+{
+    const EnforthFFIDef * ffidef;
+
+    for (ffidef = vm->last_ffi;
+            ffidef != NULL;
+            ffidef = (const EnforthFFIDef *)pgm_read_word(&ffidef->prev))
+    {
+        visit_ffi(vm, ffidef, clear);
+    }
+
+    if (vm->rom_ffis != NULL)
+    {
+        const EnforthFFIDef * const * entry;
+
+        for (entry = vm->rom_ffis;
+                (ffidef = (const EnforthFFIDef *)pgm_read_word(entry)) != NULL;
+                entry++)
+        {
+            const EnforthFFIDef * chained;
+
+            for (chained = vm->last_ffi;
+                    (chained != NULL) && (chained != ffidef);
+                    chained = (const EnforthFFIDef *)pgm_read_word(&chained->prev))
+            {
+            }
+
+            if (chained == NULL)
+            {
+                visit_ffi(vm, ffidef, clear);
+            }
+        }
+    }
+}
+#endif
+
+
+
+/* -------------------------------------
+ * Public functions.
+ */
+
+void enforth_init(
+        EnforthVM * const vm,
+        uint8_t * const dictionary, int dictionary_size,
+        const EnforthFFIDef * const last_ffi,
+        int (*keyq)(void), char (*key)(void), void (*emit)(char),
+        int (*load)(uint8_t*, int), int (*save)(uint8_t*, int))
+{
+    vm->last_ffi = last_ffi;
+    vm->rom_ffis = NULL;
+
+    vm->keyq = keyq;
+    vm->key = key;
+    vm->emit = emit;
+    vm->load = load;
+    vm->save = save;
+
+    vm->open_source = NULL;
+    vm->read_line = NULL;
+    vm->close_source = NULL;
+    vm->save_range = NULL;
+    vm->type = NULL;
+    vm->accept = NULL;
+    vm->ticks = NULL;
+    vm->idle = NULL;
+    vm->signals = 0;
+    vm->wait_ticks = 0;
+    vm->key_event = -1;
+    vm->time_slice = 0;
+#if ENABLE_TRACING
+    vm->trace_level = 0;
+#endif
+#if ENABLE_FFI_STATS
+    vm->ffi_clock = NULL;
+#endif
+    vm->output_len = 0;
+
+    vm->dictionary.ram = dictionary;
+    vm->dictionary_size.u = dictionary_size;
+
+    enforth_reset(vm);
+}
+
+void enforth_reset(EnforthVM * const vm)
+{
+    /* Initialize the dictionary, which contains the image header, the
+     * DP, LATEST, and LASTTASK cells, and the default task.  The
+     * user-accessible portion of the dictionary starts after that block
+     * of data.  DP is reset to point after that block, LATEST points at
+     * ROMDEF_LAST, and LASTTASK points to the default task.  The rest
+     * of the image header is filled in by SAVE. */
+    memset(vm->dictionary.ram, 0, sizeof(EnforthImageHeader));
+
+    DICT_CELLS(vm)[0].u
+        = kDictionaryToOperatorTask
+        + kOperatorTaskSize; /* Task Control Block */
+
+    DICT_CELLS(vm)[1].u
+        = ROMDEF_LAST;
+
+    vm->cur_task.ram
+        = vm->dictionary.ram
+        + kDictionaryToOperatorTask;
+    DICT_CELLS(vm)[2].u
+        = DICT_REL(vm, vm->cur_task.ram);
+
+    /* Nothing in the new dictionary has been saved. */
+    reset_dirty_pages(vm, -1, 0);
+
+    /* Reset the globals. */
+    vm->hld = NULL;
+    vm->state = 0;
+    vm->source_id.i = 0;
+    vm->source_depth = 0;
+
+    /* Reset the task. */
+    ((EnforthCell*)vm->cur_task.ram)[0].u = 0; /* User: PREVTASK */
+    ((EnforthCell*)vm->cur_task.ram)[1].u = 0; /* User: SAVEDSP */
+    ((EnforthCell*)vm->cur_task.ram)[2].u = 10; /* User: BASE */
+    ((EnforthCell*)vm->cur_task.ram)[kTaskUserState].u = kTaskStateRunnable; /* User: STATE */
+    ((EnforthCell*)vm->cur_task.ram)[kTaskUserClaim].u = 0; /* User: CLAIM */
+    ((EnforthCell*)vm->cur_task.ram)[kTaskUserMailboxChanges].u = 0; /* User: CHANGES */
+    ((EnforthCell*)vm->cur_task.ram)[kTaskUserStackSizes].u
+        = (kTaskReturnStackSize << 8) | kTaskDataStackSize; /* User: STACKS */
+
+    /* TODO This entire block below isn't really necessary since people
+     * aren't allowed to call enforth_resume on their own.  Instead,
+     * they should always call enforth_evaluate or enforth_go.  But if
+     * they call enforth_evaluate then enforth_evaluate needs to have an
+     * IP and RSP to pop from the stack and so enforth_reset needs to
+     * prepare the stack.
+     *
+     * What we really need is some sort of vm->status enum that tells us
+     * if the VM is halted and can be resumed (and therefore has IP and
+     * RSP stack items) or has never been run and therefore
+     * enforth_evaluate doesn't need to clean anything up. */
+
+    /* Clear both stacks and prepare to start at COLD. */
+    prepare_cold_start(vm);
+}
+
+EnforthUnsigned enforth_prepare_image(EnforthVM * const vm)
+{
+    link_ffi_words(vm, 1);
+    return fill_image_header(vm)->extent;
+}
+
+int enforth_load_image(
+        EnforthVM * const vm,
+        uint8_t * const image, int dictionary_size)
+{
+    /* Verify that the image was saved by a compatible build and that it
+     * fits in the dictionary. */
+    if (!image_is_valid(vm, image, dictionary_size))
+    {
+        return 0;
+    }
+
+    /* Use the image in place as the dictionary; the space after the
+     * image's extent is available for new definitions. */
+    vm->dictionary.ram = image;
+    vm->dictionary_size.u = dictionary_size;
+    reset_dirty_pages(vm, 0, ((EnforthImageHeader *)image)->extent);
+
+    /* Start the operator task at COLD the next time the VM runs. */
+    start_image(vm);
+    return -1;
+}
+
+void enforth_begin_evaluate(EnforthVM * const vm, const char * const text)
+{
+    /* The VM may have halted in another task (which called HALT), but
+     * text is always evaluated by the operator task. */
+    vm->cur_task.ram = vm->dictionary.ram + kDictionaryToOperatorTask;
+
+    /* The operator task stops waiting for whatever it was waiting for;
+     * clearing WAITFOR makes enforth_complete ignore the result of an
+     * asynchronous FFI that the task abandoned. */
+    store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateRunnable);
+    ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor].u = 0;
+
+    /* Clear the return stack. */
+    EnforthCell * rsp = TASK_RETURN_TOP(vm->cur_task.ram) - 1;
+
+    /* Push the address of HALT onto the return stack so that we exit
+     * the interpreter after EVALUATE is done. */
+#ifdef __AVR__
+    (--rsp)->ram = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_HALT&0x3FFF) + kNFAtoPFA));
+#else
+    (--rsp)->ram = (uint8_t*)definitions + (ROMDEF_HALT&0x3FFF) + kNFAtoPFA;
+#endif
+
+    /* Restore the stack pointer. */
+    EnforthCell * sp = (EnforthCell*)DICT_ABS(vm, ((EnforthCell*)vm->cur_task.ram)[1].u);
+
+    /* Pop the previous IP and RSP; we're about to replace them. */
+    ++sp; /* IP */
+    ++sp; /* RSP */
+
+    /* Push the text and text length onto the stack. */
+    (--sp)->ram = (uint8_t*)text;
+    (--sp)->u = strlen(text);
+
+    /* Push the new RSP and IP (the beginning of EVALUATE) to the
+     * stack. */
+    (--sp)->u = DICT_REL(vm, rsp);
+    (--sp)->u = kSavedIPInROM | ((ROMDEF_EVALUATE&0x3FFF) + kNFAtoPFA);
+
+    /* Update the saved the stack pointer now that we have modified the
+     * stack. */
+    ((EnforthCell*)vm->cur_task.ram)[1].u = DICT_REL(vm, sp);
+}
+
+void enforth_evaluate(EnforthVM * const vm, const char * const text)
+{
+    /* Prepare the operator task and then resume the interpreter. */
+    enforth_begin_evaluate(vm, text);
+    enforth_resume(vm);
+}
+
+void enforth_resume(EnforthVM * const vm)
+{
+    enforth_run(vm, 0);
+}
+
+void enforth_init_worker(EnforthVM * const worker, EnforthVM * const vm)
+{
+    /* The worker shares the VM's dictionary and callbacks, but has its
+     * own registers, output buffer, and text interpreter state (which
+     * the operator task's words use, and which workers never run). */
+    memcpy(worker, vm, sizeof(*worker));
+    worker->owner = OWNER_VM(vm);
+    worker->signals = 0;
+    worker->hld = NULL;
+    worker->source_depth = 0;
+    worker->output_len = 0;
+    worker->cur_task.ram = vm->dictionary.ram + kDictionaryToOperatorTask;
+}
+
+EnforthRunResult enforth_run(EnforthVM * const vm, EnforthUnsigned slices)
+{
+    register uint8_t *ip;
+    register uint16_t xt;
+    register EnforthCell tos;
+    register EnforthCell *restDataStack; /* Points at the second item on the stack. */
+    register uint8_t *w;
+    register EnforthCell *returnTop;
+    EnforthCell *dataTop; /* The current task's empty data stack. */
+    EnforthUnsigned sliceRemaining;
+
+#ifdef __AVR__
+    register int8_t inProgramSpace;
+#endif
+
+#if ENABLE_STACK_CHECKING
+    /* Check for available stack space and abort with a message if this
+     * operation would run out of space. */
+    /* TODO The overflow logic seems slightly too aggressive -- it
+     * probably needs a "- 1" in there given that we store TOS in a
+     * register. */
+#define CHECK_STACK(numArgs, numResults) \
+    { \
+        if ((dataTop - restDataStack) < (numArgs)) { \
+            goto STACK_UNDERFLOW; \
+        } else if (((dataTop - restDataStack) - (numArgs)) + (numResults) > (EnforthInt)TASK_DATA_STACK_SIZE(vm->cur_task.ram) - 4) { \
+            goto STACK_OVERFLOW; \
+        } \
+    }
+#else
+#define CHECK_STACK(numArgs, numResults)
+#endif
+
+    /* Counts down the current task's time slice and switches to the
+     * next task (exactly as if the task had called PAUSE) once the
+     * slice has been used up.  Calls and backward branches are counted,
+     * which bounds the time between task switches even in tight loops
+     * that never call PAUSE.  A slice that was started while time
+     * slicing was disabled ends at the first check after it is enabled. */
+#define CHECK_TIME_SLICE() \
+    { \
+        if ((vm->time_slice != 0) \
+                && ((sliceRemaining == 0) || (--sliceRemaining == 0))) { \
+            goto PAUSE; \
+        } \
+    }
+
+    /* Converts the IP into the relative form that is saved on the task's
+     * stack when the task is paused or halted. */
+#ifdef __AVR__
+#define SAVED_IP() \
+    (inProgramSpace \
+        ? kSavedIPInROM | (EnforthUnsigned)(ip - (uint8_t*)definitions) \
+        : DICT_REL(vm, ip))
+#else
+#define SAVED_IP() \
+    (((ip >= (uint8_t*)definitions) && (ip < (uint8_t*)definitions + sizeof(definitions))) \
+        ? kSavedIPInROM | (EnforthUnsigned)(ip - (uint8_t*)definitions) \
+        : DICT_REL(vm, ip))
+#endif
+
+    static const void * const primitive_table[128] PROGMEM = {
+#include "enforth_jumptable.h"
+
+        /* $78 - $7F */
+        &&DOCOLON,
+        &&DOCOLONROM,
+        &&DOCONSTANT,
+        &&DOCREATE,
+
+        &&DOVARIABLE,
+        &&DOFFI,
+        &&DOROMFFI,
+        0, /* Unused */
+    };
+
+SCHEDULE:
+    /* Skip over tasks that are sleeping, blocked on a host event, or
+     * waiting for an asynchronous FFI call to complete.  If no task is
+     * runnable and at least one task is waiting for an FFI then we
+     * return to the host, which will call enforth_complete and then
+     * resume the VM.  Otherwise we let the host idle until the earliest
+     * wake time (or until it signals an event) and then look for a
+     * runnable task again.  Without an idle hook we poll the sleeping
+     * tasks, or return to the host if there are none.  Budgeted runs
+     * never idle; they return to the host as soon as nothing can run,
+     * and the host runs the VM again after vm->wait_ticks.
+     *
+     * Tasks that another thread has claimed are skipped as well, but
+     * are polled again after a tick, since that thread may be about to
+     * make one of our tasks runnable.  Worker contexts leave the
+     * operator task to the VM that owns them. */
+    {
+        uint8_t * const first_task = vm->cur_task.ram;
+        EnforthUnsigned idle_ticks = ~(EnforthUnsigned)0;
+        int8_t any_pending = 0;
+
+        for (;;)
+        {
+            EnforthCell * const task = (EnforthCell*)vm->cur_task.ram;
+            EnforthUnsigned wait_ticks = ~(EnforthUnsigned)0;
+
+            if ((vm->owner == NULL)
+                || (vm->cur_task.ram != vm->dictionary.ram + kDictionaryToOperatorTask))
+            {
+                if (!claim_task(task))
+                {
+                    wait_ticks = 1;
+                }
+                else if ((wait_ticks = ticks_until_runnable(vm)) == 0)
+                {
+                    break;
+                }
+                else
+                {
+                    if (task[kTaskUserState].u == kTaskStatePending)
+                    {
+                        any_pending = -1;
+                    }
+
+                    release_task(task);
+                }
+            }
+
+            if (wait_ticks < idle_ticks)
+            {
+                idle_ticks = wait_ticks;
+            }
+
+            select_previous_task(vm);
+
+            if (vm->cur_task.ram == first_task)
+            {
+                if (any_pending
+                    || (slices != 0)
+                    || ((vm->idle != NULL)
+                        ? !vm->idle(idle_ticks)
+                        : (idle_ticks == ~(EnforthUnsigned)0)))
+                {
+                    vm->wait_ticks = idle_ticks;
+                    vm->cur_task.ram = vm->dictionary.ram + kDictionaryToOperatorTask;
+                    return kEnforthRunWaiting;
+                }
+
+                idle_ticks = ~(EnforthUnsigned)0;
+            }
+        }
+    }
+
+UNPAUSE:
+
+    /* Start a new time slice. */
+    sliceRemaining = vm->time_slice;
+
+    /* Find the task's data stack. */
+    dataTop = TASK_DATA_TOP(vm->cur_task.ram);
+
+    /* Restore the stack pointer. */
+    restDataStack = (EnforthCell*)DICT_ABS(vm, ((EnforthCell*)vm->cur_task.ram)[1].u);
+
+    /* Pop IP and RSP from the stack. */
+    if ((restDataStack->u & kSavedIPInROM) != 0)
+    {
+        /* This IP points at a ROM definition. */
+        ip = (uint8_t*)definitions + (restDataStack->u & ~kSavedIPInROM);
+#ifdef __AVR__
+        inProgramSpace = -1;
+#endif
+    }
+    else
+    {
+        ip = DICT_ABS(vm, restDataStack->u);
+#ifdef __AVR__
+        inProgramSpace = 0;
+#endif
+    }
+    restDataStack++;
+
+    returnTop = (EnforthCell *)DICT_ABS(vm, (restDataStack++)->u);
+
+    /* Pop TOS into our register. */
+    tos = *restDataStack++;
+
+    /* The inner interpreter. */
+    for (;;)
+    {
+        /* Get the next instruction, which could be one or two bytes
+         * depending on if this is a Code Primitive (one byte) or a
+         * Definition (two bytes).  The W ("Word") pointer needs to be
+         * set if this is a Definition. */
+        uint8_t token;
+
+#ifdef __AVR__
+        if (inProgramSpace)
+        {
+            token = pgm_read_byte(ip++);
+        }
+        else
+#endif
+        {
+            token = *ip++;
+        }
+
+        /* Is this actually a token (< 128)?  If so, dispatch the
+         * token. */
+        if (token < 128)
+        {
+            w = NULL;
+            goto DISPATCH_TOKEN;
+        }
+        else
+        {
+            /* Not a token, which means that this is a two-byte XT that
+             * points at the NFA of the word to be called. */
+            xt = token << 8;
+
+#ifdef __AVR__
+            if (inProgramSpace)
+            {
+                xt |= pgm_read_byte(ip++);
+            }
+            else
+#endif
+            {
+                xt |= *ip++;
+            }
+
+DISPATCH_XT:
+            /* This is a two-byte XT that points at another word.  We
+             * need to find the word that is being targeted by this XT
+             * and set W to that word's PFA.  We then need to dispatch
+             * to the word's Code Field.  The Code Field will almost
+             * always contain a DO* token, *unless the word was modified
+             * by a defining word.*  In that case, the Code Field will
+             * contain a full, two-byte XT and that XT will point to the
+             * runtime behavior of the defining word (the code after
+             * DOES> in the defining word).
+             *
+             * Note that ROM Definitions never use DOES> and so we can
+             * assume that the Code Field in a ROM Definition will
+             * always contain a token.
+             *
+             * ROM FFI words do not have a definition; their XT is the
+             * DOROMFFI token followed by the index of the FFI, which is
+             * also how they are compiled.  We only see those XTs here
+             * when they are EXECUTEd. */
+            if (xt < 0x8000) /* ROM FFI: DOROMFFI index */
+            {
+                goto DISPATCH_ROMFFI;
+            }
+            else if ((xt & 0xC000) == 0xC000) /* ROM Definition: 0xCxxx */
+            {
+                /* Advance past the empty first byte in the Code Field,
+                 * then read the token in the second byte. */
+                /* TODO We could probably eliminate the first byte in
+                 * ROM Definitions. */
+                w = (uint8_t*)((uint8_t*)definitions + (xt & 0x3FFF) + kNFAtoCFA + 1);
+#ifdef __AVR__
+                token = pgm_read_byte(w++);
+#else
+                token = *w++;
+#endif
+            }
+            else /* User Definition: 0x8xxx */
+            {
+                /* Load the Code Field. */
+                w = (uint8_t*)(vm->dictionary.ram + (xt & 0x3FFF) + kNFAtoCFA);
+                xt = *w++ << 8;
+                xt |= *w++;
 
                 /* We're done if this is a token. */
                 if (xt < 0x80)
@@ -433,771 +1647,1100 @@ DISPATCH_XT:
             }
         }
 
-        /* W now points at the PFA; fall through to dispatch the CFA
-         * token. */
+        /* W now points at the PFA; fall through to dispatch the CFA
+         * token. */
+
+DISPATCH_TOKEN:
+#if ENABLE_TRACING == 2
+        {
+            int i;
+            for (i = 0; i < vm->trace_level; i++)
+            {
+                printf(".");
+            }
+
+            printf(" [%02x] ", token);
+
+            /* FIXME Needs to get the XT of the token and then use that
+             * to retrieve the name. */
+#if false
+            if (token < DOCOLON) /* No names for DO* tokens */
+            {
+                const char * curDef = kDefinitionNames;
+                for (i = 0; i < token; i++)
+                {
+                    curDef += 1 + (((unsigned int)*curDef) & 0x1f);
+                }
+
+                for (i = 1; i <= (((unsigned int)*curDef) & 0x1f); i++)
+                {
+                    printf("%c", *(curDef + i));
+                }
+            }
+#endif
+
+            for (i = 0; i < (dataTop + 1) - restDataStack - 1; i++)
+            {
+                printf(" %x", dataTop[-1 - i].u);
+            }
+
+            if (((dataTop + 1) - restDataStack) > 0)
+            {
+                printf(" %x", tos.u);
+            }
+
+            printf("\n");
+        }
+#endif
+
+        goto *(void *)pgm_read_word(&primitive_table[token]);
+
+
+#if ENABLE_STACK_CHECKING
+        STACK_OVERFLOW:
+        {
+            type_chars(vm, "\n!OV\n", 5);
+            goto ABORT;
+        }
+        continue;
+
+        STACK_UNDERFLOW:
+        {
+            type_chars(vm, "\n!UN\n", 5);
+            goto ABORT;
+        }
+        continue;
+#endif
+
+        SOURCE_OVERFLOW:
+        {
+            type_chars(vm, "\n!SO\n", 5);
+            goto ABORT;
+        }
+        continue;
+
+
+        /* =============================================================
+         * KERNEL PRIMITIVES
+         */
+
+        DOCOLON:
+        {
+            /* IP points to the next word in the PFA and that is the
+             * location to which we should return once this new word has
+             * executed. */
+#ifdef __AVR__
+            if (inProgramSpace)
+            {
+                /* FIXME Can this ever happen?  How would a ROM word
+                 * know about a RAM word? */
+                /* Set the high bit on the return address so that we
+                 * know that this address is in ROM. */
+                ip = (uint8_t*)((unsigned int)ip | 0x8000);
+
+                /* We are no longer in program space since, by design,
+                 * DOCOLON is only ever used for user-defined words in
+                 * RAM. */
+                inProgramSpace = 0;
+            }
+#endif
+            (--returnTop)->ram = ip;
+
+            /* Now set the IP to the PFA of the word that is being
+             * called and continue execution inside of that word. */
+            ip = w;
+
+            /* Calls count against the time slice. */
+            CHECK_TIME_SLICE();
+        }
+        continue;
+
+        DOCOLONROM:
+        {
+#if ENABLE_TRACING
+            vm->trace_level++;
+
+            int i;
+            for (i = 0; i < vm->trace_level; i++)
+            {
+                printf(">");
+            }
+
+            printf(" [%02x] ", token);
+
+            /* W points at the PFA; back up to the NFA. */
+            const char * curDef = (const char *)w - (1 + 2 + 1);
+
+            /* Is this a hidden definition (the name is length zero)?
+             * If so, output the XT instead of the name. */
+            if ((*curDef & 0x1f) == 0)
+            {
+                printf("<pfa=0x%04X>", 0xC000 | (uint16_t)((uint8_t*)curDef - (uint8_t*)definitions));
+            }
+            else
+            {
+                /* Normal definition; walk backwards and output the
+                 * name. */
+                for (i = 1; i <= (((unsigned int)*curDef) & 0x1f); --i)
+                {
+                    printf("%c", *(curDef + i) & 0x7f);
+                }
+            }
+
+            /* Print the data stack and top-of-stack. */
+            for (i = 0; i < (dataTop + 1) - restDataStack - 1; i++)
+            {
+                printf(" %x", dataTop[-1 - i].u);
+            }
+
+            if (((dataTop + 1) - restDataStack) > 0)
+            {
+                printf(" %x", tos.u);
+            }
+
+            printf("\n");
+            fflush(stdout);
+#endif
+            /* IP points to the next word in the PFA and that is the
+             * location to which we should return once this new word has
+             * executed. */
+#ifdef __AVR__
+            if (inProgramSpace)
+            {
+                /* Set the high bit on the return address so that we
+                 * know that this address is in ROM. */
+                ip = (uint8_t*)((unsigned int)ip | 0x8000);
+            }
+#endif
+            (--returnTop)->ram = ip;
+
+            /* Now set the IP to the PFA of the word that is being
+             * called and continue execution inside of that word. */
+            ip = w;
+
+#ifdef __AVR__
+            /* We are obviously now in program space since, by design,
+             * DOCOLONROM is only ever used for ROM definitions. */
+            inProgramSpace = -1;
+#endif
+
+            /* Calls count against the time slice. */
+            CHECK_TIME_SLICE();
+        }
+        continue;
+
+        DOCONSTANT:
+        {
+            /* W points at the PFA of this word; push the address in
+             * that location onto the stack. */
+            *--restDataStack = tos;
+            tos = *(EnforthCell*)w;
+        }
+        continue;
+
+        DODOES:
+        {
+            /* We're currently sitting in a word that is calling a word
+             * defined with DOES>.  IP has been advanced beyond that
+             * call and is still in the calling word.  XT contains the
+             * Code Field of the defined word (and thus points to the
+             * DOES> part of the defining word's thread).  We need to
+             * push IP to the stack, push the PFA of the defined word to
+             * the stack, and then continue execution at XT (the
+             * defining word's runtime behavior). */
+#ifdef __AVR__
+            if (inProgramSpace)
+            {
+                /* FIXME Can this ever happen?  How would a ROM word
+                 * know about a RAM word? */
+                /* Set the high bit on the return address so that we
+                 * know that this address is in ROM. */
+                ip = (uint8_t*)((unsigned int)ip | 0x8000);
+
+                /* We are no longer in program space since, by design,
+                 * DODOES is only ever used for user-defined words in
+                 * RAM. */
+                inProgramSpace = 0;
+            }
+#endif
+            (--returnTop)->ram = ip;
+
+            /* W points at the PFA of the defined word; push that to the
+             * stack per the runtime behavior of DOES>. */
+            *--restDataStack = tos;
+            tos.ram = w;
+
+            /* Point IP at the DOES> portion of the defining word (which
+             * is the target of the defined word's Code Field and is
+             * thus in XT). */
+            ip = (uint8_t*)(vm->dictionary.ram + (xt & 0x3FFF));
+        }
+        continue;
+
+        DOCREATE:
+        DOVARIABLE:
+        {
+            /* W points at the PFA of this word; push that location onto
+             * the stack. */
+            *--restDataStack = tos;
+            tos.ram = w;
+        }
+        continue;
 
-DISPATCH_TOKEN:
-#if ENABLE_TRACING == 2
+        DOFFI:
+            /* W contains a pointer to the PFA of the FFI definition;
+             * point W at the FFI definition itself. */
+            w = (uint8_t*)*(EnforthFFIDef**)w;
+
+CALL_FFIDEF:
         {
-            int i;
-            for (i = 0; i < gTraceLevel; i++)
-            {
-                printf(".");
-            }
+            /* W points at the FFI definition; use that to get the FFI
+             * adapter. */
+            const EnforthFFIDef * const ffidef = (const EnforthFFIDef *)w;
+            EnforthFFI fn = (EnforthFFI)pgm_read_word(&ffidef->fn);
 
-            printf(" [%02x] ", token);
+            CHECK_STACK(
+                    pgm_read_byte(&ffidef->arity),
+                    pgm_read_byte(&ffidef->results) & ~ENFORTH_FFI_ASYNC);
 
-            /* FIXME Needs to get the XT of the token and then use that
-             * to retrieve the name. */
-#if false
-            if (token < 0x70) /* No names for DO* tokens */
-            {
-                const char * curDef = kDefinitionNames;
-                for (i = 0; i < token; i++)
-                {
-                    curDef += 1 + (((unsigned int)*curDef) & 0x1f);
-                }
+#if ENABLE_FFI_STATS
+            const uint32_t start = vm->ffi_clock != NULL ? vm->ffi_clock() : 0;
+#endif
 
-                for (i = 1; i <= (((unsigned int)*curDef) & 0x1f); i++)
-                {
-                    printf("%c", *(curDef + i));
-                }
-            }
+            /* Spill TOS so that the adapter can access the top of the
+             * stack (and the super TOS beyond it) as an array, then
+             * apply the stack adjustment returned by the adapter. */
+            *--restDataStack = tos;
+            restDataStack -= (*fn)(restDataStack);
+            tos = *restDataStack++;
+
+#if ENABLE_FFI_STATS
+            record_ffi_call(ffidef, vm->ffi_clock != NULL ? vm->ffi_clock() - start : 0);
 #endif
 
-            for (i = 0; i < &vm->data_stack[32] - restDataStack - 1; i++)
+            /* Asynchronous FFIs leave a handle on the stack instead of
+             * their result; park the task on that handle until the
+             * host calls enforth_complete, which pushes the result.  A
+             * zero handle means that the operation could not be
+             * started, so the call finishes right away and leaves that
+             * zero as its result. */
+            if (((pgm_read_byte(&ffidef->results) & ENFORTH_FFI_ASYNC) != 0)
+                    && (tos.u != 0))
             {
-                printf(" %x", vm->data_stack[30 - i].u);
+                ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor] = tos;
+                store_cell(
+                        &((EnforthCell*)vm->cur_task.ram)[kTaskUserState],
+                        kTaskStatePending);
+                tos = *restDataStack++;
+                goto PAUSE;
             }
+        }
+        continue;
 
-            if ((&vm->data_stack[32] - restDataStack) > 0)
+        DOROMFFI:
+            /* The token is followed by the index of the FFI in the ROM
+             * FFI table. */
+#ifdef __AVR__
+            if (inProgramSpace)
             {
-                printf(" %x", tos.u);
+                xt = pgm_read_byte(ip++);
             }
-
-            printf("\n");
-        }
+            else
 #endif
+            {
+                xt = *ip++;
+            }
 
-        goto *(void *)pgm_read_word(&primitive_table[token]);
-
+DISPATCH_ROMFFI:
+            w = (uint8_t*)pgm_read_word(&vm->rom_ffis[xt & 0xFF]);
+            goto CALL_FFIDEF;
 
-#if ENABLE_STACK_CHECKING
-        STACK_OVERFLOW:
+        /* -------------------------------------------------------------
+        ***{:token :ibranch
+        *** :flags #{:headerless}}
+         */
+        /* TODO Add docs re: Note that (branch) and (0branch) offsets
+         * are 8-bit relative offsets.  UNLIKE word addresses, the IP
+         * points at the offset in BRANCH/ZBRANCH.  These offsets can be
+         * positive or negative because branches can go both forwards
+         * and backwards. */
+        IBRANCH:
+#ifdef __AVR__
         {
-            if (vm->emit != NULL)
+            CHECK_STACK(0, 0);
+            const int8_t offset = (int8_t)pgm_read_byte(ip);
+            ip += offset;
+
+            /* Backward branches count against the time slice. */
+            if (offset < 0)
             {
-                vm->emit('\n');
-                vm->emit('!');
-                vm->emit('O');
-                vm->emit('V');
-                vm->emit('\n');
+                CHECK_TIME_SLICE();
             }
-            goto ABORT;
         }
         continue;
+#else
+        /* Fall through, since the other architectures use shared
+         * instruction and data space. */
+#endif
 
-        STACK_UNDERFLOW:
+        /* -------------------------------------------------------------
+        ***{:token :branch
+        *** :flags #{:headerless}}
+         */
+        /* TODO Add docs re: Note that (branch) and (0branch) offsets
+         * are 8-bit relative offsets.  UNLIKE word addresses, the IP
+         * points at the offset in BRANCH/ZBRANCH.  These offsets can be
+         * positive or negative because branches can go both forwards
+         * and backwards. */
+        BRANCH:
         {
-            if (vm->emit != NULL)
+            CHECK_STACK(0, 0);
+
+            /* Relative, because these are entirely within a single word
+             * and so we want it to be relocatable without us having to
+             * do anything.  Note that the offset cannot be larger than
+             * +/- 127 bytes! */
+            const int8_t offset = *(int8_t*)ip;
+            ip += offset;
+
+            /* Backward branches count against the time slice. */
+            if (offset < 0)
             {
-                vm->emit('\n');
-                vm->emit('!');
-                vm->emit('U');
-                vm->emit('N');
-                vm->emit('\n');
+                CHECK_TIME_SLICE();
             }
-            goto ABORT;
         }
         continue;
-#endif
 
+        /* -------------------------------------------------------------
+        ***{:token :icharlit
+        *** :args [[] [:char]]
+        *** :flags #{:headerless}}
+         */
+        ICHARLIT:
+#ifdef __AVR__
+        {
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos.i = pgm_read_byte(ip);
+            ip++;
+        }
+        continue;
+#else
+        /* Fall through, since the other architectures use shared
+         * instruction and data space. */
+#endif
 
-        /* =============================================================
-         * KERNEL PRIMITIVES
+        /* -------------------------------------------------------------
+        ***{:token :charlit
+        *** :flags #{:headerless}}
          */
+        CHARLIT:
+        {
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos.i = *ip++;
+        }
+        continue;
 
-        DOCOLON:
+        /* -------------------------------------------------------------
+        ***{:token :exit}
+         */
+        EXIT:
         {
-            /* IP points to the next word in the PFA and that is the
-             * location to which we should return once this new word has
-             * executed. */
-#ifdef __AVR__
-            if (inProgramSpace)
+#if ENABLE_TRACING
+            int i;
+            for (i = 0; i < vm->trace_level; i++)
             {
-                /* FIXME Can this ever happen?  How would a ROM word
-                 * know about a RAM word? */
-                /* Set the high bit on the return address so that we
-                 * know that this address is in ROM. */
-                ip = (uint8_t*)((unsigned int)ip | 0x8000);
+                printf("<");
+            }
 
-                /* We are no longer in program space since, by design,
-                 * DOCOLON is only ever used for user-defined words in
-                 * RAM. */
+            printf(" (");
+            for (i = 0; i < (dataTop + 1) - restDataStack - 1; i++)
+            {
+                printf("%x ", dataTop[-1 - i].u);
+            }
+
+            if (((dataTop + 1) - restDataStack) > 0)
+            {
+                printf("%x", tos.u);
+            }
+            printf(")");
+
+            printf(" (R:");
+            for (i = 0; i < (TASK_RETURN_TOP(vm->cur_task.ram) + 1) - returnTop; i++)
+            {
+                printf(" %x", TASK_RETURN_TOP(vm->cur_task.ram)[-i].u);
+            }
+            printf(")");
+
+            printf("\n");
+
+            vm->trace_level--;
+#endif
+
+            ip = (uint8_t *)((returnTop++)->ram);
+
+#ifdef __AVR__
+            if (((unsigned int)ip & 0x8000) != 0)
+            {
+                /* This return address points at a ROM definition; strip
+                 * off that flag as part of popping the address. */
+                ip = (uint8_t*)((unsigned int)ip & 0x7FFF);
+                inProgramSpace = -1;
+            }
+            else
+            {
                 inProgramSpace = 0;
             }
 #endif
-            (--returnTop)->ram = ip;
+        }
+        continue;
+
+        /* -------------------------------------------------------------
+        ***{:token :lit
+        *** :name "(LIT)"
+        *** :args [[] [:x]]
+        *** :flags #{:headerless}}
+         */
+        /* Cannot be used in ROM definitions! */
+        LIT:
+        {
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos = *(EnforthCell*)ip;
+            ip += kEnforthCellSize;
+        }
+        continue;
+
+        /* -------------------------------------------------------------
+         * PAUSE [Enforth] ( -- )
+         *
+         * Suspend the current task and resume execution of the next
+         * task in the task list.  PAUSE will return to the caller when
+         * all of the tasks in the task list have had a chance to
+         * execute (and called PAUSE in order to relinquish execution to
+         * their next task).
+         *
+        ***{:token :pause}
+         */
+        PAUSE:
+        {
+            /* Let the host display our output before the next task
+             * runs. */
+            flush_output(vm);
+
+            /* Push TOS onto the stack. */
+            *--restDataStack = tos;
+
+            /* Push RSP and IP to the stack. */
+            (--restDataStack)->u = DICT_REL(vm, returnTop);
+            (--restDataStack)->u = SAVED_IP();
+
+            /* Save the stack pointer; the task can now be run by
+             * another thread. */
+            ((EnforthCell*)vm->cur_task.ram)[1].u = DICT_REL(vm, restDataStack);
+            release_task((EnforthCell*)vm->cur_task.ram);
+
+            /* Make the previous task the current task and then resume
+             * the next task that is not waiting, unless this was the
+             * last task switch in the run's budget. */
+            select_previous_task(vm);
+
+            if ((slices != 0) && (--slices == 0))
+            {
+                return kEnforthRunYielded;
+            }
+
+            goto SCHEDULE;
+        }
+
+        /* -------------------------------------------------------------
+         * (HALT) [Enforth] ( i*x -- i*x ) ( R: j*x -- j*x )
+         *
+         * Stops and exits the VM.  State is preserved on the stack,
+         * allowing the VM to be resumed by enforth_resume.
+         *
+        ***{:token :phalt
+        *** :name "(HALT)"
+        *** :args [[] []]
+        *** :flags #{:headerless}}
+         */
+        PHALT:
+        {
+            /* Display any buffered output. */
+            flush_output(vm);
+
+            /* Push TOS onto the stack. */
+            *--restDataStack = tos;
+
+            /* Push RSP and IP to the stack. */
+            (--restDataStack)->u = DICT_REL(vm, returnTop);
+            (--restDataStack)->u = SAVED_IP();
+
+            /* Save the stack pointer. */
+            ((EnforthCell*)vm->cur_task.ram)[1].u = DICT_REL(vm, restDataStack);
+            release_task((EnforthCell*)vm->cur_task.ram);
+
+            /* Exit the interpreter. */
+            return kEnforthRunHalted;
+        }
+
+        /* -------------------------------------------------------------
+        ***{:token :izbranch
+        *** :flags #{:headerless}}
+         */
+        IZBRANCH:
+#ifdef __AVR__
+        {
+            CHECK_STACK(1, 0);
+
+            if (tos.i == 0)
+            {
+                const int8_t offset = (int8_t)pgm_read_byte(ip);
+                ip += offset;
+                tos = *restDataStack++;
 
-            /* Now set the IP to the PFA of the word that is being
-             * called and continue execution inside of that word. */
-            ip = w;
+                /* Backward branches count against the time slice. */
+                if (offset < 0)
+                {
+                    CHECK_TIME_SLICE();
+                }
+            }
+            else
+            {
+                ip++;
+                tos = *restDataStack++;
+            }
         }
         continue;
+#else
+        /* Fall through, since the other architectures use shared
+         * instruction and data space. */
+#endif
 
-        DOCOLONROM:
+        /* -------------------------------------------------------------
+        ***{:token :zbranch
+        *** :name "0BRANCH"
+        *** :flags #{:headerless}}
+         */
+        ZBRANCH:
         {
-#if ENABLE_TRACING
-            gTraceLevel++;
+            CHECK_STACK(1, 0);
 
-            int i;
-            for (i = 0; i < gTraceLevel; i++)
+            if (tos.i == 0)
             {
-                printf(">");
-            }
-
-            printf(" [%02x] ", token);
-
-            /* W points at the PFA; back up to the NFA. */
-            const char * curDef = (const char *)w - (1 + 2 + 1);
+                const int8_t offset = *(int8_t*)ip;
+                ip += offset;
+                tos = *restDataStack++;
 
-            /* Is this a hidden definition (the name is length zero)?
-             * If so, output the XT instead of the name. */
-            if ((*curDef & 0x1f) == 0)
-            {
-                printf("<pfa=0x%04X>", 0xC000 | (uint16_t)((uint8_t*)curDef - (uint8_t*)definitions));
-            }
-            else
-            {
-                /* Normal definition; walk backwards and output the
-                 * name. */
-                for (i = 1; i <= (((unsigned int)*curDef) & 0x1f); --i)
+                /* Backward branches count against the time slice. */
+                if (offset < 0)
                 {
-                    printf("%c", *(curDef + i) & 0x7f);
+                    CHECK_TIME_SLICE();
                 }
             }
-
-            /* Print the data stack and top-of-stack. */
-            for (i = 0; i < &vm->data_stack[32] - restDataStack - 1; i++)
+            else
             {
-                printf(" %x", vm->data_stack[30 - i].u);
+                ip++;
+                tos = *restDataStack++;
             }
+        }
+        continue;
 
-            if ((&vm->data_stack[32] - restDataStack) > 0)
-            {
-                printf(" %x", tos.u);
-            }
 
-            printf("\n");
-            fflush(stdout);
-#endif
-            /* IP points to the next word in the PFA and that is the
-             * location to which we should return once this new word has
-             * executed. */
-#ifdef __AVR__
-            if (inProgramSpace)
-            {
-                /* Set the high bit on the return address so that we
-                 * know that this address is in ROM. */
-                ip = (uint8_t*)((unsigned int)ip | 0x8000);
-            }
-#endif
-            (--returnTop)->ram = ip;
 
-            /* Now set the IP to the PFA of the word that is being
-             * called and continue execution inside of that word. */
-            ip = w;
+        /* =============================================================
+         * CORE PRIMITIVES
+         */
+
+        /* -------------------------------------------------------------
+         * ABORT [CORE] 6.1.0670 ( i*x -- ) ( R: j*x -- )
+         *
+         * Empty the data stack and perform the function of QUIT, which
+         * includes emptying the return stack, without displaying a
+         * message.
+         *
+        ***{:token :abort}
+         */
+        ABORT:
+        {
+            tos.i = 0;
+            restDataStack = dataTop;
+            ((EnforthCell*)vm->cur_task.ram)[2].u = 10; /* User: BASE */
 
+            /* Set the IP to the beginning of QUIT */
 #ifdef __AVR__
-            /* We are obviously now in program space since, by design,
-             * DOCOLONROM is only ever used for ROM definitions. */
-            inProgramSpace = -1;
+            ip = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_QUIT&0x3FFF) + kNFAtoPFA));
+#else
+            ip = (uint8_t*)definitions + (ROMDEF_QUIT&0x3FFF) + kNFAtoPFA;
 #endif
         }
         continue;
 
-        DOCONSTANT:
+        /* -------------------------------------------------------------
+        ***{:token :abs}
+         */
+        ABS:
         {
-            /* W points at the PFA of this word; push the address in
-             * that location onto the stack. */
-            *--restDataStack = tos;
-            tos = *(EnforthCell*)w;
+            CHECK_STACK(1, 1);
+            tos.u = abs(tos.i);
         }
         continue;
 
-        DODOES:
+        /* -------------------------------------------------------------
+        ***{:token :and}
+         */
+        AND:
         {
-            /* We're currently sitting in a word that is calling a word
-             * defined with DOES>.  IP has been advanced beyond that
-             * call and is still in the calling word.  XT contains the
-             * Code Field of the defined word (and thus points to the
-             * DOES> part of the defining word's thread).  We need to
-             * push IP to the stack, push the PFA of the defined word to
-             * the stack, and then continue execution at XT (the
-             * defining word's runtime behavior). */
-#ifdef __AVR__
-            if (inProgramSpace)
-            {
-                /* FIXME Can this ever happen?  How would a ROM word
-                 * know about a RAM word? */
-                /* Set the high bit on the return address so that we
-                 * know that this address is in ROM. */
-                ip = (uint8_t*)((unsigned int)ip | 0x8000);
-
-                /* We are no longer in program space since, by design,
-                 * DODOES is only ever used for user-defined words in
-                 * RAM. */
-                inProgramSpace = 0;
-            }
-#endif
-            (--returnTop)->ram = ip;
-
-            /* W points at the PFA of the defined word; push that to the
-             * stack per the runtime behavior of DOES>. */
-            *--restDataStack = tos;
-            tos.ram = w;
-
-            /* Point IP at the DOES> portion of the defining word (which
-             * is the target of the defined word's Code Field and is
-             * thus in XT). */
-            ip = (uint8_t*)(vm->dictionary.ram + (xt & 0x3FFF));
+            CHECK_STACK(2, 1);
+            tos.i &= restDataStack++->i;
         }
         continue;
 
-        DOCREATE:
-        DOVARIABLE:
+        /* -------------------------------------------------------------
+        ***{:token :base}
+         */
+        BASE:
         {
-            /* W points at the PFA of this word; push that location onto
-             * the stack. */
+            CHECK_STACK(0, 1);
             *--restDataStack = tos;
-            tos.ram = w;
+            tos.ram = (uint8_t*)&((EnforthCell*)vm->cur_task.ram)[2];
         }
         continue;
 
-        DOFFI0:
+        /* -------------------------------------------------------------
+        ***{:token :icfetch
+        *** :name "IC@"
+        *** :args [[:c-addr] [:c]]
+        *** :flags #{:headerless}}
+         */
+        ICFETCH:
+#ifdef __AVR__
         {
-            CHECK_STACK(0, 1);
-
-            /* W contains a pointer to the PFA of the FFI definition;
-             * get the FFI definition pointer and then use that to get
-             * the FFI function pointer.  Get the value of the is_void
-             * flag as well.*/
-            ZeroArgFFI fn = (ZeroArgFFI)pgm_read_word(&(*(EnforthFFIDef**)w)->fn);
-            uint8_t is_void = pgm_read_byte(&(*(EnforthFFIDef**)w)->is_void);
-
-            if (is_void == 0)
-            {
-                *--restDataStack = tos;
-                tos = (*fn)();
-            }
-            else
-            {
-                (*fn)();
-            }
+            CHECK_STACK(1, 1);
+            tos.u = pgm_read_byte(tos.ram);
         }
         continue;
-
-        DOFFI1:
+#else
+        /* Fall through, since the other architectures use shared
+         * instruction and data space. */
+#endif
+        /* -------------------------------------------------------------
+        ***{:token :cfetch
+        *** :name "C@"}
+         */
+        CFETCH:
         {
             CHECK_STACK(1, 1);
-
-            /* W contains a pointer to the PFA of the FFI definition;
-             * get the FFI definition pointer and then use that to get
-             * the FFI function pointer.  Get the value of the is_void
-             * flag as well. */
-            OneArgFFI fn = (OneArgFFI)pgm_read_word(&(*(EnforthFFIDef**)w)->fn);
-            uint8_t is_void = pgm_read_byte(&(*(EnforthFFIDef**)w)->is_void);
-
-            tos = (*fn)(tos);
-
-            if (is_void == 1)
-            {
-                tos = *restDataStack++;
-            }
+            tos.u = *(uint8_t*)tos.ram;
         }
         continue;
 
-        DOFFI2:
+        /* -------------------------------------------------------------
+         * C! [CORE] 6.1.0850 "c-store" ( char c-addr -- )
+         *
+         * Store char at c-addr.  When character size is smaller than
+         * cell size, only the number of low-order bits corresponding to
+         * character size are transferred.
+         *
+        ***{:token :cstore
+        *** :name "C!"}
+         */
+        CSTORE:
         {
-            CHECK_STACK(2, 1);
-            TwoArgFFI fn = (TwoArgFFI)pgm_read_word(&(*(EnforthFFIDef**)w)->fn);
-            uint8_t is_void = pgm_read_byte(&(*(EnforthFFIDef**)w)->is_void);
-
-            EnforthCell arg2 = tos;
-            EnforthCell arg1 = *restDataStack++;
-
-            tos = (*fn)(arg1, arg2);
-
-            if (is_void == 1)
-            {
-                tos = *restDataStack++;
-            }
+            CHECK_STACK(2, 0);
+            mark_dirty(vm, tos.ram, 1);
+            *(uint8_t*)tos.ram = restDataStack++->u;
+            tos = *restDataStack++;
         }
         continue;
 
-        DOFFI3:
+        /* -------------------------------------------------------------
+         * DEPTH [CORE] 6.1.1200 ( -- +n )
+         *
+         * +n is the number of single-cell values contained in the data
+         * stack before +n was placed on the stack.
+         *
+        ***{:token :depth}
+         */
+        DEPTH:
         {
-            CHECK_STACK(3, 1);
-            ThreeArgFFI fn = (ThreeArgFFI)pgm_read_word(&(*(EnforthFFIDef**)w)->fn);
-            uint8_t is_void = pgm_read_byte(&(*(EnforthFFIDef**)w)->is_void);
-
-            EnforthCell arg3 = tos;
-            EnforthCell arg2 = *restDataStack++;
-            EnforthCell arg1 = *restDataStack++;
-
-            tos = (*fn)(arg1, arg2, arg3);
+            CHECK_STACK(0, 1);
 
-            if (is_void == 1)
-            {
-                tos = *restDataStack++;
-            }
+            /* Save TOS, then calculate the stack depth.  The return
+             * value should be the number of items on the stack *before*
+             * DEPTH was called and so we have to subtract one from the
+             * count given that we calculate the depth *after* pushing
+             * the old TOS onto the stack. */
+            *--restDataStack = tos;
+            tos.i = dataTop - restDataStack - 1;
         }
         continue;
 
-        DOFFI4:
-            CHECK_STACK(4, 1);
-        continue;
-
-        DOFFI5:
-            CHECK_STACK(5, 1);
+        /* -------------------------------------------------------------
+        ***{:token :drop
+        *** :args [[:x1 :x2] [:x1]]}
+         */
+        DROP:
+        {
+            CHECK_STACK(1, 0);
+            tos = *restDataStack++;
+        }
         continue;
 
-        DOFFI6:
-            CHECK_STACK(6, 1);
+        /* -------------------------------------------------------------
+        ***{:token :dup
+        *** :args [[:x] [:x :x]]}
+         */
+        DUP:
+        {
+            CHECK_STACK(1, 2);
+            *--restDataStack = tos;
+        }
         continue;
 
-        DOFFI7:
-            CHECK_STACK(7, 1);
+        /* -------------------------------------------------------------
+        ***{:token :emit}
+         */
+        EMIT:
+        {
+            CHECK_STACK(1, 0);
+            emit_char(vm, tos.i);
+            tos = *restDataStack++;
+        }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :ibranch
-        *** :flags #{:headerless}}
+        ***{:token :equals
+        *** :name "="}
          */
-        /* TODO Add docs re: Note that (branch) and (0branch) offsets
-         * are 8-bit relative offsets.  UNLIKE word addresses, the IP
-         * points at the offset in BRANCH/ZBRANCH.  These offsets can be
-         * positive or negative because branches can go both forwards
-         * and backwards. */
-        IBRANCH:
-#ifdef __AVR__
+        EQUALS:
         {
-            CHECK_STACK(0, 0);
-            ip += (int8_t)pgm_read_byte(ip);
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->i == tos.i ? -1 : 0;
         }
         continue;
-#else
-        /* Fall through, since the other architectures use shared
-         * instruction and data space. */
-#endif
 
         /* -------------------------------------------------------------
-        ***{:token :branch
-        *** :flags #{:headerless}}
+         * EXECUTE [CORE] 6.1.1370 ( i*x xt -- j*x )
+         *
+         * Remove xt from the stack and perform the semantics identified
+         * by it.  Other stack effects are due to the word EXECUTEd.
+         *
+        ***{:token :execute
+        *** :args [[:xt] []]}
          */
-        /* TODO Add docs re: Note that (branch) and (0branch) offsets
-         * are 8-bit relative offsets.  UNLIKE word addresses, the IP
-         * points at the offset in BRANCH/ZBRANCH.  These offsets can be
-         * positive or negative because branches can go both forwards
-         * and backwards. */
-        BRANCH:
+        EXECUTE:
         {
-            CHECK_STACK(0, 0);
-
-            /* Relative, because these are entirely within a single word
-             * and so we want it to be relocatable without us having to
-             * do anything.  Note that the offset cannot be larger than
-             * +/- 127 bytes! */
-            ip += *(int8_t*)ip;
+            xt = tos.u;
+            tos = *restDataStack++;
+            goto DISPATCH_XT;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :icharlit
-        *** :args [[] [:char]]
+        ***{:token :ifetch
+        *** :name "I@"
+        *** :args [[:addr] [:x]]
         *** :flags #{:headerless}}
          */
-        ICHARLIT:
+        IFETCH:
 #ifdef __AVR__
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.i = pgm_read_byte(ip);
-            ip++;
+            CHECK_STACK(1, 1);
+            tos.u = pgm_read_word(tos.ram);
         }
         continue;
 #else
         /* Fall through, since the other architectures use shared
          * instruction and data space. */
 #endif
-
         /* -------------------------------------------------------------
-        ***{:token :charlit
-        *** :flags #{:headerless}}
+        ***{:token :fetch
+        *** :name "@"}
          */
-        CHARLIT:
+        FETCH:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.i = *ip++;
+            CHECK_STACK(1, 1);
+            tos = *(EnforthCell*)tos.ram;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :exit}
+         * > [CORE] 6.1.0540 "greater-than" ( n1 n2 -- flag )
+         *
+         * flag is true if and only if n1 is greater than n2.
+         *
+        ***{:token :greaterthan
+        *** :name ">"}
          */
-        EXIT:
+        GREATERTHAN:
         {
-#if ENABLE_TRACING
-            int i;
-            for (i = 0; i < gTraceLevel; i++)
-            {
-                printf("<");
-            }
-
-            printf(" (");
-            for (i = 0; i < &vm->data_stack[32] - restDataStack - 1; i++)
-            {
-                printf("%x ", vm->data_stack[30 - i].u);
-            }
-
-            if ((&vm->data_stack[32] - restDataStack) > 0)
-            {
-                printf("%x", tos.u);
-            }
-            printf(")");
-
-            printf(" (R:");
-            for (i = 0; i < &vm->return_stack[32] - returnTop; i++)
-            {
-                printf(" %x", vm->return_stack[31 - i].u);
-            }
-            printf(")");
-
-            printf("\n");
-
-            gTraceLevel--;
-#endif
-
-            ip = (uint8_t *)((returnTop++)->ram);
-
-#ifdef __AVR__
-            if (((unsigned int)ip & 0x8000) != 0)
-            {
-                /* This return address points at a ROM definition; strip
-                 * off that flag as part of popping the address. */
-                ip = (uint8_t*)((unsigned int)ip & 0x7FFF);
-                inProgramSpace = -1;
-            }
-            else
-            {
-                inProgramSpace = 0;
-            }
-#endif
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->i > tos.i ? -1 : 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :lit
-        *** :name "(LIT)"
-        *** :args [[] [:x]]
-        *** :flags #{:headerless}}
+        ***{:token :invert}
          */
-        /* Cannot be used in ROM definitions! */
-        LIT:
+        INVERT:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos = *(EnforthCell*)ip;
-            ip += kEnforthCellSize;
+            CHECK_STACK(1, 1);
+            tos.i = ~tos.i;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * PAUSE [Enforth] ( -- )
-         *
-         * Suspend the current task and resume execution of the next
-         * task in the task list.  PAUSE will return to the caller when
-         * all of the tasks in the task list have had a chance to
-         * execute (and called PAUSE in order to relinquish execution to
-         * their next task).
-         *
-        ***{:token :pause}
-         */
-        PAUSE:
-        {
-            /* Push TOS onto the stack. */
-            *--restDataStack = tos;
-
-            /* Push RSP and IP to the stack. */
-            /* TODO Both of these need to be relative addresses. */
-            (--restDataStack)->ram = (uint8_t*)returnTop;
-
-#ifdef __AVR__
-            if (inProgramSpace)
-            {
-                /* Set the high bit on the current IP so that we know
-                 * that this address is in ROM. */
-                ip = (uint8_t*)((unsigned int)ip | 0x8000);
-            }
-#endif
-
-            (--restDataStack)->ram = ip;
-
-            /* Save the stack pointer. */
-            ((EnforthCell*)vm->cur_task.ram)[1].ram = (uint8_t*)restDataStack;
-
-            /* Make the previous task the current task. */
-            vm->cur_task.ram = ((EnforthCell*)vm->cur_task.ram)[0].ram;
-
-            /* Did we hit the beginning of the list?  If so, wrap around
-             * to the last task. */
-            if (vm->cur_task.ram == 0)
-            {
-                vm->cur_task.ram = ((EnforthCell*)vm->dictionary.ram)[2].ram;
-            }
-
-            /* Unpause the interpreter. */
-            goto UNPAUSE;
-        }
-
-        /* -------------------------------------------------------------
-         * (HALT) [Enforth] ( i*x -- i*x ) ( R: j*x -- j*x )
-         *
-         * Stops and exits the VM.  State is preserved on the stack,
-         * allowing the VM to be resumed by enforth_resume.
-         *
-        ***{:token :phalt
-        *** :name "(HALT)"
-        *** :args [[] []]
-        *** :flags #{:headerless}}
+        ***{:token :j
+        *** :args [[] [:n]]}
          */
-        PHALT:
+        J:
         {
-            /* Push TOS onto the stack. */
+            CHECK_STACK(0, 1);
             *--restDataStack = tos;
-
-            /* Push RSP and IP to the stack. */
-            /* TODO Both of these need to be relative addresses. */
-            (--restDataStack)->ram = (uint8_t*)returnTop;
-            (--restDataStack)->ram = ip;
-
-            /* Save the stack pointer. */
-            ((EnforthCell*)vm->cur_task.ram)[1].ram = (uint8_t*)restDataStack;
-
-            /* Exit the interpreter. */
-            return;
+            tos = returnTop[2];
         }
+        continue;
 
         /* -------------------------------------------------------------
-        ***{:token :izbranch
-        *** :flags #{:headerless}}
+        ***{:token :lessthan
+        *** :name "<"}
          */
-        IZBRANCH:
-#ifdef __AVR__
+        LESSTHAN:
         {
-            CHECK_STACK(1, 0);
-
-            if (tos.i == 0)
-            {
-                ip += (int8_t)pgm_read_byte(ip);
-            }
-            else
-            {
-                ip++;
-            }
-
-            tos = *restDataStack++;
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->i < tos.i ? -1 : 0;
         }
         continue;
-#else
-        /* Fall through, since the other architectures use shared
-         * instruction and data space. */
-#endif
 
         /* -------------------------------------------------------------
-        ***{:token :zbranch
-        *** :name "0BRANCH"
-        *** :flags #{:headerless}}
+        ***{:token :lshift
+        *** :args [[:x1 :u] [:x2]]}
          */
-        ZBRANCH:
+        LSHIFT:
         {
-            CHECK_STACK(1, 0);
-
-            if (tos.i == 0)
-            {
-                ip += *(int8_t*)ip;
-            }
-            else
-            {
-                ip++;
-            }
-
-            tos = *restDataStack++;
+            CHECK_STACK(2, 1);
+            tos.u = restDataStack++->u << tos.u;
         }
         continue;
 
-
-
-        /* =============================================================
-         * CORE PRIMITIVES
-         */
-
         /* -------------------------------------------------------------
-         * ABORT [CORE] 6.1.0670 ( i*x -- ) ( R: j*x -- )
-         *
-         * Empty the data stack and perform the function of QUIT, which
-         * includes emptying the return stack, without displaying a
-         * message.
-         *
-        ***{:token :abort}
+        ***{:token :max
+        *** :args [[:n1 :n2] [:n3]]}
          */
-        ABORT:
+        MAX:
         {
-            tos.i = 0;
-            restDataStack = (EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop);
-            ((EnforthCell*)vm->cur_task.ram)[2].u = 10; /* User: BASE */
-
-            /* Set the IP to the beginning of QUIT */
-#ifdef __AVR__
-            ip = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_QUIT&0x3FFF) + kNFAtoPFA));
-#else
-            ip = (uint8_t*)definitions + (ROMDEF_QUIT&0x3FFF) + kNFAtoPFA;
-#endif
+            CHECK_STACK(2, 1);
+            tos.i = tos.i > restDataStack->i ? tos.i : restDataStack->i;
+            ++restDataStack;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :abs}
+        ***{:token :min
+        *** :args [[:n1 :n2] [:n3]]}
          */
-        ABS:
+        MIN:
         {
-            CHECK_STACK(1, 1);
-            tos.u = abs(tos.i);
+            CHECK_STACK(2, 1);
+            tos.i = tos.i < restDataStack->i ? tos.i : restDataStack->i;
+            ++restDataStack;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :and}
+        ***{:token :minus
+        *** :name "-"}
          */
-        AND:
+        MINUS:
         {
             CHECK_STACK(2, 1);
-            tos.i &= restDataStack++->i;
+            tos.i = restDataStack++->i - tos.i;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :base}
+        ***{:token :move}
          */
-        BASE:
+        MOVE:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.ram = (uint8_t*)&((EnforthCell*)vm->cur_task.ram)[2];
+            CHECK_STACK(3, 0);
+            EnforthCell arg3 = tos;
+            EnforthCell arg2 = *restDataStack++;
+            EnforthCell arg1 = *restDataStack++;
+            mark_dirty(vm, arg2.ram, arg3.u);
+            memcpy(arg2.ram, arg1.ram, arg3.u);
+            tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :icfetch
-        *** :name "IC@"
-        *** :args [[:c-addr] [:c]]
-        *** :flags #{:headerless}}
+        ***{:token :negate}
          */
-        ICFETCH:
-#ifdef __AVR__
+        NEGATE:
         {
             CHECK_STACK(1, 1);
-            tos.u = pgm_read_byte(tos.ram);
+            tos.i = -tos.i;
         }
         continue;
-#else
-        /* Fall through, since the other architectures use shared
-         * instruction and data space. */
-#endif
+
         /* -------------------------------------------------------------
-        ***{:token :cfetch
-        *** :name "C@"}
+        ***{:token :oneminus
+        *** :name "1-"}
          */
-        CFETCH:
+        ONEMINUS:
         {
             CHECK_STACK(1, 1);
-            tos.u = *(uint8_t*)tos.ram;
+            tos.i--;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * C! [CORE] 6.1.0850 "c-store" ( char c-addr -- )
-         *
-         * Store char at c-addr.  When character size is smaller than
-         * cell size, only the number of low-order bits corresponding to
-         * character size are transferred.
-         *
-        ***{:token :cstore
-        *** :name "C!"}
+        ***{:token :oneplus
+        *** :name "1+"}
          */
-        CSTORE:
+        ONEPLUS:
         {
-            CHECK_STACK(2, 0);
-            *(uint8_t*)tos.ram = restDataStack++->u;
-            tos = *restDataStack++;
+            CHECK_STACK(1, 1);
+            tos.i++;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * DEPTH [CORE] 6.1.1200 ( -- +n )
-         *
-         * +n is the number of single-cell values contained in the data
-         * stack before +n was placed on the stack.
-         *
-        ***{:token :depth}
+        ***{:token :or}
          */
-        DEPTH:
+        OR:
         {
-            CHECK_STACK(0, 1);
+            CHECK_STACK(2, 1);
+            tos.i |= restDataStack++->i;
+        }
+        continue;
 
-            /* Save TOS, then calculate the stack depth.  The return
-             * value should be the number of items on the stack *before*
-             * DEPTH was called and so we have to subtract one from the
-             * count given that we calculate the depth *after* pushing
-             * the old TOS onto the stack. */
+        /* -------------------------------------------------------------
+        ***{:token :over}
+         */
+        OVER:
+        {
+            CHECK_STACK(2, 3);
+            EnforthCell second = restDataStack[0];
             *--restDataStack = tos;
-            tos.i = (EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop) - restDataStack - 1;
+            tos = second;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :drop
-        *** :args [[:x1 :x2] [:x1]]}
+         * (DO) [Enforth] "paren-do-paren" ( n1|u1 n2|u2 -- ) ( R: -- loop-sys )
+         *
+         * Set up loop control parameters with index n2|u2 and limit
+         * n1|u1. An ambiguous condition exists if n1|u1 and n2|u2 are
+         * not both the same type.  Anything already on the return stack
+         * becomes unavailable until the loop-control parameters are
+         * discarded.
+         *
+        ***{:token :pdo
+        *** :name "(DO)"
+        *** :args [[:n1 :n2] []]
+        *** :flags #{:headerless}}
          */
-        DROP:
+        PDO:
+
+        /* -------------------------------------------------------------
+        ***{:token :twotor
+        *** :name "2>R"}
+         */
+        TWOTOR:
         {
-            CHECK_STACK(1, 0);
+            CHECK_STACK(2, 0);
+            *--returnTop = *restDataStack++;
+            *--returnTop = tos;
             tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :dup
-        *** :args [[:x] [:x :x]]}
+        ***{:token :piloop
+        *** :name "(ILOOP)"
+        *** :flags #{:headerless}}
          */
-        DUP:
+        /* TODO We could remove this if we refactor DUMP, but I feel
+         * like it could be useful for other definitions later on. */
+        PILOOP:
+#ifdef __AVR__
         {
-            CHECK_STACK(1, 2);
-            *--restDataStack = tos;
+            ++(returnTop[0]).i;
+            if (returnTop[0].i == returnTop[1].i)
+            {
+                ++returnTop;
+                ++returnTop;
+                ++ip;
+            }
+            else
+            {
+                ip += (int8_t)pgm_read_byte(ip);
+                CHECK_TIME_SLICE();
+            }
+        }
+        continue;
+#else
+        /* Fall through, since the other architectures use shared
+         * instruction and data space. */
+#endif
+
+        /* (LOOP) [Enforth] "paren-loop-paren" ( -- ) ( R: loop-sys1 -- | loop-sys2 )
+         *
+         * An ambiguous condition exists if the loop control parameters
+         * are unavailable.  Add one to the loop index.  If the loop
+         * index is then equal to the loop limit, discard the loop
+         * parameters and continue execution immediately following the
+         * loop.  Otherwise continue execution at the beginning of the
+         * loop.
+         *
+        ***{:token :ploop
+        *** :name "(LOOP)"
+        *** :flags #{:headerless}}
+         */
+        PLOOP:
+        {
+            ++(returnTop[0]).i;
+            if (returnTop[0].i == returnTop[1].i)
+            {
+                ++returnTop;
+                ++returnTop;
+                ++ip;
+            }
+            else
+            {
+                ip += *(int8_t*)ip;
+                CHECK_TIME_SLICE();
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :emit}
+        ***{:token :pplusloop
+        *** :name "(+LOOP)"
+        *** :flags #{:headerless}}
          */
-        EMIT:
+        PPLUSLOOP:
         {
             CHECK_STACK(1, 0);
 
-            if (vm->emit != NULL)
+            returnTop[0].i += tos.i;
+
+            if (((tos.i >= 0) && (returnTop[0].i >= returnTop[1].i))
+                    || ((tos.i < 0) && (returnTop[0].i < returnTop[1].i)))
+            {
+                ++returnTop;
+                ++returnTop;
+                ++ip;
+            }
+            else
             {
-                vm->emit(tos.i);
+                ip += *(int8_t*)ip;
+                tos = *restDataStack++;
+                CHECK_TIME_SLICE();
+                continue;
             }
 
             tos = *restDataStack++;
@@ -1205,1015 +2748,1455 @@ DISPATCH_TOKEN:
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :equals
-        *** :name "="}
+        ***{:token :plus
+        *** :name "+"}
          */
-        EQUALS:
+        PLUS:
         {
             CHECK_STACK(2, 1);
-            tos.i = restDataStack++->i == tos.i ? -1 : 0;
+            tos.i += restDataStack++->i;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * EXECUTE [CORE] 6.1.1370 ( i*x xt -- j*x )
-         *
-         * Remove xt from the stack and perform the semantics identified
-         * by it.  Other stack effects are due to the word EXECUTEd.
-         *
-        ***{:token :execute
-        *** :args [[:xt] []]}
+        ***{:token :plusstore
+        *** :name "+!"}
+         */
+        PLUSSTORE:
+        {
+            CHECK_STACK(2, 0);
+            mark_dirty(vm, tos.ram, kEnforthCellSize);
+            ((EnforthCell*)tos.ram)->i += restDataStack++->i;
+            tos = *restDataStack++;
+        }
+        continue;
+
+        /* -------------------------------------------------------------
+        ***{:token :pqdo
+        *** :name "(?DO)"
+        *** :flags #{:headerless}}
          */
-        EXECUTE:
+        PQDO:
         {
-            xt = tos.u;
+            CHECK_STACK(2, 0);
+            EnforthCell limit = *restDataStack++;
+            EnforthCell index = tos;
             tos = *restDataStack++;
-            goto DISPATCH_XT;
+
+            if (index.u == limit.u)
+            {
+                ip += *(int8_t*)ip;
+            }
+            else
+            {
+                *--returnTop = limit;
+                *--returnTop = index;
+                ++ip;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :ifetch
-        *** :name "I@"
-        *** :args [[:addr] [:x]]
+        ***{:token :pisquote
+        *** :name "(IS\")"
+        *** :args [[] [:icaddr :u]]
         *** :flags #{:headerless}}
          */
-        IFETCH:
+        /* TODO Should probably just remove this since it is only used
+         * in COLD... */
+        PISQUOTE:
 #ifdef __AVR__
         {
-            CHECK_STACK(1, 1);
-            tos.u = pgm_read_word(tos.ram);
+            CHECK_STACK(0, 2);
+
+            /* Push existing TOS onto the stack. */
+            *--restDataStack = tos;
+
+            /* Instruction stream contains the length of the string as a
+             * byte and then the string itself.  Start out by getting
+             * the length into TOS. */
+            tos.u = pgm_read_byte(ip);
+            ip++;
+
+            /* Now push the address of the string (the newly-incremented
+             * IP) onto the stack. */
+            (--restDataStack)->ram = ip;
+
+            /* Advance IP over the string. */
+            ip = ip + tos.u;
         }
         continue;
 #else
         /* Fall through, since the other architectures use shared
          * instruction and data space. */
 #endif
-        /* -------------------------------------------------------------
-        ***{:token :fetch
-        *** :name "@"}
-         */
-        FETCH:
-        {
-            CHECK_STACK(1, 1);
-            tos = *(EnforthCell*)tos.ram;
-        }
-        continue;
 
         /* -------------------------------------------------------------
-         * > [CORE] 6.1.0540 "greater-than" ( n1 n2 -- flag )
+         * (s") [ENFORTH] "paren-s-quote-paren" ( -- c-addr u )
          *
-         * flag is true if and only if n1 is greater than n2.
+         * Runtime behavior of S": return c-addr and u.
+         * NOTE: Cannot be used in program space!
          *
-        ***{:token :greaterthan
-        *** :name ">"}
+        ***{:token :psquote
+        *** :name "(S\")"
+        *** :flags #{:headerless}}
          */
-        GREATERTHAN:
+        PSQUOTE:
         {
-            CHECK_STACK(2, 1);
-            tos.i = restDataStack++->i > tos.i ? -1 : 0;
-        }
-        continue;
+            CHECK_STACK(0, 2);
 
-        /* -------------------------------------------------------------
-        ***{:token :invert}
-         */
-        INVERT:
-        {
-            CHECK_STACK(1, 1);
-            tos.i = ~tos.i;
+            /* Push existing TOS onto the stack. */
+            *--restDataStack = tos;
+
+            /* Instruction stream contains the length of the string as a
+             * byte and then the string itself.  Start out by pushing
+             * the address of the string (ip+1) onto the stack. */
+            (--restDataStack)->ram = ip + 1;
+
+            /* Now get the string length into TOS. */
+            tos.i = *ip++;
+
+            /* Advance IP over the string. */
+            ip = ip + tos.i;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :j
-        *** :args [[] [:n]]}
+        ***{:token :qdup
+        *** :name "?DUP"}
          */
-        J:
+        QDUP:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos = returnTop[2];
+            CHECK_STACK(1, 2);
+
+            if (tos.i != 0)
+            {
+                *--restDataStack = tos;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :lessthan
-        *** :name "<"}
+        ***{:token :i
+        *** :args [[] [:n]]}
          */
-        LESSTHAN:
-        {
-            CHECK_STACK(2, 1);
-            tos.i = restDataStack++->i < tos.i ? -1 : 0;
-        }
-        continue;
+        I:
 
         /* -------------------------------------------------------------
-        ***{:token :lshift
-        *** :args [[:x1 :u] [:x2]]}
+        ***{:token :rfetch
+        *** :name "R@"}
          */
-        LSHIFT:
+        RFETCH:
         {
-            CHECK_STACK(2, 1);
-            tos.u = restDataStack++->u << tos.u;
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos = returnTop[0];
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :max
-        *** :args [[:n1 :n2] [:n3]]}
+        ***{:token :rfrom
+        *** :name "R>"}
          */
-        MAX:
+        RFROM:
         {
-            CHECK_STACK(2, 1);
-            tos.i = tos.i > restDataStack->i ? tos.i : restDataStack->i;
-            ++restDataStack;
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos = *returnTop++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :min
-        *** :args [[:n1 :n2] [:n3]]}
+         * ROT [CORE] 6.1.2160 "rote" ( x1 x2 x3 -- x2 x3 x1 )
+         *
+         * Rotate the top three stack entries.
+         *
+        ***{:token :rot}
          */
-        MIN:
+        ROT:
         {
-            CHECK_STACK(2, 1);
-            tos.i = tos.i < restDataStack->i ? tos.i : restDataStack->i;
-            ++restDataStack;
+            CHECK_STACK(3, 3);
+            EnforthCell x3 = tos;
+            EnforthCell x2 = *restDataStack++;
+            EnforthCell x1 = *restDataStack++;
+            *--restDataStack = x2;
+            *--restDataStack = x3;
+            tos = x1;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :minus
-        *** :name "-"}
+        ***{:token :rshift
+        *** :args [[:x1 :u] [:x2]]}
          */
-        MINUS:
+        RSHIFT:
         {
             CHECK_STACK(2, 1);
-            tos.i = restDataStack++->i - tos.i;
+            tos.u = restDataStack++->u >> tos.u;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :move}
+         * ! [CORE] 6.1.0010 "store" ( x a-addr -- )
+         *
+         * Store x at a-addr.
+         *
+        ***{:token :store
+        *** :name "!"}
          */
-        MOVE:
+        STORE:
         {
-            CHECK_STACK(3, 0);
-            EnforthCell arg3 = tos;
-            EnforthCell arg2 = *restDataStack++;
-            EnforthCell arg1 = *restDataStack++;
-            memcpy(arg2.ram, arg1.ram, arg3.u);
+            CHECK_STACK(2, 0);
+            mark_dirty(vm, tos.ram, kEnforthCellSize);
+            *(EnforthCell*)tos.ram = *restDataStack++;
             tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :negate}
+        ***{:token :swap}
          */
-        NEGATE:
+        SWAP:
         {
-            CHECK_STACK(1, 1);
-            tos.i = -tos.i;
+            CHECK_STACK(2, 2);
+            EnforthCell swap = restDataStack[0];
+            restDataStack[0] = tos;
+            tos = swap;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :oneminus
-        *** :name "1-"}
+         * >NUMBER [CORE] 6.1.0567 "to-number" ( ud1 c-addr1 u1 -- ud2 c-addr2 u2 )
+         *
+         * ud2 is the unsigned result of converting the characters
+         * within the string specified by c-addr1 u1 into digits, using
+         * the number in BASE, and adding each into ud1 after
+         * multiplying ud1 by the number in BASE.  Conversion continues
+         * left-to-right until a character that is not convertible,
+         * including any "+" or "-", is encountered or the string is
+         * entirely converted.  c-addr2 is the location of the first
+         * unconverted character or the first character past the end of
+         * the string if the string was entirely converted.  u2 is the
+         * number of unconverted characters in the string.  An ambiguous
+         * condition exists if ud2 overflows during the conversion.
+         *
+        ***{:token :tonumber
+        *** :name ">NUMBER"
+        *** :args [[:ud1 :caddr1 :u1] [:ud2 :caddr2 :u2]]}
          */
-        ONEMINUS:
+        TONUMBER:
         {
-            CHECK_STACK(1, 1);
-            tos.i--;
+            CHECK_STACK(4, 4);
+            uint8_t * const end = restDataStack[0].ram + tos.u;
+            EnforthDoubleUnsigned ud
+                = ((EnforthDoubleUnsigned)restDataStack[1].u << kEnforthCellBits)
+                    | restDataStack[2].u;
+
+            restDataStack[0].ram = convert_digits(
+                    &ud,
+                    restDataStack[0].ram, end,
+                    ((EnforthCell*)vm->cur_task.ram)[2].u /* User: BASE */);
+            tos.u = end - restDataStack[0].ram;
+
+            restDataStack[1].u = (EnforthUnsigned)(ud >> kEnforthCellBits);
+            restDataStack[2].u = (EnforthUnsigned)ud;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :oneplus
-        *** :name "1+"}
+        ***{:token :tor
+        *** :name ">R"}
          */
-        ONEPLUS:
+        TOR:
         {
-            CHECK_STACK(1, 1);
-            tos.i++;
+            CHECK_STACK(1, 0);
+            *--returnTop = tos;
+            tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :or}
+        ***{:token :twodrop
+        *** :name "2DROP"}
          */
-        OR:
+        TWODROP:
         {
-            CHECK_STACK(2, 1);
-            tos.i |= restDataStack++->i;
+            CHECK_STACK(2, 0);
+            restDataStack++;
+            tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :over}
+        ***{:token :twodup
+        *** :name "2DUP"}
          */
-        OVER:
+        TWODUP:
         {
-            CHECK_STACK(2, 3);
-            EnforthCell second = restDataStack[0];
+            CHECK_STACK(2, 4);
+            EnforthCell second = *restDataStack;
             *--restDataStack = tos;
-            tos = second;
+            *--restDataStack = second;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * (DO) [Enforth] "paren-do-paren" ( n1|u1 n2|u2 -- ) ( R: -- loop-sys )
-         *
-         * Set up loop control parameters with index n2|u2 and limit
-         * n1|u1. An ambiguous condition exists if n1|u1 and n2|u2 are
-         * not both the same type.  Anything already on the return stack
-         * becomes unavailable until the loop-control parameters are
-         * discarded.
-         *
-        ***{:token :pdo
-        *** :name "(DO)"
-        *** :args [[:n1 :n2] []]
-        *** :flags #{:headerless}}
+        ***{:token :twofetch
+        *** :name "2@"}
          */
-        PDO:
+        TWOFETCH:
+        {
+            CHECK_STACK(1, 2);
+            *--restDataStack = *(EnforthCell*)(tos.ram + kEnforthCellSize);
+            tos = *(EnforthCell*)tos.ram;
+        }
+        continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twotor
-        *** :name "2>R"}
+        ***{:token :twoover
+        *** :name "2OVER"}
          */
-        TWOTOR:
+        TWOOVER:
         {
-            CHECK_STACK(2, 0);
-            *--returnTop = *restDataStack++;
-            *--returnTop = tos;
-            tos = *restDataStack++;
+            CHECK_STACK(4, 6);
+            *--restDataStack = tos;
+            EnforthCell x2 = restDataStack[2];
+            EnforthCell x1 = restDataStack[3];
+            *--restDataStack = x1;
+            tos = x2;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :piloop
-        *** :name "(ILOOP)"
-        *** :flags #{:headerless}}
+        ***{:token :twoslash
+        *** :name "2/"
+        *** :args [[:x1] [:x2]]}
          */
-        /* TODO We could remove this if we refactor DUMP, but I feel
-         * like it could be useful for other definitions later on. */
-        PILOOP:
-#ifdef __AVR__
+        TWOSLASH:
         {
-            ++(returnTop[0]).i;
-            if (returnTop[0].i == returnTop[1].i)
-            {
-                ++returnTop;
-                ++returnTop;
-                ++ip;
-            }
-            else
-            {
-                ip += (int8_t)pgm_read_byte(ip);
-            }
+            CHECK_STACK(1, 1);
+            tos.i = tos.i >> 1;
         }
         continue;
-#else
-        /* Fall through, since the other architectures use shared
-         * instruction and data space. */
-#endif
 
-        /* (LOOP) [Enforth] "paren-loop-paren" ( -- ) ( R: loop-sys1 -- | loop-sys2 )
-         *
-         * An ambiguous condition exists if the loop control parameters
-         * are unavailable.  Add one to the loop index.  If the loop
-         * index is then equal to the loop limit, discard the loop
-         * parameters and continue execution immediately following the
-         * loop.  Otherwise continue execution at the beginning of the
-         * loop.
-         *
-        ***{:token :ploop
-        *** :name "(LOOP)"
-        *** :flags #{:headerless}}
+        /* -------------------------------------------------------------
+        ***{:token :twostar
+        *** :name "2*"
+        *** :args [[:x1] [:x2]]}
          */
-        PLOOP:
+        TWOSTAR:
         {
-            ++(returnTop[0]).i;
-            if (returnTop[0].i == returnTop[1].i)
-            {
-                ++returnTop;
-                ++returnTop;
-                ++ip;
-            }
-            else
-            {
-                ip += *(int8_t*)ip;
-            }
+            CHECK_STACK(1, 1);
+            tos.u = tos.u << 1;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :pplusloop
-        *** :name "(+LOOP)"
-        *** :flags #{:headerless}}
+        ***{:token :twostore
+        *** :name "2!"}
          */
-        PPLUSLOOP:
+        TWOSTORE:
         {
-            CHECK_STACK(1, 0);
-
-            returnTop[0].i += tos.i;
-
-            if (((tos.i >= 0) && (returnTop[0].i >= returnTop[1].i))
-                    || ((tos.i < 0) && (returnTop[0].i < returnTop[1].i)))
-            {
-                ++returnTop;
-                ++returnTop;
-                ++ip;
-            }
-            else
-            {
-                ip += *(int8_t*)ip;
-            }
-
+            CHECK_STACK(3, 0);
+            EnforthCell * addr = (EnforthCell*)tos.ram;
+            mark_dirty(vm, tos.ram, kEnforthCellSize * 2);
+            *addr++ = *restDataStack++;
+            *addr = *restDataStack++;
             tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :plus
-        *** :name "+"}
+        ***{:token :twoswap
+        *** :name "2SWAP"}
          */
-        PLUS:
+        TWOSWAP:
         {
-            CHECK_STACK(2, 1);
-            tos.i += restDataStack++->i;
+            CHECK_STACK(4, 4);
+            EnforthCell x4 = tos;
+            EnforthCell x3 = restDataStack[0];
+            EnforthCell x2 = restDataStack[1];
+            EnforthCell x1 = restDataStack[2];
+
+            tos = x2;
+            restDataStack[0] = x1;
+            restDataStack[1] = x4;
+            restDataStack[2] = x3;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :plusstore
-        *** :name "+!"}
+         * TYPE [CORE] 6.1.2310 ( c-addr u -- )
+         *
+         * If u is greater than zero, display the character string
+         * specified by c-addr and u.
+         *
+        ***{:token :type
+        *** :args [[:caddr :u] []]}
          */
-        PLUSSTORE:
+        TYPE:
         {
             CHECK_STACK(2, 0);
-            ((EnforthCell*)tos.ram)->i += restDataStack++->i;
+            type_chars(vm, (const char *)restDataStack++->ram, tos.u);
             tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :pqdo
-        *** :name "(?DO)"
-        *** :flags #{:headerless}}
+        ***{:token :ulessthan
+        *** :name "U<"}
          */
-        PQDO:
+        ULESSTHAN:
         {
-            CHECK_STACK(2, 0);
-            EnforthCell limit = *restDataStack++;
-            EnforthCell index = tos;
-            tos = *restDataStack++;
-
-            if (index.u == limit.u)
-            {
-                ip += *(int8_t*)ip;
-            }
-            else
-            {
-                *--returnTop = limit;
-                *--returnTop = index;
-                ++ip;
-            }
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->u < tos.u ? -1 : 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :pisquote
-        *** :name "(IS\")"
-        *** :args [[] [:icaddr :u]]
-        *** :flags #{:headerless}}
+         * UM/MOD [CORE] 6.1.2370 "u-m-slash-mod" ( ud u1 -- u2 u3 )
+         *
+         * Divide ud by u1, giving the quotient u3 and the remainder u2.
+         * All values and arithmetic are unsigned.  An ambiguous
+         * condition exists if u1 is zero or if the quotient lies
+         * outside the range of a single-cell unsigned integer.
+         *
+        ***{:token :umslashmod
+        *** :name "UM/MOD"
+        *** :args [[:ud :u1] [:u2 :u3]]}
          */
-        /* TODO Should probably just remove this since it is only used
-         * in COLD... */
-        PISQUOTE:
-#ifdef __AVR__
+        UMSLASHMOD:
         {
-            CHECK_STACK(0, 2);
-
-            /* Push existing TOS onto the stack. */
-            *--restDataStack = tos;
-
-            /* Instruction stream contains the length of the string as a
-             * byte and then the string itself.  Start out by getting
-             * the length into TOS. */
-            tos.u = pgm_read_byte(ip);
-            ip++;
+            CHECK_STACK(3, 2);
+#ifdef __AVR__
+            uint16_t u1 = tos.u;
+            uint16_t ud_msb = restDataStack++->u;
+            uint16_t ud_lsb = restDataStack++->u;
+            uint32_t ud = ((uint32_t)ud_msb << 16) | ud_lsb;
 
-            /* Now push the address of the string (the newly-incremented
-             * IP) onto the stack. */
-            (--restDataStack)->ram = ip;
+            // FIXME Doesn't work on Arduino; maybe a compiler
+            // difference?  Meanwhile, ldiv seems to work in the vast
+            // majority of cases; only extreme situations ((65535 *
+            // 65535) / 65535) return the incorrect results.
+            //
+            // (--restDataStack)->u = ud % u1;
+            // tos.u = ud / u1;
 
-            /* Advance IP over the string. */
-            ip = ip + tos.u;
-        }
-        continue;
+            ldiv_t result = ldiv(ud, u1);
+            (--restDataStack)->u = result.rem;
+            tos.u = result.quot;
 #else
-        /* Fall through, since the other architectures use shared
-         * instruction and data space. */
+            EnforthUnsigned u1 = tos.u;
+            EnforthUnsigned ud_msb = restDataStack++->u;
+            EnforthUnsigned ud_lsb = restDataStack++->u;
+            EnforthDoubleUnsigned ud
+                = ((EnforthDoubleUnsigned)ud_msb << kEnforthCellBits) | ud_lsb;
+            (--restDataStack)->u = ud % u1;
+            tos.u = ud / u1;
 #endif
+        }
+        continue;
 
         /* -------------------------------------------------------------
-         * (s") [ENFORTH] "paren-s-quote-paren" ( -- c-addr u )
+         * UM* [CORE] 6.1.2360 "u-m-star" ( u1 u2 -- ud )
          *
-         * Runtime behavior of S": return c-addr and u.
-         * NOTE: Cannot be used in program space!
+         * Multiply u1 by u2, giving the unsigned double-cell product
+         * ud.  All values and arithmetic are unsigned
          *
-        ***{:token :psquote
-        *** :name "(S\")"
-        *** :flags #{:headerless}}
+        ***{:token :umstar
+        *** :name "UM*"}
          */
-        PSQUOTE:
+        UMSTAR:
         {
-            CHECK_STACK(0, 2);
-
-            /* Push existing TOS onto the stack. */
-            *--restDataStack = tos;
-
-            /* Instruction stream contains the length of the string as a
-             * byte and then the string itself.  Start out by pushing
-             * the address of the string (ip+1) onto the stack. */
-            (--restDataStack)->ram = ip + 1;
+            CHECK_STACK(2, 2);
+#ifdef __AVR__
+            uint32_t result = (uint32_t)tos.u * (uint32_t)restDataStack[0].u;
+            restDataStack[0].u = (uint16_t)result;
+            tos.u = (uint16_t)(result >> 16);
+#else
+            EnforthDoubleUnsigned result
+                = (EnforthDoubleUnsigned)tos.u * restDataStack[0].u;
+            restDataStack[0].u = (EnforthUnsigned)result;
+            tos.u = (EnforthUnsigned)(result >> kEnforthCellBits);
+#endif
+        }
+        continue;
 
-            /* Now get the string length into TOS. */
-            tos.i = *ip++;
+        /* -------------------------------------------------------------
+        ***{:token :unloop}
+         */
+        UNLOOP:
+        {
+            CHECK_STACK(0, 0);
+            returnTop++;
+            returnTop++;
+        }
+        continue;
 
-            /* Advance IP over the string. */
-            ip = ip + tos.i;
+        /* -------------------------------------------------------------
+        ***{:token :xor}
+         */
+        XOR:
+        {
+            CHECK_STACK(2, 1);
+            tos.i ^= restDataStack++->i;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :qdup
-        *** :name "?DUP"}
+        ***{:token :zeroequals
+        *** :name "0="}
          */
-        QDUP:
+        ZEROEQUALS:
         {
-            CHECK_STACK(1, 2);
-
-            if (tos.i != 0)
-            {
-                *--restDataStack = tos;
-            }
+            CHECK_STACK(1, 1);
+            tos.i = tos.i == 0 ? -1 : 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :i
-        *** :args [[] [:n]]}
+         * 0< [CORE] 6.1.0250 "zero-less" ( b -- flag )
+         *
+         * flag is true if and only if n is less than zero.
+         *
+        ***{:token :zeroless
+        *** :name "0<"}
+         */
+        ZEROLESS:
+        {
+            CHECK_STACK(1, 0);
+            tos.i = tos.i < 0 ? -1 : 0;
+        }
+        continue;
+
+
+
+        /* =============================================================
+         * CORE-EXT PRIMITIVES
          */
-        I:
 
         /* -------------------------------------------------------------
-        ***{:token :rfetch
-        *** :name "R@"}
+        ***{:token :nip}
          */
-        RFETCH:
+        NIP:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos = returnTop[0];
+            CHECK_STACK(2, 1);
+            restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :rfrom
-        *** :name "R>"}
+        ***{:token :notequals
+        *** :name "<>"}
          */
-        RFROM:
+        NOTEQUALS:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos = *returnTop++;
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->i != tos.i ? -1 : 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * ROT [CORE] 6.1.2160 "rote" ( x1 x2 x3 -- x2 x3 x1 )
+         * PARSE [CORE EXT] 6.2.2008 ( char "ccc<char>" -- c-addr u )
          *
-         * Rotate the top three stack entries.
+         * Parse ccc delimited by the delimiter char.
          *
-        ***{:token :rot}
+         * c-addr is the address (within the input buffer) and u is the
+         * length of the parsed string.  If the parse area was empty,
+         * the resulting string has a zero length.
+         *
+         * A space delimiter also matches all control characters.
+         *
+        ***{:token :parse
+        *** :args [[:c] [:caddr :u]]}
          */
-        ROT:
+        PARSE:
         {
-            CHECK_STACK(3, 3);
-            EnforthCell x3 = tos;
-            EnforthCell x2 = *restDataStack++;
-            EnforthCell x1 = *restDataStack++;
-            *--restDataStack = x2;
-            *--restDataStack = x3;
-            tos = x1;
+            CHECK_STACK(1, 2);
+
+            uint8_t * const sourceEnd = vm->source.ram + vm->source_len.u;
+            uint8_t * const parseStart
+                = (EnforthUnsigned)vm->to_in < vm->source_len.u
+                    ? vm->source.ram + vm->to_in
+                    : sourceEnd;
+            uint8_t * const parseEnd
+                = find_delimiter(parseStart, sourceEnd, (uint8_t)tos.u);
+
+            /* Advance >IN past the delimiter, unless we hit the end of
+             * the parse area without finding a delimiter. */
+            vm->to_in = parseEnd - vm->source.ram;
+            if (parseEnd != sourceEnd)
+            {
+                vm->to_in++;
+            }
+
+            (--restDataStack)->ram = parseStart;
+            tos.u = parseEnd - parseStart;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :rshift
-        *** :args [[:x1 :u] [:x2]]}
+        ***{:token :true}
          */
-        RSHIFT:
+        TRUE:
         {
-            CHECK_STACK(2, 1);
-            tos.u = restDataStack++->u >> tos.u;
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos.i = -1;
         }
         continue;
 
         /* -------------------------------------------------------------
-         * ! [CORE] 6.1.0010 "store" ( x a-addr -- )
-         *
-         * Store x at a-addr.
-         *
-        ***{:token :store
-        *** :name "!"}
+        ***{:token :tuck}
          */
-        STORE:
+        TUCK:
         {
-            CHECK_STACK(2, 0);
-            *(EnforthCell*)tos.ram = *restDataStack++;
-            tos = *restDataStack++;
+            EnforthCell second = *restDataStack;
+            *restDataStack = tos;
+            *--restDataStack = second;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :swap}
+        ***{:token :tworfetch
+        *** :name "2R@"}
          */
-        SWAP:
+        TWORFETCH:
         {
-            CHECK_STACK(2, 2);
-            EnforthCell swap = restDataStack[0];
-            restDataStack[0] = tos;
-            tos = swap;
+            CHECK_STACK(0, 2);
+            *--restDataStack = tos;
+            tos = returnTop[0];
+            *--restDataStack = returnTop[1];
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :tor
-        *** :name ">R"}
+        ***{:token :tworfrom
+        *** :name "2R>"}
          */
-        TOR:
+        TWORFROM:
         {
-            CHECK_STACK(1, 0);
-            *--returnTop = tos;
-            tos = *restDataStack++;
+            CHECK_STACK(0, 2);
+            *--restDataStack = tos;
+            tos = *returnTop++;
+            *--restDataStack = *returnTop++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twodrop
-        *** :name "2DROP"}
+        ***{:token :ugreaterthan
+        *** :name "U>"}
          */
-        TWODROP:
+        UGREATERTHAN:
         {
-            CHECK_STACK(2, 0);
-            restDataStack++;
-            tos = *restDataStack++;
+            CHECK_STACK(2, 1);
+            tos.i = restDataStack++->u > tos.u ? -1 : 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twodup
-        *** :name "2DUP"}
+        ***{:token :false}
          */
-        TWODUP:
+        FALSE:
+
+        /* -------------------------------------------------------------
+        ***{:token :zero
+        *** :name "0"}
+         */
+        ZERO:
         {
-            CHECK_STACK(2, 4);
-            EnforthCell second = *restDataStack;
+            CHECK_STACK(0, 1);
             *--restDataStack = tos;
-            *--restDataStack = second;
+            tos.i = 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twofetch
-        *** :name "2@"}
+        ***{:token :zeronotequals
+        *** :name "0<>"
+        *** :args [[:x] [:f]]}
          */
-        TWOFETCH:
+        ZERONOTEQUALS:
         {
-            CHECK_STACK(1, 2);
-            *--restDataStack = *(EnforthCell*)(tos.ram + kEnforthCellSize);
-            tos = *(EnforthCell*)tos.ram;
+            CHECK_STACK(1, 1);
+            tos.i = tos.i != 0 ? -1 : 0;
         }
         continue;
 
+
+
+        /* =============================================================
+         * DOUBLE PRIMITIVES
+         */
+
         /* -------------------------------------------------------------
-        ***{:token :twoover
-        *** :name "2OVER"}
+         * D.R [DOUBLE] 8.6.1.1070 "d-dot-r" ( d n -- )
+         *
+         * Display d right aligned in a field n characters wide.  If the
+         * number of characters required to display d is greater than n,
+         * all digits are displayed with no leading spaces in a field as
+         * wide as necessary.
+         *
+         * This is the native form of <# #S SIGN #> and builds the same
+         * string in the same HLD buffer above HERE, but converts the
+         * digits in C instead of with a UD/MOD per digit.
+         *
+        ***{:token :ddotr
+        *** :name "D.R"
+        *** :args [[:d :n] []]}
          */
-        TWOOVER:
+        DDOTR:
         {
-            CHECK_STACK(4, 6);
-            *--restDataStack = tos;
-            EnforthCell x2 = restDataStack[2];
-            EnforthCell x1 = restDataStack[3];
-            *--restDataStack = x1;
-            tos = x2;
+            CHECK_STACK(3, 0);
+            EnforthInt width = tos.i;
+            EnforthCell d_msb = *restDataStack++;
+            EnforthCell d_lsb = *restDataStack++;
+            EnforthDoubleUnsigned ud
+                = ((EnforthDoubleUnsigned)d_msb.u << kEnforthCellBits) | d_lsb.u;
+            EnforthUnsigned base = ((EnforthCell*)vm->cur_task.ram)[2].u;
+            uint8_t * const hld_end = hold_end(vm);
+
+            if (d_msb.i < 0)
+            {
+                ud = -ud;
+            }
+
+            vm->hld = hld_end;
+            do
+            {
+                uint8_t digit = ud % base;
+                ud /= base;
+                *--vm->hld = digit > 9 ? digit - 10 + 'A' : digit + '0';
+            } while (ud != 0);
+
+            if (d_msb.i < 0)
+            {
+                *--vm->hld = '-';
+            }
+
+            while (width-- > hld_end - vm->hld)
+            {
+                emit_char(vm, ' ');
+            }
+
+            type_chars(vm, (const char *)vm->hld, hld_end - vm->hld);
+            tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twoslash
-        *** :name "2/"
-        *** :args [[:x1] [:x2]]}
+         * M+ [DOUBLE] 8.6.1.1830 "m-plus" ( d1|ud1 n -- d2|ud2 )
+         *
+         * Add n to d1|ud1, giving the sum d2|ud2.
+         *
+        ***{:token :mplus
+        *** :name "M+"}
          */
-        TWOSLASH:
+        MPLUS:
         {
-            CHECK_STACK(1, 1);
-            tos.i = tos.i >> 1;
+            CHECK_STACK(3, 2);
+#ifdef __AVR__
+            uint16_t n = tos.u;
+            uint16_t d1_msb = restDataStack++->u;
+            uint16_t d1_lsb = restDataStack++->u;
+            uint32_t ud1 = ((uint32_t)d1_msb << 16) | d1_lsb;
+            uint32_t result = ud1 + n;
+            (--restDataStack)->u = (uint16_t)result;
+            tos.u = (uint16_t)(result >> 16);
+#else
+            EnforthUnsigned n = tos.u;
+            EnforthUnsigned d1_msb = restDataStack++->u;
+            EnforthUnsigned d1_lsb = restDataStack++->u;
+            EnforthDoubleUnsigned ud1
+                = ((EnforthDoubleUnsigned)d1_msb << kEnforthCellBits) | d1_lsb;
+            EnforthDoubleUnsigned result = ud1 + n;
+            (--restDataStack)->u = (EnforthUnsigned)result;
+            tos.u = (EnforthUnsigned)(result >> kEnforthCellBits);
+#endif
         }
         continue;
 
+
+
+        /* =============================================================
+         * FACILITY PRIMITIVES
+         */
+
         /* -------------------------------------------------------------
-        ***{:token :twostar
-        *** :name "2*"
-        *** :args [[:x1] [:x2]]}
+        ***{:token :keyq
+        *** :name "KEY?"}
          */
-        TWOSTAR:
+        KEYQ:
         {
-            CHECK_STACK(1, 1);
-            tos.u = tos.u << 1;
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            flush_output(vm);
+            tos.i = vm->keyq();
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twostore
-        *** :name "2!"}
+         * MS [FACILITY EXT] 10.6.2.1905 ( u -- )
+         *
+         * Wait at least u milliseconds.  The task sleeps while it
+         * waits, so the scheduler does not run it again until the wake
+         * time has arrived.  MS only pauses the task if the host does
+         * not provide a tick source.
+         *
+        ***{:token :ms
+        *** :args [[:u] []]}
+         */
+        MS:
+        {
+            CHECK_STACK(1, 0);
+            tos.u += current_ticks(vm);
+        }
+        goto SLEEPUNTIL;
+
+
+
+        /* =============================================================
+         * ENFORTH PRIMITIVES
+         */
+
+        /* -------------------------------------------------------------
+         * ATOMIC! [Enforth] "atomic-store" ( x a-addr -- )
+         *
+         * Store x at a-addr, such that a task running on another thread
+         * that reads x with ATOMIC@ (or CAS) also sees everything that
+         * this task stored before storing x.
+         *
+        ***{:token :atomicstore
+        *** :name "ATOMIC!"
+        *** :args [[:x :a-addr] []]}
          */
-        TWOSTORE:
+        ATOMICSTORE:
         {
-            CHECK_STACK(3, 0);
-            EnforthCell * addr = (EnforthCell*)tos.ram;
-            *addr++ = *restDataStack++;
-            *addr = *restDataStack++;
+            CHECK_STACK(2, 0);
+            mark_dirty(vm, tos.ram, kEnforthCellSize);
+            store_cell((EnforthCell*)tos.ram, restDataStack++->u);
             tos = *restDataStack++;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :twoswap
-        *** :name "2SWAP"}
+         * ATOMIC@ [Enforth] "atomic-fetch" ( a-addr -- x )
+         *
+         * x is the value stored at a-addr by this task or by a task
+         * running on another thread (see ATOMIC!).
+         *
+        ***{:token :atomicfetch
+        *** :name "ATOMIC@"
+        *** :args [[:a-addr] [:x]]}
          */
-        TWOSWAP:
+        ATOMICFETCH:
         {
-            CHECK_STACK(4, 4);
-            EnforthCell x4 = tos;
-            EnforthCell x3 = restDataStack[0];
-            EnforthCell x2 = restDataStack[1];
-            EnforthCell x1 = restDataStack[2];
-
-            tos = x2;
-            restDataStack[0] = x1;
-            restDataStack[1] = x4;
-            restDataStack[2] = x3;
+            CHECK_STACK(1, 1);
+            tos.u = load_cell((EnforthCell*)tos.ram);
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :ulessthan
-        *** :name "U<"}
+         * BLOCK-ON [Enforth] ( u -- )
+         *
+         * Block the current task until the host signals event u (see
+         * enforth_signal) and then switch to the next runnable task (as
+         * PAUSE does).  Events are numbered from zero to one less than
+         * the number of bits in a cell; a signal that arrives before
+         * the task blocks is not lost.  Other event numbers (such as
+         * -1) just pause the task.
+         *
+        ***{:token :blockon
+        *** :name "BLOCK-ON"
+        *** :args [[:u] []]}
          */
-        ULESSTHAN:
+        BLOCKON:
         {
-            CHECK_STACK(2, 1);
-            tos.i = restDataStack++->u < tos.u ? -1 : 0;
+            CHECK_STACK(1, 0);
+
+            if (tos.u < kEnforthCellBits)
+            {
+                ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor].u = (EnforthUnsigned)1 << tos.u;
+                store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateBlocked);
+            }
+
+            tos = *restDataStack++;
         }
-        continue;
+        goto PAUSE;
 
         /* -------------------------------------------------------------
-         * UM/MOD [CORE] 6.1.2370 "u-m-slash-mod" ( ud u1 -- u2 u3 )
+         * CAS [Enforth] "cas" ( x1 x2 a-addr -- flag )
          *
-         * Divide ud by u1, giving the quotient u3 and the remainder u2.
-         * All values and arithmetic are unsigned.  An ambiguous
-         * condition exists if u1 is zero or if the quotient lies
-         * outside the range of a single-cell unsigned integer.
+         * Atomically compare the value at a-addr with x1 and, if they
+         * are equal, store x2 at a-addr and return true.  Otherwise
+         * leave a-addr unchanged and return false.  CAS orders memory
+         * in the same way as ATOMIC@ and ATOMIC!, which makes it
+         * suitable for counters and locks that are shared by tasks
+         * running on different threads.
          *
-        ***{:token :umslashmod
-        *** :name "UM/MOD"
-        *** :args [[:ud :u1] [:u2 :u3]]}
+        ***{:token :cas
+        *** :name "CAS"
+        *** :args [[:x1 :x2 :a-addr] [:flag]]}
          */
-        UMSLASHMOD:
+        CAS:
         {
-            CHECK_STACK(3, 2);
-#ifdef __AVR__
-            uint16_t u1 = tos.u;
-            uint16_t ud_msb = restDataStack++->u;
-            uint16_t ud_lsb = restDataStack++->u;
-            uint32_t ud = ((uint32_t)ud_msb << 16) | ud_lsb;
-
-            // FIXME Doesn't work on Arduino; maybe a compiler
-            // difference?  Meanwhile, ldiv seems to work in the vast
-            // majority of cases; only extreme situations ((65535 *
-            // 65535) / 65535) return the incorrect results.
-            //
-            // (--restDataStack)->u = ud % u1;
-            // tos.u = ud / u1;
-
-            ldiv_t result = ldiv(ud, u1);
-            (--restDataStack)->u = result.rem;
-            tos.u = result.quot;
-#else
-            uint32_t u1 = tos.u;
-            uint32_t ud_msb = restDataStack++->u;
-            uint32_t ud_lsb = restDataStack++->u;
-            uint64_t ud = ((uint64_t)ud_msb << 32) | ud_lsb;
-            (--restDataStack)->u = ud % u1;
-            tos.u = ud / u1;
-#endif
+            CHECK_STACK(3, 1);
+            const EnforthUnsigned desired = restDataStack++->u;
+            const EnforthUnsigned expected = restDataStack++->u;
+            mark_dirty(vm, tos.ram, kEnforthCellSize);
+            tos.i = compare_and_swap_cell((EnforthCell*)tos.ram, expected, desired);
         }
         continue;
 
         /* -------------------------------------------------------------
-         * UM* [CORE] 6.1.2360 "u-m-star" ( u1 u2 -- ud )
+         * .FFI-STATS [Enforth] "dot-f-f-i-stats" ( -- )
          *
-         * Multiply u1 by u2, giving the unsigned double-cell product
-         * ud.  All values and arithmetic are unsigned
+         * Display the call count, total time, and latency histogram of
+         * each FFI that has been called.  Nothing is displayed unless
+         * Enforth was built with ENABLE_FFI_STATS.
          *
-        ***{:token :umstar
-        *** :name "UM*"}
+        ***{:token :dotffistats
+        *** :name ".FFI-STATS"
+        *** :args [[] []]}
          */
-        UMSTAR:
+        DOTFFISTATS:
         {
-            CHECK_STACK(2, 2);
-#ifdef __AVR__
-            uint32_t result = (uint32_t)tos.u * (uint32_t)restDataStack[0].u;
-            restDataStack[0].u = (uint16_t)result;
-            tos.u = (uint16_t)(result >> 16);
-#else
-            uint64_t result = (uint64_t)tos.u * (uint64_t)restDataStack[0].u;
-            restDataStack[0].u = (uint32_t)result;
-            tos.u = (uint32_t)(result >> 32);
+#if ENABLE_FFI_STATS
+            visit_ffis(vm, 0);
 #endif
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :unloop}
+         * FIND-ROM-FFI [Enforth] ( c-addr u -- c-addr u 0 | xt -1 )
+         *
+         * Find the ROM FFI word named in the string at c-addr with
+         * length u.  If the word is not found, return the string and
+         * zero, otherwise return its execution token xt and minus-one
+         * (-1).  ROM FFI words are never immediate.
+         *
+        ***{:token :findromffi
+        *** :name "FIND-ROM-FFI"
+        *** :args [[:caddr :u] [[:caddr :u 0] [:xt -1]]]
+        *** :flags #{:headerless}}
          */
-        UNLOOP:
+        FINDROMFFI:
         {
-            CHECK_STACK(0, 0);
-            returnTop++;
-            returnTop++;
+            int index;
+
+            CHECK_STACK(2, 3);
+
+            index = find_rom_ffi(vm, restDataStack->ram, tos.i);
+            if (index < 0)
+            {
+                *--restDataStack = tos;
+                tos.i = 0;
+            }
+            else
+            {
+                restDataStack->u = (DOROMFFI << 8) | index;
+                tos.i = -1;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :xor}
+         * INITRP [Enforth] "init-r-p" ( -- ; R: i*x -- )
+         *
+         * Empty the return stack, close any included sources, and make
+         * the user input device the input source.
+         *
+        ***{:token :initrp
+        *** :flags #{:headerless}}
          */
-        XOR:
+        INITRP:
         {
-            CHECK_STACK(2, 1);
-            tos.i ^= restDataStack++->i;
+            CHECK_STACK(0, 0);
+            returnTop = TASK_RETURN_TOP(vm->cur_task.ram);
+
+            while (vm->source_depth > 0)
+            {
+                pop_input_source(vm);
+            }
+
+            vm->source_id.i = 0;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :zeroequals
-        *** :name "0="}
+        ***{:token :load}
          */
-        ZEROEQUALS:
+        LOAD:
         {
-            CHECK_STACK(1, 1);
-            tos.i = tos.i == 0 ? -1 : 0;
+            CHECK_STACK(0, 1);
+
+            *--restDataStack = tos;
+
+            if (vm->load != NULL)
+            {
+                tos.i = vm->load(vm->dictionary.ram, vm->dictionary_size.u);
+            }
+            else
+            {
+                tos.i = 0;
+            }
+
+            /* The load replaced the entire dictionary (including this
+             * task's stacks), so restart the operator task at COLD if
+             * the image is valid and start over with an empty
+             * dictionary if it is not. */
+            if (tos.i != 0)
+            {
+                if (image_is_valid(vm, vm->dictionary.ram, vm->dictionary_size.u))
+                {
+                    reset_dirty_pages(vm, 0, ((EnforthImageHeader *)vm->dictionary.ram)->extent);
+                    start_image(vm);
+                    goto UNPAUSE;
+                }
+
+                enforth_reset(vm);
+                goto ABORT;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-         * 0< [CORE] 6.1.0250 "zero-less" ( b -- flag )
+         * NUMBER? [Enforth] "number-question" ( c-addr u -- c-addr u 0 | n 1 | d 2 )
          *
-         * flag is true if and only if n is less than zero.
+         * Attempt to convert the string at c-addr of length u into a
+         * number.  The number and 1 (single-cell) or 2 (double-cell)
+         * are returned if the conversion was successful, otherwise the
+         * string and 0 are returned.
          *
-        ***{:token :zeroless
-        *** :name "0<"}
+         * Digits are converted using the radix in BASE unless the
+         * string begins with one of the Forth-2012 base prefixes: #
+         * (decimal), $ (hexadecimal), or % (binary).  The digits may be
+         * preceded by a sign (either before or after the prefix) and
+         * followed by a period, which marks the number as a
+         * double-cell number.  'c' converts to the character value of
+         * c.
+         *
+        ***{:token :numberq
+        *** :name "NUMBER?"
+        *** :args [[:caddr :u] [[:caddr :u 0] [:n 1] [:d 2]]]
+        *** :flags #{:headerless}}
          */
-        ZEROLESS:
+        NUMBERQ:
         {
-            CHECK_STACK(1, 0);
-            tos.i = tos.i < 0 ? -1 : 0;
-        }
-        continue;
+            CHECK_STACK(2, 3);
+            uint8_t * p = restDataStack[0].ram;
+            uint8_t * end = p + tos.u;
+            EnforthUnsigned base = ((EnforthCell*)vm->cur_task.ram)[2].u; /* User: BASE */
+            EnforthDoubleUnsigned ud = 0;
+            int8_t isNegative;
+            int8_t isDouble = 0;
+
+            if ((tos.u == 3) && (p[0] == '\'') && (p[2] == '\''))
+            {
+                /* Character literal. */
+                ud = p[1];
+                isNegative = 0;
+            }
+            else
+            {
+                /* Optional sign, optional base prefix, and then the
+                 * Forth-2012 location for the sign (after the prefix)
+                 * if we did not already find one. */
+                isNegative = parse_sign(&p, end);
+                if (p < end)
+                {
+                    switch (*p)
+                    {
+                        case '#': base = 10; p++; break;
+                        case '$': base = 16; p++; break;
+                        case '%': base = 2; p++; break;
+                    }
+                }
 
+                if (!isNegative)
+                {
+                    isNegative = parse_sign(&p, end);
+                }
 
+                /* A trailing period makes this a double-cell number. */
+                if ((end - p > 1) && (end[-1] == '.'))
+                {
+                    isDouble = -1;
+                    end--;
+                }
 
-        /* =============================================================
-         * CORE-EXT PRIMITIVES
-         */
+                /* There must be at least one digit and every character
+                 * must be a valid digit. */
+                if ((p == end) || (convert_digits(&ud, p, end, base) != end))
+                {
+                    *--restDataStack = tos;
+                    tos.i = 0;
+                    continue;
+                }
+            }
 
-        /* -------------------------------------------------------------
-        ***{:token :nip}
-         */
-        NIP:
-        {
-            CHECK_STACK(2, 1);
-            restDataStack++;
+            if (isNegative)
+            {
+                ud = -ud;
+            }
+
+            restDataStack[0].u = (EnforthUnsigned)ud;
+            if (isDouble)
+            {
+                (--restDataStack)->u = (EnforthUnsigned)(ud >> kEnforthCellBits);
+                tos.i = 2;
+            }
+            else
+            {
+                tos.i = 1;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :notequals
-        *** :name "<>"}
+         * OPEN-SOURCE [Enforth] ( c-addr u -- c-addr u 0 | fileid -1 )
+         *
+         * Ask the host's source provider to open the source named by
+         * c-addr u.  The fileid and true are returned if the source
+         * was opened, otherwise the name and false are returned.
+         *
+        ***{:token :opensource
+        *** :name "OPEN-SOURCE"
+        *** :args [[:caddr :u] [[:caddr :u 0] [:fileid -1]]]
+        *** :flags #{:headerless}}
          */
-        NOTEQUALS:
+        OPENSOURCE:
         {
-            CHECK_STACK(2, 1);
-            tos.i = restDataStack++->i != tos.i ? -1 : 0;
+            CHECK_STACK(2, 3);
+            EnforthCell fileid;
+            fileid.u = 0;
+
+            if (vm->open_source != NULL)
+            {
+                fileid = vm->open_source(restDataStack[0].ram, tos.u);
+            }
+
+            if (fileid.u != 0)
+            {
+                restDataStack[0] = fileid;
+                tos.i = -1;
+            }
+            else
+            {
+                *--restDataStack = tos;
+                tos.i = 0;
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :true}
+         * (ACCEPT) [Enforth] ( c-addr +n1 -- c-addr +n1 0 | +n2 -1 )
+         *
+         * Ask the host to read an entire line of at most +n1
+         * characters into c-addr.  The length of the line and true are
+         * returned if the host provides an accept callback, otherwise
+         * the arguments and false are returned so that ACCEPT can read
+         * the line a KEY at a time.  The VM returns to the host (as if
+         * HALT had been called) when the callback reports the end of
+         * the input, and receives an empty line if it is resumed.
+         *
+        ***{:token :paccept
+        *** :name "(ACCEPT)"
+        *** :args [[:caddr :n1] [[:caddr :n1 0] [:n2 -1]]]
+        *** :flags #{:headerless}}
          */
-        TRUE:
+        PACCEPT:
         {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.i = -1;
+            CHECK_STACK(2, 3);
+
+            if (vm->accept == NULL)
+            {
+                *--restDataStack = tos;
+                tos.i = 0;
+            }
+            else
+            {
+                int len;
+
+                /* Show the prompt before the host waits for input. */
+                flush_output(vm);
+
+                len = vm->accept(restDataStack->ram, tos.i);
+                mark_dirty(vm, restDataStack->ram, len < 0 ? 0 : len);
+                restDataStack->i = len < 0 ? 0 : len;
+                tos.i = -1;
+
+                if (len < 0)
+                {
+                    goto PHALT;
+                }
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :tuck}
+         * (AWAIT) [Enforth] "paren-await" ( a-addr -- )
+         *
+         * Make the current task wait until the host channel at a-addr
+         * is not empty and switch to the next runnable task (as PAUSE
+         * does).
+         *
+        ***{:token :pawait
+        *** :name "(AWAIT)"
+        *** :args [[:a-addr] []]
+        *** :flags #{:headerless}}
          */
-        TUCK:
+        PAWAIT:
         {
-            EnforthCell second = *restDataStack;
-            *restDataStack = tos;
-            *--restDataStack = second;
+            CHECK_STACK(1, 0);
+            ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor] = tos;
+            store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateAwaiting);
+            tos = *restDataStack++;
         }
-        continue;
+        goto PAUSE;
 
         /* -------------------------------------------------------------
-        ***{:token :tworfetch
-        *** :name "2R@"}
+         * PARSE-WORD [Enforth] "parse-word" ( char "ccc<char>" -- c-addr u )
+         *
+         * Parse ccc delimited by the delimiter char, skipping leading
+         * delimiters.
+         *
+         * c-addr is the address (within the input buffer) and u is the
+         * length of the parsed string.  If the parse area was empty,
+         * the resulting string has a zero length.
+         *
+         * Note that PARSE-WORD returns the length of the string between
+         * the found delimiters (or until the end of the parse area),
+         * but advances >IN past the final delimiter (unless we hit the
+         * end of the parse area without finding a delimiter).
+         *
+        ***{:token :parseword
+        *** :name "PARSE-WORD"
+        *** :args [[:c] [:caddr :u]]}
          */
-        TWORFETCH:
+        PARSEWORD:
         {
-            CHECK_STACK(0, 2);
-            *--restDataStack = tos;
-            tos = returnTop[0];
-            *--restDataStack = returnTop[1];
+            CHECK_STACK(1, 2);
+
+            /* Skip the leading delimiters by advancing >IN, then parse
+             * the word itself. */
+            uint8_t * const sourceEnd = vm->source.ram + vm->source_len.u;
+            if ((EnforthUnsigned)vm->to_in < vm->source_len.u)
+            {
+                vm->to_in = skip_delimiters(
+                        vm->source.ram + vm->to_in, sourceEnd, (uint8_t)tos.u)
+                    - vm->source.ram;
+            }
+
+            goto PARSE;
         }
-        continue;
 
         /* -------------------------------------------------------------
-        ***{:token :tworfrom
-        *** :name "2R>"}
+        ***{:token :pkey
+        *** :name "(KEY)"
+        *** :flags #{:headerless}}
          */
-        TWORFROM:
+        PKEY:
         {
-            CHECK_STACK(0, 2);
+            CHECK_STACK(0, 1);
             *--restDataStack = tos;
-            tos = *returnTop++;
-            *--restDataStack = *returnTop++;
+            flush_output(vm);
+            tos.i = vm->key();
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :ugreaterthan
-        *** :name "U>"}
+         * (PARK) [Enforth] "paren-park" ( a-addr -- )
+         *
+         * Park the current task on the mailbox at a-addr and switch to
+         * the next runnable task (as PAUSE does).  The task runs again
+         * once another task has sent a message to, or received a
+         * message from, the mailbox since this task last failed to do
+         * so (with ?RECEIVE or TRY-SEND).
+         *
+        ***{:token :ppark
+        *** :name "(PARK)"
+        *** :args [[:a-addr] []]
+        *** :flags #{:headerless}}
          */
-        UGREATERTHAN:
+        PPARK:
         {
-            CHECK_STACK(2, 1);
-            tos.i = restDataStack++->u > tos.u ? -1 : 0;
+            CHECK_STACK(1, 0);
+            ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor].u = DICT_REL(vm, tos.ram);
+            store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateParked);
+            tos = *restDataStack++;
         }
-        continue;
+        goto PAUSE;
 
         /* -------------------------------------------------------------
-        ***{:token :false}
-         */
-        FALSE:
-
-        /* -------------------------------------------------------------
-        ***{:token :zero
-        *** :name "0"}
+         * (REFILL) [Enforth] "paren-refill" ( -- flag )
+         *
+         * Read the next line of the current included source into its
+         * line buffer and make that line the input buffer.  Returns
+         * false if the input source is a string from EVALUATE, there
+         * is no source provider, or the end of the source has been
+         * reached.
+         *
+        ***{:token :prefill
+        *** :name "(REFILL)"
+        *** :args [[] [:flag]]
+        *** :flags #{:headerless}}
          */
-        ZERO:
+        PREFILL:
         {
             CHECK_STACK(0, 1);
             *--restDataStack = tos;
             tos.i = 0;
+
+            if ((vm->source_id.i != -1)
+                    && (vm->source_depth > 0)
+                    && (vm->read_line != NULL))
+            {
+                uint8_t * const buf = vm->line_buffers[vm->source_depth - 1];
+                const int len = vm->read_line(vm->source_id, buf, ENFORTH_TIB_SIZE);
+                if (len >= 0)
+                {
+                    vm->source.ram = buf;
+                    vm->source_len.u = len;
+                    vm->to_in = 0;
+                    tos.i = -1;
+                }
+            }
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :zeronotequals
-        *** :name "0<>"
-        *** :args [[:x] [:f]]}
+         * SOURCE> [Enforth] "source-from" ( -- )
+         *
+         * Close the current input source if it is an included file and
+         * restore the input source specification saved by >SOURCE.
+         *
+        ***{:token :popsource
+        *** :name "SOURCE>"
+        *** :args [[] []]
+        *** :flags #{:headerless}}
          */
-        ZERONOTEQUALS:
+        POPSOURCE:
         {
-            CHECK_STACK(1, 1);
-            tos.i = tos.i != 0 ? -1 : 0;
+            CHECK_STACK(0, 0);
+            if (vm->source_depth > 0)
+            {
+                pop_input_source(vm);
+            }
         }
         continue;
 
-
-
-        /* =============================================================
-         * DOUBLE PRIMITIVES
-         */
-
         /* -------------------------------------------------------------
-         * M+ [DOUBLE] 8.6.1.1830 "m-plus" ( d1|ud1 n -- d2|ud2 )
+         * >SOURCE [Enforth] "to-source" ( source-id -- )
          *
-         * Add n to d1|ud1, giving the sum d2|ud2.
+         * Save the current input source specification and make
+         * source-id the input source.  The input buffer is empty until
+         * it is set by the caller (EVALUATE) or by REFILL (included
+         * files).  Aborts if the input sources are nested too deeply.
          *
-        ***{:token :mplus
-        *** :name "M+"}
+        ***{:token :pushsource
+        *** :name ">SOURCE"
+        *** :args [[:source-id] []]
+        *** :flags #{:headerless}}
          */
-        MPLUS:
+        PUSHSOURCE:
         {
-            CHECK_STACK(3, 2);
-#ifdef __AVR__
-            uint16_t n = tos.u;
-            uint16_t d1_msb = restDataStack++->u;
-            uint16_t d1_lsb = restDataStack++->u;
-            uint32_t ud1 = ((uint32_t)d1_msb << 16) | d1_lsb;
-            uint32_t result = ud1 + n;
-            (--restDataStack)->u = (uint16_t)result;
-            tos.u = (uint16_t)(result >> 16);
-#else
-            uint32_t n = tos.u;
-            uint32_t d1_msb = restDataStack++->u;
-            uint32_t d1_lsb = restDataStack++->u;
-            uint64_t ud1 = ((uint64_t)d1_msb << 32) | d1_lsb;
-            uint64_t result = ud1 + n;
-            (--restDataStack)->u = (uint32_t)result;
-            tos.u = (uint32_t)(result >> 32);
-#endif
-        }
-        continue;
-
+            CHECK_STACK(1, 0);
+            if (vm->source_depth == ENFORTH_MAX_SOURCE_DEPTH)
+            {
+                goto SOURCE_OVERFLOW;
+            }
 
+            EnforthInputSource * const saved
+                = &vm->saved_sources[vm->source_depth++];
+            saved->source_id = vm->source_id;
+            saved->source_len = vm->source_len;
+            saved->source = vm->source;
+            saved->to_in = vm->to_in;
 
-        /* =============================================================
-         * FACILITY PRIMITIVES
-         */
+            vm->source_id = tos;
+            vm->source.ram = vm->line_buffers[vm->source_depth - 1];
+            vm->source_len.u = 0;
+            vm->to_in = 0;
 
-        /* -------------------------------------------------------------
-        ***{:token :keyq
-        *** :name "KEY?"}
-         */
-        KEYQ:
-        {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.i = vm->keyq();
+            tos = *restDataStack++;
         }
         continue;
 
-
-
-        /* =============================================================
-         * ENFORTH PRIMITIVES
-         */
-
         /* -------------------------------------------------------------
-        ***{:token :initrp
-        *** :flags #{:headerless}}
+         * ?DEQUEUE [Enforth] "question-dequeue" ( a-addr -- x true | false )
+         *
+         * Remove the oldest message x from the host channel at a-addr
+         * (see enforth_channel_send) and return true, or return false
+         * if the channel is empty.  Only one task may dequeue from a
+         * given channel.
+         *
+        ***{:token :qdequeue
+        *** :name "?DEQUEUE"
+        *** :args [[:a-addr] [[:x -1] [0]]]}
          */
-        INITRP:
+        QDEQUEUE:
         {
-            CHECK_STACK(0, 0);
-            returnTop = (EnforthCell*)(vm->cur_task.ram + kTaskStartToReturnTop);
+            CHECK_STACK(1, 2);
+            EnforthChannel * const channel = (EnforthChannel*)tos.ram;
+            const EnforthUnsigned head = channel->head.u;
+
+            if (load_cell(&channel->tail) == head)
+            {
+                tos.i = 0;
+                continue;
+            }
+
+            /* Read the message before giving its slot back to the
+             * host. */
+            *--restDataStack = channel->slots[head & channel->mask];
+            store_cell(&channel->head, head + 1);
+            tos.i = -1;
         }
         continue;
 
         /* -------------------------------------------------------------
-        ***{:token :load}
+         * ?RECEIVE [Enforth] "question-receive" ( a-addr -- x true | false )
+         *
+         * Remove the oldest message x from the mailbox at a-addr and
+         * return true, or return false if the mailbox is empty.
+         *
+        ***{:token :qreceive
+        *** :name "?RECEIVE"
+        *** :args [[:a-addr] [[:x -1] [0]]]}
          */
-        LOAD:
+        QRECEIVE:
         {
-            CHECK_STACK(0, 1);
+            CHECK_STACK(1, 2);
+            EnforthCell * const mailbox = (EnforthCell*)tos.ram;
 
-            *--restDataStack = tos;
+            lock_mailboxes(vm);
 
-            if (vm->load != NULL)
+            if (mailbox[kMailboxCount].u == 0)
             {
-                tos.i = vm->load(vm->dictionary.ram, vm->dictionary_size.u);
+                ((EnforthCell*)vm->cur_task.ram)[kTaskUserMailboxChanges] = mailbox[kMailboxChanges];
+                unlock_mailboxes(vm);
+                tos.i = 0;
+                continue;
             }
-            else
+
+            *--restDataStack = mailbox[kMailboxHeaderSize + mailbox[kMailboxHead].u];
+            if (++mailbox[kMailboxHead].u == mailbox[kMailboxCapacity].u)
             {
-                tos.i = 0;
+                mailbox[kMailboxHead].u = 0;
             }
-        }
-        continue;
 
-        /* -------------------------------------------------------------
-        ***{:token :pkey
-        *** :name "(KEY)"
-        *** :flags #{:headerless}}
-         */
-        PKEY:
-        {
-            CHECK_STACK(0, 1);
-            *--restDataStack = tos;
-            tos.i = vm->key();
+            mailbox[kMailboxCount].u--;
+
+            /* There is room for another message now. */
+            store_cell(&mailbox[kMailboxChanges], mailbox[kMailboxChanges].u + 1);
+            mark_dirty(
+                    vm,
+                    (uint8_t*)mailbox,
+                    kEnforthCellSize * (kMailboxHeaderSize + mailbox[kMailboxCapacity].u));
+
+            unlock_mailboxes(vm);
+            tos.i = -1;
         }
         continue;
 
@@ -2226,9 +4209,39 @@ DISPATCH_TOKEN:
 
             *--restDataStack = tos;
 
-            if (vm->save != NULL)
+            if ((vm->save != NULL) || (vm->save_range != NULL))
             {
-                tos.i = vm->save(vm->dictionary.ram, vm->dictionary_size.u);
+                /* Fill in the image header and then save the used
+                 * portion of the dictionary. */
+                link_ffi_words(vm, 1);
+                EnforthImageHeader * const header = fill_image_header(vm);
+
+                /* Incremental saves only need the pages that changed,
+                 * which always includes the header, the tasks, and any
+                 * space that was allotted since the last save. */
+                if (vm->save_range != NULL)
+                {
+                    mark_dirty(vm, vm->dictionary.ram, sizeof(EnforthImageHeader));
+                    mark_tasks_dirty(vm);
+                    if (vm->saved_extent < header->extent)
+                    {
+                        mark_dirty(
+                                vm,
+                                vm->dictionary.ram + vm->saved_extent,
+                                header->extent - vm->saved_extent);
+                    }
+
+                    tos.i = save_dirty_pages(vm, header->extent);
+                }
+                else
+                {
+                    tos.i = vm->save(vm->dictionary.ram, header->extent);
+                }
+
+                if (tos.i != 0)
+                {
+                    reset_dirty_pages(vm, 0, header->extent);
+                }
             }
             else
             {
@@ -2237,6 +4250,31 @@ DISPATCH_TOKEN:
         }
         continue;
 
+        /* -------------------------------------------------------------
+         * SLEEP-UNTIL [Enforth] ( u -- )
+         *
+         * Put the current task to sleep until TICKS reaches u and then
+         * switch to the next runnable task (as PAUSE does).  The task
+         * is only paused if the host does not provide a tick source.
+         *
+        ***{:token :sleepuntil
+        *** :name "SLEEP-UNTIL"
+        *** :args [[:u] []]}
+         */
+        SLEEPUNTIL:
+        {
+            CHECK_STACK(1, 0);
+
+            if (vm->ticks != NULL)
+            {
+                ((EnforthCell*)vm->cur_task.ram)[kTaskUserWaitFor] = tos;
+                store_cell(&((EnforthCell*)vm->cur_task.ram)[kTaskUserState], kTaskStateSleeping);
+            }
+
+            tos = *restDataStack++;
+        }
+        goto PAUSE;
+
         /* -------------------------------------------------------------
         ***{:token :tickromdef
         *** :name "'ROMDEF"
@@ -2251,6 +4289,73 @@ DISPATCH_TOKEN:
         }
         continue;
 
+        /* -------------------------------------------------------------
+         * TICKS [Enforth] ( -- u )
+         *
+         * Return the host's monotonic tick count (in milliseconds),
+         * which wraps around once it reaches the largest unsigned
+         * number.  Zero is returned if the host does not provide a
+         * tick source.
+         *
+        ***{:token :ticks
+        *** :args [[] [:u]]}
+         */
+        TICKS:
+        {
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos.u = current_ticks(vm);
+        }
+        continue;
+
+        /* -------------------------------------------------------------
+         * TRY-SEND [Enforth] ( x a-addr -- flag )
+         *
+         * Add the message x to the mailbox at a-addr and return true,
+         * or return false if the mailbox is full.
+         *
+        ***{:token :trysend
+        *** :name "TRY-SEND"
+        *** :args [[:x :a-addr] [:flag]]}
+         */
+        TRYSEND:
+        {
+            CHECK_STACK(2, 1);
+            EnforthCell * const mailbox = (EnforthCell*)tos.ram;
+            EnforthUnsigned slot;
+
+            lock_mailboxes(vm);
+
+            if (mailbox[kMailboxCount].u == mailbox[kMailboxCapacity].u)
+            {
+                ((EnforthCell*)vm->cur_task.ram)[kTaskUserMailboxChanges] = mailbox[kMailboxChanges];
+                unlock_mailboxes(vm);
+                restDataStack++;
+                tos.i = 0;
+                continue;
+            }
+
+            slot = mailbox[kMailboxHead].u + mailbox[kMailboxCount].u;
+            if (slot >= mailbox[kMailboxCapacity].u)
+            {
+                slot -= mailbox[kMailboxCapacity].u;
+            }
+
+            mailbox[kMailboxHeaderSize + slot] = *restDataStack++;
+            mailbox[kMailboxCount].u++;
+
+            /* There is a message to receive now. */
+            store_cell(&mailbox[kMailboxChanges], mailbox[kMailboxChanges].u + 1);
+            mark_dirty(
+                    vm,
+                    (uint8_t*)mailbox,
+                    kEnforthCellSize * (kMailboxHeaderSize + mailbox[kMailboxCapacity].u));
+
+            unlock_mailboxes(vm);
+            tos.i = -1;
+        }
+        continue;
+
         /* -------------------------------------------------------------
         ***{:token :twonip
         *** :name "2NIP"
@@ -2266,6 +4371,19 @@ DISPATCH_TOKEN:
         }
         continue;
 
+        /* -------------------------------------------------------------
+        ***{:token :hldend
+        *** :args [[] [:caddr]]
+        *** :flags #{:headerless}}
+         */
+        HLDEND:
+        {
+            CHECK_STACK(0, 1);
+            *--restDataStack = tos;
+            tos.ram = hold_end(vm);
+        }
+        continue;
+
         /* -------------------------------------------------------------
         ***{:token :vm
         *** :args [[] [:addr]]
@@ -2281,27 +4399,132 @@ DISPATCH_TOKEN:
     }
 }
 
-void enforth_go(EnforthVM * const vm)
+int enforth_complete(
+        EnforthVM * const vm,
+        const EnforthCell handle, const EnforthCell result)
 {
-    /* Clear both stacks. */
-    EnforthCell * sp = (EnforthCell*)(vm->cur_task.ram + kTaskStartToDataTop - kEnforthCellSize);
-    EnforthCell * rsp = (EnforthCell*)(vm->cur_task.ram + kTaskStartToReturnTop - kEnforthCellSize);
+    EnforthCell * task;
+
+    if (handle.u == 0)
+    {
+        return 0;
+    }
+
+    /* Find the task that is waiting for this handle.  The task may
+     * still be saving its registers on another thread, so we claim it
+     * (which does not take long, since it is no longer running) before
+     * changing its stack. */
+    for (task = (EnforthCell*)DICT_ABS(vm, load_cell(&DICT_CELLS(vm)[2]));
+            (load_cell(&task[kTaskUserState]) != kTaskStatePending)
+                || (task[kTaskUserWaitFor].u != handle.u);
+            task = (EnforthCell*)DICT_ABS(vm, task[0].u))
+    {
+        if (task[0].u == 0)
+        {
+            return 0;
+        }
+    }
+
+    while (!claim_task(task))
+    {
+    }
+
+    /* Another thread may have completed the handle (or the task may
+     * have been restarted) while we were waiting for the claim. */
+    if ((load_cell(&task[kTaskUserState]) != kTaskStatePending)
+            || (task[kTaskUserWaitFor].u != handle.u))
+    {
+        release_task(task);
+        return 0;
+    }
+
+    /* Push the result under the saved IP and RSP, which makes the
+     * result the task's TOS when it resumes. */
+    {
+        EnforthCell * sp = (EnforthCell*)DICT_ABS(vm, task[1].u);
+
+        sp[-1] = sp[0]; /* IP */
+        sp[0] = sp[1]; /* RSP */
+        sp[1] = result;
+
+        task[1].u = DICT_REL(vm, sp - 1);
+    }
+
+    /* The task is runnable again. */
+    store_cell(&task[kTaskUserState], kTaskStateRunnable);
+    release_task(task);
+    return -1;
+}
+
+int enforth_init_channel(
+        EnforthChannel * const channel,
+        EnforthCell * const slots, const EnforthUnsigned capacity)
+{
+    if ((capacity == 0) || ((capacity & (capacity - 1)) != 0))
+    {
+        return 0;
+    }
+
+    channel->head.u = 0;
+    channel->tail.u = 0;
+    channel->mask = capacity - 1;
+    channel->slots = slots;
+    return -1;
+}
+
+int enforth_channel_send(
+        EnforthChannel * const channel, const EnforthCell message)
+{
+    const EnforthUnsigned tail = channel->tail.u;
+
+    /* The counters run freely, so the channel is full when the host is
+     * a full ring ahead of the task. */
+    if (tail - load_cell(&channel->head) > channel->mask)
+    {
+        return 0;
+    }
+
+    /* Write the message before handing its slot to the task. */
+    channel->slots[tail & channel->mask] = message;
+    store_cell(&channel->tail, tail + 1);
+    return -1;
+}
+
+void enforth_signal(EnforthVM * const vm, const EnforthUnsigned event)
+{
+    if (event >= kEnforthCellBits)
+    {
+        return;
+    }
 
-    /* Set the IP to the beginning of COLD. */
 #ifdef __AVR__
-    uint8_t* ip = (void *)(0x8000 | (unsigned int)((uint8_t*)definitions + (ROMDEF_COLD&0x3FFF) + kNFAtoPFA));
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        vm->signals |= (EnforthUnsigned)1 << event;
+    }
 #else
-    uint8_t* ip = (uint8_t*)definitions + (ROMDEF_COLD&0x3FFF) + kNFAtoPFA;
+    __atomic_fetch_or(&vm->signals, (EnforthUnsigned)1 << event, __ATOMIC_ACQ_REL);
 #endif
+}
+
+#if ENABLE_FFI_STATS
+const EnforthFFIStats * enforth_ffi_stats(const EnforthFFIDef * const ffidef)
+{
+    return (const EnforthFFIStats *)pgm_read_word(&ffidef->stats);
+}
 
-    /* Push RSP and IP to the stack. */
-    (--sp)->ram = (uint8_t*)rsp;
-    (--sp)->ram = ip;
+void enforth_clear_ffi_stats(EnforthVM * const vm)
+{
+    visit_ffis(vm, 1);
+}
+#endif
 
-    /* Save the stack pointer. */
-    /* TODO This should be dictionary-relative so that it can relocate
-     * with the dictionary. */
-    ((EnforthCell*)vm->cur_task.ram)[1].ram = (uint8_t*)sp;
+void enforth_go(EnforthVM * const vm)
+{
+    /* Clear both of the operator task's stacks and prepare to start at
+     * COLD. */
+    vm->cur_task.ram = vm->dictionary.ram + kDictionaryToOperatorTask;
+    prepare_cold_start(vm);
 
     /* Resume the interpreter. */
     enforth_resume(vm);
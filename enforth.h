@@ -44,9 +44,18 @@ extern "C" {
 #ifdef __AVR__
 typedef int16_t EnforthInt;
 typedef uint16_t EnforthUnsigned;
+typedef int32_t EnforthDoubleInt;
+typedef uint32_t EnforthDoubleUnsigned;
+#elif UINTPTR_MAX > UINT32_MAX
+typedef int64_t EnforthInt;
+typedef uint64_t EnforthUnsigned;
+typedef __int128 EnforthDoubleInt;
+typedef unsigned __int128 EnforthDoubleUnsigned;
 #else
 typedef int32_t EnforthInt;
 typedef uint32_t EnforthUnsigned;
+typedef int64_t EnforthDoubleInt;
+typedef uint64_t EnforthDoubleUnsigned;
 #endif
 
 /* Execution Tokens (XTs) are always 16-bits, even on 32-bit processors
@@ -76,86 +85,471 @@ typedef union
  * Foreign-function-interface types.
  */
 
-typedef EnforthCell (*ZeroArgFFI)(
-        void);
-typedef EnforthCell (*OneArgFFI)(
-        EnforthCell a);
-typedef EnforthCell (*TwoArgFFI)(
-        EnforthCell a, EnforthCell b);
-typedef EnforthCell (*ThreeArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c);
-typedef EnforthCell (*FourArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c, EnforthCell d);
-typedef EnforthCell (*FiveArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c, EnforthCell d,
-        EnforthCell e);
-typedef EnforthCell (*SixArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c, EnforthCell d,
-        EnforthCell e, EnforthCell f);
-typedef EnforthCell (*SevenArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c, EnforthCell d,
-        EnforthCell e, EnforthCell f, EnforthCell g);
-typedef EnforthCell (*EightArgFFI)(
-        EnforthCell a, EnforthCell b, EnforthCell c, EnforthCell d,
-        EnforthCell e, EnforthCell f, EnforthCell g, EnforthCell h);
+/* Every FFI is called through an adapter with this signature.  tos
+ * points at the top of the data stack (tos[1] is the second item, and
+ * so on) and tos[-1] is the free "super TOS" cell just beyond the top of
+ * the stack; DOFFI checks that there is room for the results, so a
+ * double-cell result can use tos[-2] as well.  The adapter reads its
+ * arguments, stores its results in place of those arguments (or beyond
+ * the top of the stack), and then returns the stack adjustment, which
+ * is the number of result cells minus the number of argument cells.
+ * The ENFORTH_EXTERN macros generate these adapters. */
+typedef int (*EnforthFFI)(EnforthCell * tos);
+
+#if ENABLE_FFI_STATS
+/* Number of latency histogram buckets kept for each FFI.  Bucket b
+ * counts the calls whose latency (in ffi_clock ticks) was b bits long,
+ * so bucket 0 counts calls that took no time at all and the last
+ * bucket also counts all of the calls that took longer. */
+#ifndef ENFORTH_FFI_STATS_BUCKETS
+#define ENFORTH_FFI_STATS_BUCKETS 16
+#endif
+
+/* Call statistics, which are kept in RAM for each FFI when Enforth is
+ * built with ENABLE_FFI_STATS.  The statistics are static globals that
+ * belong to the FFI definition, not to a VM, so every VM that calls an
+ * FFI adds to (and clears) the same counters. */
+typedef struct
+{
+    uint32_t calls;
+    uint32_t total_time;
+    uint16_t histogram[ENFORTH_FFI_STATS_BUCKETS];
+} EnforthFFIStats;
+#endif
 
 typedef struct EnforthFFIDef
 {
     const struct EnforthFFIDef * const prev;
     const char * const name;
     uint8_t arity;
-    uint8_t is_void;
-    void * fn;
+    uint8_t results;
+    EnforthFFI fn;
+#if ENABLE_FFI_STATS
+    EnforthFFIStats * stats;
+#endif
 } EnforthFFIDef;
 
 static const int kEnforthFFIProcPtrSize = sizeof(void*);
 
+/* Flag in EnforthFFIDef.results that marks an asynchronous FFI.  The
+ * adapter for an asynchronous FFI leaves a non-zero handle on the stack
+ * in place of its result; the calling task then waits (while the other
+ * tasks run) until the host passes that handle and the result to
+ * enforth_complete. */
+#define ENFORTH_FFI_ASYNC 0x80
+
 /* FFI Macros */
 #define LAST_FFI NULL
 
+/* Calls a C function with the top arity items on the stack; the
+ * deepest item is the first argument. */
+#define ENFORTH_FFI_CALL_0(fn, tos) fn()
+#define ENFORTH_FFI_CALL_1(fn, tos) fn(tos[0].i)
+#define ENFORTH_FFI_CALL_2(fn, tos) fn(tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_3(fn, tos) fn(tos[2].i, tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_4(fn, tos) fn(tos[3].i, tos[2].i, tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_5(fn, tos) fn(tos[4].i, tos[3].i, tos[2].i, tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_6(fn, tos) fn(tos[5].i, tos[4].i, tos[3].i, tos[2].i, tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_7(fn, tos) fn(tos[6].i, tos[5].i, tos[4].i, tos[3].i, tos[2].i, tos[1].i, tos[0].i)
+#define ENFORTH_FFI_CALL_8(fn, tos) fn(tos[7].i, tos[6].i, tos[5].i, tos[4].i, tos[3].i, tos[2].i, tos[1].i, tos[0].i)
+
+/* Reads the double-cell number whose most-significant cell is at
+ * tos[n], and stores a double-cell number in the same layout. */
+#define ENFORTH_FFI_GET_DOUBLE(tos, n) \
+    ((EnforthDoubleInt)(((EnforthDoubleUnsigned)(tos)[(n)].u << (kEnforthCellSize * 8)) | (tos)[(n) + 1].u))
+#define ENFORTH_FFI_SET_DOUBLE(tos, n, d) \
+    { \
+        const EnforthDoubleInt ffiDouble = (d); \
+        (tos)[(n) + 1].u = (EnforthUnsigned)ffiDouble; \
+        (tos)[(n)].u = (EnforthUnsigned)((EnforthDoubleUnsigned)ffiDouble >> (kEnforthCellSize * 8)); \
+    }
+
+/* Calls a C function with the top arity double-cell numbers on the
+ * stack; the deepest number is the first argument. */
+#define ENFORTH_FFI_DCALL_0(fn, tos) fn()
+#define ENFORTH_FFI_DCALL_1(fn, tos) fn(ENFORTH_FFI_GET_DOUBLE(tos, 0))
+#define ENFORTH_FFI_DCALL_2(fn, tos) fn(ENFORTH_FFI_GET_DOUBLE(tos, 2), ENFORTH_FFI_GET_DOUBLE(tos, 0))
+#define ENFORTH_FFI_DCALL_3(fn, tos) fn(ENFORTH_FFI_GET_DOUBLE(tos, 4), ENFORTH_FFI_GET_DOUBLE(tos, 2), ENFORTH_FFI_GET_DOUBLE(tos, 0))
+#define ENFORTH_FFI_DCALL_4(fn, tos) fn(ENFORTH_FFI_GET_DOUBLE(tos, 6), ENFORTH_FFI_GET_DOUBLE(tos, 4), ENFORTH_FFI_GET_DOUBLE(tos, 2), ENFORTH_FFI_GET_DOUBLE(tos, 0))
+
+/* The a, b, and c cells passed to ENFORTH_EXTERN_METHOD bodies; cells
+ * beyond the method's arity are unused. */
+#define ENFORTH_FFI_CELLS_0(tos) tos[0], tos[0], tos[0]
+#define ENFORTH_FFI_CELLS_1(tos) tos[0], tos[0], tos[0]
+#define ENFORTH_FFI_CELLS_2(tos) tos[1], tos[0], tos[0]
+#define ENFORTH_FFI_CELLS_3(tos) tos[2], tos[1], tos[0]
+
 /* NOTE that ENFORTH_EXTERN needs to be in near (<64KB) program memory
  * on large AVR processors since we access the definition using 16-bit
  * references in Forth.  The code itself can (and probably should?) be
  * located in extended program memory though since the function pointer
  * is only ever used in C and thus can use the full address space
  * resolution of the processor. */
-#define ENFORTH_EXTERN(name, fn, arity) \
+#if ENABLE_FFI_STATS
+#define ENFORTH_FFI_DEF(name, arity, results) \
+    static EnforthFFIStats FFISTATS_ ## name; \
+    static const char FFIDEF_ ## name ## _NAME[] PROGMEM = #name; \
+    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, results, FFITHUNK_ ## name, &FFISTATS_ ## name };
+#else
+#define ENFORTH_FFI_DEF(name, arity, results) \
     static const char FFIDEF_ ## name ## _NAME[] PROGMEM = #name; \
-    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, 0, (void*)fn };
+    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, results, FFITHUNK_ ## name };
+#endif
+
+#define ENFORTH_EXTERN(name, fn, arity) \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        tos[(arity) - 1].i = ENFORTH_FFI_CALL_ ## arity(fn, tos); \
+        return 1 - (arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, 1)
 
 #define ENFORTH_EXTERN_VOID(name, fn, arity) \
-    static const char FFIDEF_ ## name ## _NAME[] PROGMEM = #name; \
-    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, 1, (void*)fn };
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        ENFORTH_FFI_CALL_ ## arity(fn, tos); \
+        return -(arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, 0)
+
+/* Single-cell arguments, double-cell result (millis, micros). */
+#define ENFORTH_EXTERN_DOUBLE(name, fn, arity) \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        ENFORTH_FFI_SET_DOUBLE(tos, (arity) - 2, ENFORTH_FFI_CALL_ ## arity(fn, tos)); \
+        return 2 - (arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, 2)
+
+/* Double-cell arguments (arity is the number of double-cell numbers),
+ * double-cell result (random). */
+#define ENFORTH_EXTERN_DOUBLE_ARGS(name, fn, arity) \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        ENFORTH_FFI_SET_DOUBLE(tos, ((arity) * 2) - 2, ENFORTH_FFI_DCALL_ ## arity(fn, tos)); \
+        return 2 - ((arity) * 2); \
+    } \
+    ENFORTH_FFI_DEF(name, (arity) * 2, 2)
+
+/* Double-cell arguments, no result (randomSeed, delay). */
+#define ENFORTH_EXTERN_VOID_DOUBLE_ARGS(name, fn, arity) \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        ENFORTH_FFI_DCALL_ ## arity(fn, tos); \
+        return -((arity) * 2); \
+    } \
+    ENFORTH_FFI_DEF(name, (arity) * 2, 0)
+
+/* Asynchronous FFI: fn starts an operation and returns a non-zero
+ * handle that identifies it; the result is provided later through
+ * enforth_complete.  fn returns zero if the operation could not be
+ * started, in which case the word does not wait and its result is
+ * zero. */
+#define ENFORTH_EXTERN_ASYNC(name, fn, arity) \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        tos[(arity) - 1].i = ENFORTH_FFI_CALL_ ## arity(fn, tos); \
+        return 1 - (arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, ENFORTH_FFI_ASYNC | 1)
 
 #define ENFORTH_EXTERN_METHOD(name, fnbody, arity) \
     static void * FFIMETHODCALL_ ## name (EnforthCell a, EnforthCell b, EnforthCell c) fnbody \
-    static const char FFIDEF_ ## name ## _NAME[] PROGMEM = #name; \
-    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, 0, (void*)FFIMETHODCALL_ ## name };
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        tos[(arity) - 1].ram = (uint8_t *)FFIMETHODCALL_ ## name(ENFORTH_FFI_CELLS_ ## arity(tos)); \
+        return 1 - (arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, 1)
 
 #define ENFORTH_EXTERN_VOID_METHOD(name, fnbody, arity) \
-    static void * FFIMETHODCALL_ ## name (EnforthCell a, EnforthCell b, EnforthCell c) fnbody \
-    static const char FFIDEF_ ## name ## _NAME[] PROGMEM = #name; \
-    static const EnforthFFIDef FFIDEF_##name PROGMEM = { LAST_FFI, FFIDEF_ ## name ## _NAME, arity, 1, (void*)FFIMETHODCALL_ ## name };
+    static void FFIMETHODCALL_ ## name (EnforthCell a, EnforthCell b, EnforthCell c) fnbody \
+    static int FFITHUNK_ ## name(EnforthCell * tos) \
+    { \
+        FFIMETHODCALL_ ## name(ENFORTH_FFI_CELLS_ ## arity(tos)); \
+        return -(arity); \
+    } \
+    ENFORTH_FFI_DEF(name, arity, 0)
 
 #define GET_LAST_FFI(name) &FFIDEF_ ## name
 
+/* ROM FFI words are FFIs that are found by name without USE: and thus
+ * do not consume any dictionary space.  List the names of FFIs (which
+ * must already have been defined with one of the ENFORTH_EXTERN macros)
+ * in an X-macro and then define the table:
+ *
+ *   #define MY_ROM_FFIS(X) X(digitalWrite) X(pinMode)
+ *   ENFORTH_ROM_FFIS(kMyROMFFIs, MY_ROM_FFIS)
+ *
+ * Assign the table to the VM's rom_ffis field after enforth_init.  Up
+ * to 255 FFIs can be listed; compiled references to these words are
+ * the DOROMFFI token followed by the FFI's index in the table, so
+ * changing the table invalidates saved images. */
+#define ENFORTH_ROM_FFI_ENTRY(name) &FFIDEF_ ## name,
+#define ENFORTH_ROM_FFIS(table, list) \
+    static const EnforthFFIDef * const table[] PROGMEM = { list(ENFORTH_ROM_FFI_ENTRY) NULL };
+
 
 
 /* -------------------------------------
- * Enforth Virtual Machine type.
+ * Image types.
+ */
+
+/* Every dictionary begins with an image header, which allows the used
+ * portion of the dictionary to be saved by SAVE and later loaded (or
+ * mapped directly into memory) by enforth_load_image.  All of the
+ * pointers in the dictionary are relative to its start, so images do
+ * not require any fixups when they are loaded, with the exception of
+ * the FFI words created by USE:, which are linked to the host's FFI
+ * definitions again by index. */
+#define kEnforthImageMagic 0x49464E45UL /* "ENFI" */
+#define kEnforthImageVersion 2
+
+typedef struct
+{
+    uint32_t magic;
+
+    /* Hash of the ROM definitions and FFI names that the image was
+     * compiled against; images can only be loaded by a build with the
+     * same tokens, ROM XTs, and FFIs. */
+    uint32_t build_hash;
+
+    /* Number of bytes used by the image, including this header. */
+    uint32_t extent;
+
+    uint16_t version;
+    uint16_t cell_size;
+
+    /* XT of the word that COLD executes (see TURNKEY), or zero. */
+    EnforthCell turnkey;
+} EnforthImageHeader;
+
+/* Size (in bytes) of the map of dictionary pages that have changed since
+ * the last SAVE.  Each bit tracks one page; the page size is the
+ * smallest power of two (and at least 16 bytes) for which the map covers
+ * the entire dictionary. */
+#ifndef ENFORTH_DIRTY_MAP_SIZE
+#define ENFORTH_DIRTY_MAP_SIZE 16
+#endif
+
+
+
+/* -------------------------------------
+ * Text interpreter types.
+ */
+
+/* Size of the terminal input buffer and of the line buffer used by each
+ * included source.  Longer lines are truncated by the source provider.
+ * TIBSIZE returns this value as a byte literal. */
+#ifndef ENFORTH_TIB_SIZE
+#define ENFORTH_TIB_SIZE 80
+#endif
+
+#if ENFORTH_TIB_SIZE > 255
+#error ENFORTH_TIB_SIZE must fit in a byte.
+#endif
+
+/* Maximum number of nested input sources (EVALUATE strings and included
+ * files).  Each level adds a line buffer of ENFORTH_TIB_SIZE bytes to
+ * the VM, so the AVR only allows a single level by default; EVALUATE
+ * and INCLUDED abort if that level is already in use. */
+#ifndef ENFORTH_MAX_SOURCE_DEPTH
+#ifdef __AVR__
+#define ENFORTH_MAX_SOURCE_DEPTH 1
+#else
+#define ENFORTH_MAX_SOURCE_DEPTH 4
+#endif
+#endif
+
+/* Input source specification that is saved while a nested input source
+ * is being interpreted. */
+typedef struct
+{
+    EnforthCell source_id;
+    EnforthCell source_len;
+    EnforthCell source;
+    EnforthInt to_in;
+} EnforthInputSource;
+
+
+
+/* -------------------------------------
+ * Output types.
+ */
+
+/* Size of the buffer that collects EMIT and TYPE output when the host
+ * provides a type callback.  The buffer is flushed by CR, KEY, KEY?,
+ * PAUSE, HALT, and whenever it fills up. */
+#ifndef ENFORTH_OUTPUT_BUFFER_SIZE
+#define ENFORTH_OUTPUT_BUFFER_SIZE 32
+#endif
+
+#if ENFORTH_OUTPUT_BUFFER_SIZE > 255
+#error ENFORTH_OUTPUT_BUFFER_SIZE must fit in a byte.
+#endif
+
+/* Size of the pictured numeric output (<# ... #>) buffer, which holds a
+ * double-cell number in binary with room to spare.  The operator task
+ * builds its numbers in the space just past HERE; worker contexts use a
+ * buffer of this size in the VM instead, since HERE is shared. */
+#define ENFORTH_HOLD_SIZE (kEnforthCellSize * 8 * 3)
+
+
+
+/* -------------------------------------
+ * Run types.
+ */
+
+/* Reasons that enforth_run returns to the host. */
+typedef enum
+{
+    /* The operator task executed HALT (enforth_evaluate's text has
+     * been evaluated, for example). */
+    kEnforthRunHalted = 0,
+
+    /* Every task is asleep or waiting for the host (an asynchronous
+     * FFI call, a host event, a channel, or a mailbox). */
+    kEnforthRunWaiting,
+
+    /* The run's budget of task switches ran out. */
+    kEnforthRunYielded
+} EnforthRunResult;
+
+
+
+/* -------------------------------------
+ * Channel types.
+ *
+ * A channel is a single-producer, single-consumer ring of cells in host
+ * memory that streams messages from the host to a task.  One host
+ * thread (or interrupt handler) at a time sends with
+ * enforth_channel_send, without locking and while the VM is running;
+ * one task receives with DEQUEUE or ?DEQUEUE, given the address of the
+ * channel.  Each side only writes its own counter, so neither side ever
+ * waits for the other.
  */
 
 typedef struct
+{
+    /* Number of messages that the task has received. */
+    EnforthCell head;
+
+#ifndef __AVR__
+    /* Keeps the two counters on separate cache lines, so that the host
+     * thread and the task's thread do not contend for the same line. */
+    uint8_t head_padding[64 - sizeof(EnforthCell)];
+#endif
+
+    /* Number of messages that the host has sent. */
+    EnforthCell tail;
+
+    /* Capacity of the ring (a power of two) less one, and the ring. */
+    EnforthUnsigned mask;
+    EnforthCell * slots;
+} EnforthChannel;
+
+
+
+/* -------------------------------------
+ * Enforth Virtual Machine type.
+ *
+ * All of the VM's mutable state is in EnforthVM and its dictionary; the
+ * ROM definitions and the inner interpreter's jump table are read-only.
+ * Separate VMs (each with its own dictionary) can therefore run on
+ * separate threads at the same time.  A single VM is not thread-safe:
+ * only one thread at a time may call the functions below on a given VM,
+ * with the exception of enforth_signal.  FFI definitions, and thus
+ * their statistics (which are updated atomically), are shared by every
+ * VM that uses them, so FFI functions must be thread-safe if they are
+ * called from more than one VM.
+ *
+ * The tasks of a single VM can also run in parallel on hosts: each
+ * additional thread runs the VM's tasks through a worker context (see
+ * enforth_init_worker), which holds that thread's current task and
+ * interpreter registers.  Each task is run by one thread at a time.
+ * Tasks that share memory use ATOMIC@, ATOMIC!, and CAS, or mailboxes,
+ * to coordinate; compiling (and anything else that changes HERE) is
+ * left to the operator task.
+ */
+
+typedef struct EnforthVM
 {
     /* VM constants */
     const EnforthFFIDef * last_ffi;
 
+    /* Optional NULL-terminated table of ROM FFI words (see
+     * ENFORTH_ROM_FFIS).  enforth_init sets this to NULL. */
+    const EnforthFFIDef * const * rom_ffis;
+
     int (*keyq)(void);
     char (*key)(void);
     void (*emit)(char);
     int (*load)(uint8_t*, int);
     int (*save)(uint8_t*, int);
 
+    /* Optional source provider used by INCLUDED and INCLUDE-FILE.
+     * open_source returns a non-zero fileid for the named source, or
+     * zero if the source could not be opened.  read_line copies the
+     * next line of the source (without its line terminator, and
+     * truncated to max characters) into buf and returns the length of
+     * that line, or -1 at the end of the source.  close_source releases
+     * the fileid.  enforth_init sets these to NULL; hosts that support
+     * included sources assign them after initializing the VM. */
+    EnforthCell (*open_source)(const uint8_t * name, int len);
+    int (*read_line)(EnforthCell fileid, uint8_t * buf, int max);
+    void (*close_source)(EnforthCell fileid);
+
+    /* Optional incremental form of save.  SAVE calls save_range once
+     * for each run of dictionary pages that changed since the last
+     * successful SAVE (or LOAD), passing the offset and length of the
+     * run along with the extent of the image; storage beyond the extent
+     * is no longer part of the image.  save_range returns zero if the
+     * range could not be saved.  SAVE uses save_range instead of save
+     * when it is not NULL. */
+    int (*save_range)(const uint8_t * dictionary, int offset, int len, int extent);
+
+    /* Optional bulk form of emit.  When type is not NULL, output is
+     * collected in the VM's output buffer and handed to type a buffer
+     * (or, for long strings, a TYPE) at a time instead of one character
+     * at a time to emit. */
+    void (*type)(const char * text, int len);
+
+    /* Optional line-oriented input used by ACCEPT (and thus by REFILL
+     * and QUIT).  accept reads one line (without its line terminator,
+     * and truncated to max characters) into buf and returns the length
+     * of that line; the host is responsible for echoing and editing the
+     * line.  accept returns -1 at the end of the input, which makes
+     * the VM return to the host as if HALT had been called.  ACCEPT
+     * falls back to reading a KEY at a time when accept is NULL. */
+    int (*accept)(uint8_t * buf, int max);
+
+    /* Optional monotonic millisecond tick source used by TICKS, MS, and
+     * SLEEP-UNTIL.  The count is allowed to wrap around, which limits a
+     * single sleep to half of the range of an EnforthUnsigned.  MS and
+     * SLEEP-UNTIL just PAUSE when ticks is NULL. */
+    EnforthUnsigned (*ticks)(void);
+
+    /* Optional hook that is called when every task is asleep or
+     * blocked, with the number of ticks until the earliest wake time
+     * (the maximum unsigned value if no task is asleep).  The host can
+     * sleep the CPU for up to that long, or until it signals an event;
+     * idle returns zero to make enforth_resume return to the host
+     * instead.  Without an idle hook the scheduler polls the tick
+     * source, or returns to the host if every task is blocked. */
+    int (*idle)(EnforthUnsigned ticks);
+
+    /* Host events that have been signaled (with enforth_signal) but not
+     * yet delivered to a task blocked on them, one bit per event. */
+    volatile EnforthUnsigned signals;
+
+#if ENABLE_FFI_STATS
+    /* Optional clock used to measure FFI latency, in whatever units
+     * suit the host (microseconds, for example).  Only call counts are
+     * recorded when ffi_clock is NULL, which is how enforth_init leaves
+     * it. */
+    uint32_t (*ffi_clock)(void);
+#endif
+
     EnforthCell dictionary;
     EnforthCell dictionary_size;
 
@@ -166,13 +560,70 @@ typedef struct
     EnforthInt state;
     EnforthCell prev_leave;
 
-    /* TODO Put TIBSIZE in a constant. */
-    uint8_t tib[80];
     EnforthCell source_len;
     EnforthCell source;
     EnforthInt to_in;
+    EnforthCell source_id;
+    uint8_t source_depth;
 
     EnforthCell cur_task;
+
+    /* Preemptive time slicing.  A task is switched out (as if it had
+     * called PAUSE) after it has made time_slice calls and backward
+     * branches.  Tasks can therefore be switched out in the middle of
+     * most words, so tasks that share state (HERE, or the pictured
+     * numeric output buffer of the VM that runs them) need to
+     * coordinate.  enforth_init sets time_slice to zero, which disables
+     * preemption.  TIME-SLICE returns the address of this cell. */
+    EnforthUnsigned time_slice;
+
+    /* The event that the host signals when a key becomes available, or
+     * -1 (which is what enforth_init sets it to) if KEY should poll
+     * KEY? instead of blocking until the event is signaled. */
+    EnforthInt key_event;
+
+    /* Text Interpreter buffer.  TIB refers to this by a byte offset, so
+     * it comes before the fields (and buffers) that only the C code
+     * uses; 64-bit cells would otherwise push it beyond that range. */
+    uint8_t tib[ENFORTH_TIB_SIZE];
+
+    /* Dirty page tracking for SAVE */
+    uint8_t page_shift;
+    EnforthUnsigned saved_extent;
+
+    /* The number of ticks until the earliest sleeping task wakes up
+     * (the maximum unsigned value if no task is asleep), as of the last
+     * time that enforth_run returned kEnforthRunWaiting. */
+    EnforthUnsigned wait_ticks;
+
+    /* The VM whose dictionary a worker context (see
+     * enforth_init_worker) runs tasks from, or NULL if this is not a
+     * worker.  Workers take host events from, and record dirty pages
+     * in, their owner. */
+    struct EnforthVM * owner;
+
+    /* Non-zero while a thread is changing a mailbox; only the owner's
+     * lock is used. */
+    uint8_t mailbox_lock;
+
+#if ENABLE_TRACING
+    /* Call depth shown in the inner interpreter's trace output. */
+    int trace_level;
+#endif
+
+    /* Saved input sources, the dirty page map, and the output buffers;
+     * these are at the end of the VM so that their size does not affect
+     * the offsets of the fields above. */
+    EnforthInputSource saved_sources[ENFORTH_MAX_SOURCE_DEPTH];
+    uint8_t line_buffers[ENFORTH_MAX_SOURCE_DEPTH][ENFORTH_TIB_SIZE];
+    uint8_t dirty_pages[ENFORTH_DIRTY_MAP_SIZE];
+    uint8_t output_len;
+    char output_buffer[ENFORTH_OUTPUT_BUFFER_SIZE];
+
+#ifndef __AVR__
+    /* Pictured numeric output buffer, which only worker contexts use. */
+    uint8_t hold[ENFORTH_HOLD_SIZE];
+#endif
 } EnforthVM;
 
 
@@ -194,15 +645,119 @@ void enforth_init(
 void enforth_reset(
         EnforthVM * const vm);
 
+/* Turns the used portion of the dictionary into an image (exactly as
+ * SAVE does, but without handing it to the host's save callback) and
+ * returns the image's size in bytes.  The image is the first that many
+ * bytes of vm->dictionary.ram; hosts can then share it between VMs
+ * with enforth_load_image. */
+EnforthUnsigned enforth_prepare_image(
+        EnforthVM * const vm);
+
+int enforth_load_image(
+        EnforthVM * const vm,
+        uint8_t * const image, int dictionary_size);
+
 void enforth_evaluate(
         EnforthVM * const vm, const char * const text);
 
+/* Prepares the operator task to evaluate text the next time that the
+ * VM runs, without running it; enforth_evaluate is
+ * enforth_begin_evaluate followed by enforth_resume.  Like
+ * enforth_evaluate, this must only be called when the VM has returned
+ * kEnforthRunHalted or kEnforthRunWaiting.  An operator task that was
+ * still waiting (for an asynchronous FFI, a host event, a mailbox, or a
+ * channel) stops waiting and evaluates text instead. */
+void enforth_begin_evaluate(
+        EnforthVM * const vm, const char * const text);
+
 void enforth_resume(
         EnforthVM * const vm);
 
+/* Runs the VM for at most slices task switches (or without a limit if
+ * slices is zero, in which case this is enforth_resume).  A task
+ * switch happens whenever a task calls PAUSE, waits, or uses up its
+ * time slice, so hosts that run untrusted code with a budget should
+ * also set time_slice.  Budgeted runs never call the idle hook: they
+ * return kEnforthRunWaiting as soon as every task is waiting, with the
+ * time until the earliest sleeping task wakes up in wait_ticks.
+ * kEnforthRunYielded means that the budget ran out while tasks were
+ * still runnable; call enforth_run again to continue. */
+EnforthRunResult enforth_run(
+        EnforthVM * const vm, EnforthUnsigned slices);
+
+/* Initializes worker as a worker context for vm, which must already be
+ * initialized and must outlive the worker.  enforth_run(worker, ...)
+ * then runs vm's tasks (other than the operator task) on the calling
+ * thread, alongside vm itself and any other workers, and returns
+ * kEnforthRunWaiting when none of the tasks that the worker could run
+ * are runnable.  Initialize every worker before running vm or any of
+ * its workers.  The worker uses vm's callbacks (emit, type, ticks, and
+ * so on), which must therefore be thread-safe, but has its own output
+ * buffer, TIME-SLICE, and pictured numeric output. */
+void enforth_init_worker(
+        EnforthVM * const worker, EnforthVM * const vm);
+
 void enforth_go(
         EnforthVM * const vm);
 
+/* Completes the asynchronous FFI call identified by handle, pushing
+ * result onto the stack of the task that is waiting for it and making
+ * that task runnable again.  Returns zero if no task is waiting for
+ * the handle.  enforth_resume returns when every task is waiting, so
+ * hosts typically complete their outstanding operations and then call
+ * enforth_resume again.
+ *
+ * The task only starts waiting once the FFI function has returned the
+ * handle, so an operation that finishes on another thread before then
+ * cannot be completed yet: enforth_complete returns zero, and the host
+ * has to try again later (after enforth_run returns, for example, which
+ * is when EnforthExecutor applies its completions).  enforth_complete
+ * waits for the task to finish switching out, and so must never be
+ * called from an interrupt handler; use enforth_signal or a channel
+ * there instead. */
+int enforth_complete(
+        EnforthVM * const vm,
+        const EnforthCell handle, const EnforthCell result);
+
+/* Initializes a channel that holds up to capacity messages in slots.
+ * Returns zero if capacity is not a power of two. */
+int enforth_init_channel(
+        EnforthChannel * const channel,
+        EnforthCell * const slots, const EnforthUnsigned capacity);
+
+/* Sends message to the task that receives from the channel, returning
+ * zero if the channel is full.  This can be called from any thread, or
+ * from an interrupt handler, while the VM is running, but only by one
+ * of them at a time.  Like enforth_signal, hosts whose idle hook is
+ * waiting need to wake it up themselves, and hosts that enforth_run
+ * returned kEnforthRunWaiting to need to run the VM again. */
+int enforth_channel_send(
+        EnforthChannel * const channel, const EnforthCell message);
+
+/* Signals a host event (0 to one less than the number of bits in a
+ * cell), making the next task that the scheduler finds blocked on the
+ * event (with BLOCK-ON) runnable again.  The signal is remembered until
+ * a task blocks on the event.  enforth_signal can be called from
+ * another thread or from an interrupt handler (unlike
+ * enforth_complete, which waits for the task and so must not be);
+ * hosts whose idle hook is waiting need to wake it up themselves, and
+ * hosts that enforth_resume returned to need to call enforth_resume
+ * again. */
+void enforth_signal(
+        EnforthVM * const vm, const EnforthUnsigned event);
+
+#if ENABLE_FFI_STATS
+/* Returns the call statistics for an FFI (use GET_LAST_FFI(name) to
+ * get the FFI definition). */
+const EnforthFFIStats * enforth_ffi_stats(
+        const EnforthFFIDef * const ffidef);
+
+/* Clears the call statistics of all of the VM's FFIs, including the
+ * calls made by other VMs that use the same FFIs. */
+void enforth_clear_ffi_stats(
+        EnforthVM * const vm);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,7 @@ ENFORTH_EXTERN_VOID(digitalWrite, digitalWrite, 2)
 #undef LAST_FFI
 #define LAST_FFI GET_LAST_FFI(digitalWrite)
 
-ENFORTH_EXTERN_METHOD(millis, { return (unsigned)millis(); }, 0)
+ENFORTH_EXTERN_DOUBLE(millis, millis, 0)
 #undef LAST_FFI
 #define LAST_FFI GET_LAST_FFI(millis)
 
@@ -16,6 +16,19 @@ ENFORTH_EXTERN_VOID(pinMode, pinMode, 2)
 #undef LAST_FFI
 #define LAST_FFI GET_LAST_FFI(pinMode)
 
+ENFORTH_EXTERN_DOUBLE_ARGS(random, random, 1)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(random)
+
+ENFORTH_EXTERN_VOID_DOUBLE_ARGS(randomSeed, randomSeed, 1)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(randomSeed)
+
+// Frequently-used FFIs are ROM FFI words so that they do not need USE:
+// (and do not consume any dictionary space).
+#define BLINK_ROM_FFIS(X) X(digitalWrite) X(pinMode)
+ENFORTH_ROM_FFIS(kBlinkROMFFIs, BLINK_ROM_FFIS)
+
 
 // FFI definitions for tests.
 static int twoSeven()
@@ -102,6 +115,28 @@ int eepromSave(uint8_t * dictionary, int size)
   return -1;
 }
 
+int eepromSaveRange(const uint8_t * dictionary, int offset, int len, int extent)
+{
+  if (extent > 1024)
+  {
+    return 0;
+  }
+
+  /* Only the changed range is written, which saves EEPROM wear. */
+  for (int i = offset; i < offset + len; i++)
+  {
+    EEPROM.update(i, dictionary[i]);
+  }
+
+  return -1;
+}
+
+EnforthUnsigned millisTicks()
+{
+  /* Only the low cell is needed; the scheduler handles wrap-around. */
+  return (EnforthUnsigned)millis();
+}
+
 EnforthVM enforthVM;
 unsigned char enforthDict[1024];
 
@@ -117,13 +152,13 @@ void setup()
     LAST_FFI,
     serialKeyQ, serialKey, serialEmit,
     eepromLoad, eepromSave);
+  enforthVM.rom_ffis = kBlinkROMFFIs;
+  enforthVM.save_range = eepromSaveRange;
+  enforthVM.ticks = millisTicks;
 
   /* Add a couple of definitions. */
   enforth_evaluate(&enforthVM, ": favnum 27 ;");
   enforth_evaluate(&enforthVM, ": 2x dup + ;");
-
-  /* Define the FACILITY-EXT word MS in terms of the FFI `millis`. */
-  enforth_evaluate(&enforthVM, "USE: millis  : MS 1- millis BEGIN PAUSE 2DUP millis SWAP - < UNTIL 2DROP ;");
 }
 
 void loop()
@@ -0,0 +1,408 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* C++ includes. */
+#include <algorithm>
+#include <chrono>
+
+/* Enforth includes. */
+#include "enforthexecutor.h"
+
+
+
+/* -------------------------------------
+ * Jobs.
+ */
+
+/* A job moves between these states as it is queued, run, and parked.
+ * wake only has to queue parked jobs; a job that is woken while it is
+ * running is queued again by its worker instead of being parked. */
+enum
+{
+    kJobParked,
+    kJobQueued,
+    kJobRunning,
+    kJobRunningWoken,
+    kJobHalted
+};
+
+struct EnforthExecutor::Job
+{
+    explicit Job(EnforthVM * vm) : vm(vm), state(kJobQueued) {}
+
+    EnforthVM * const vm;
+    std::atomic<int> state;
+
+    /* FFI completions waiting to be applied by the next worker to run
+     * the VM. */
+    std::mutex lock;
+    std::vector<std::pair<EnforthCell, EnforthCell> > completions;
+};
+
+static uint64_t now_ms()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+/* -------------------------------------
+ * Public functions.
+ */
+
+EnforthExecutor::EnforthExecutor(
+        unsigned threads, HaltHandler on_halt,
+        EnforthUnsigned slices, EnforthUnsigned time_slice)
+    : mOnHalt(on_halt),
+      mSlices(slices != 0 ? slices : 1),
+      mTimeSlice(time_slice),
+      mNextWorker(0),
+      mQueued(0),
+      mSleeping(0),
+      mStopping(false),
+      mNextDeadline(UINT64_MAX)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /* Create all of the workers before starting any of them, since
+     * workers steal from each other. */
+    for (unsigned i = 0; i < threads; i++)
+    {
+        mWorkers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+
+    for (unsigned i = 0; i < threads; i++)
+    {
+        mWorkers[i]->thread = std::thread(&EnforthExecutor::run_worker, this, i);
+    }
+}
+
+EnforthExecutor::~EnforthExecutor()
+{
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mStopping = true;
+    }
+
+    mWork.notify_all();
+
+    for (size_t i = 0; i < mWorkers.size(); i++)
+    {
+        mWorkers[i]->thread.join();
+    }
+}
+
+void EnforthExecutor::submit(EnforthVM * vm, const char * text)
+{
+    if (text != NULL)
+    {
+        enforth_begin_evaluate(vm, text);
+    }
+
+    /* Budgets are only enforced between task switches, so every VM
+     * needs a time slice. */
+    if (vm->ticks == NULL)
+    {
+        vm->ticks = ticks;
+    }
+
+    if (vm->time_slice == 0)
+    {
+        vm->time_slice = mTimeSlice;
+    }
+
+    JobPtr job = std::make_shared<Job>(vm);
+    {
+        std::lock_guard<std::mutex> guard(mJobsLock);
+        mJobs[vm] = job;
+    }
+
+    enqueue(mNextWorker++ % mWorkers.size(), job);
+}
+
+void EnforthExecutor::signal(EnforthVM * vm, EnforthUnsigned event)
+{
+    enforth_signal(vm, event);
+    wake(vm);
+}
+
+void EnforthExecutor::complete(EnforthVM * vm, EnforthCell handle, EnforthCell result)
+{
+    JobPtr job = find_job(vm);
+    if (!job)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(job->lock);
+        job->completions.push_back(std::make_pair(handle, result));
+    }
+
+    wake_job(job);
+}
+
+void EnforthExecutor::wake(EnforthVM * vm)
+{
+    JobPtr job = find_job(vm);
+    if (job)
+    {
+        wake_job(job);
+    }
+}
+
+size_t EnforthExecutor::size()
+{
+    std::lock_guard<std::mutex> guard(mJobsLock);
+    return mJobs.size();
+}
+
+EnforthUnsigned EnforthExecutor::ticks()
+{
+    return (EnforthUnsigned)now_ms();
+}
+
+
+
+/* -------------------------------------
+ * Workers.
+ */
+
+void EnforthExecutor::run_worker(unsigned index)
+{
+    while (!mStopping)
+    {
+        if (mNextDeadline <= now_ms())
+        {
+            fire_timers();
+        }
+
+        JobPtr job = next_job(index);
+        if (job)
+        {
+            run_job(index, job);
+            continue;
+        }
+
+        /* Nothing to run; wait for a job to be queued or for the
+         * earliest timer.  mSleeping is raised before mQueued is checked
+         * so that enqueue either sees a sleeping worker or the worker
+         * sees the new job. */
+        std::unique_lock<std::mutex> guard(mLock);
+        mSleeping++;
+        while ((mQueued == 0) && !mStopping)
+        {
+            if (mTimers.empty())
+            {
+                mWork.wait(guard);
+            }
+            else if (mTimers.front().deadline <= now_ms())
+            {
+                break;
+            }
+            else
+            {
+                mWork.wait_until(guard,
+                    std::chrono::steady_clock::time_point(
+                        std::chrono::milliseconds(mTimers.front().deadline)));
+            }
+        }
+        mSleeping--;
+    }
+}
+
+EnforthExecutor::JobPtr EnforthExecutor::next_job(unsigned index)
+{
+    JobPtr job;
+
+    /* Run our own jobs in order, which bounds how long a runnable VM
+     * waits, and steal from the back of the other workers' deques. */
+    for (size_t i = 0; i < mWorkers.size(); i++)
+    {
+        Worker & worker = *mWorkers[(index + i) % mWorkers.size()];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (worker.jobs.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            job = worker.jobs.front();
+            worker.jobs.pop_front();
+        }
+        else
+        {
+            job = worker.jobs.back();
+            worker.jobs.pop_back();
+        }
+
+        mQueued--;
+        break;
+    }
+
+    return job;
+}
+
+void EnforthExecutor::run_job(unsigned index, const JobPtr & job)
+{
+    EnforthVM * const vm = job->vm;
+    int running = kJobRunning;
+
+    job->state = kJobRunning;
+
+    /* Apply the FFI completions that arrived while the VM was queued or
+     * parked. */
+    {
+        std::lock_guard<std::mutex> guard(job->lock);
+        for (size_t i = 0; i < job->completions.size(); i++)
+        {
+            enforth_complete(vm, job->completions[i].first, job->completions[i].second);
+        }
+
+        job->completions.clear();
+    }
+
+    switch (enforth_run(vm, mSlices))
+    {
+        case kEnforthRunYielded:
+            job->state = kJobQueued;
+            enqueue(index, job);
+            break;
+
+        case kEnforthRunWaiting:
+            /* Park the VM unless it was woken while it was running.  A
+             * timer that fires after the VM has been woken (or halted)
+             * is harmless. */
+            if (!job->state.compare_exchange_strong(running, kJobParked))
+            {
+                job->state = kJobQueued;
+                enqueue(index, job);
+            }
+            else if (vm->wait_ticks != ~(EnforthUnsigned)0)
+            {
+                std::lock_guard<std::mutex> guard(mLock);
+                mTimers.push_back(Timer());
+                mTimers.back().deadline = now_ms() + vm->wait_ticks;
+                mTimers.back().job = job;
+                std::push_heap(mTimers.begin(), mTimers.end());
+                mNextDeadline = mTimers.front().deadline;
+
+                /* Sleeping workers need to wait for the new deadline. */
+                if (mSleeping != 0)
+                {
+                    mWork.notify_one();
+                }
+            }
+            break;
+
+        case kEnforthRunHalted:
+            job->state = kJobHalted;
+            {
+                std::lock_guard<std::mutex> guard(mJobsLock);
+                mJobs.erase(vm);
+            }
+
+            if (mOnHalt)
+            {
+                mOnHalt(vm);
+            }
+            break;
+    }
+}
+
+void EnforthExecutor::enqueue(unsigned index, const JobPtr & job)
+{
+    Worker & worker = *mWorkers[index];
+    {
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.jobs.push_back(job);
+    }
+
+    mQueued++;
+    if (mSleeping != 0)
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mWork.notify_one();
+    }
+}
+
+void EnforthExecutor::wake_job(const JobPtr & job)
+{
+    int state = job->state;
+
+    for (;;)
+    {
+        switch (state)
+        {
+            case kJobParked:
+                if (job->state.compare_exchange_weak(state, kJobQueued))
+                {
+                    enqueue(mNextWorker++ % mWorkers.size(), job);
+                    return;
+                }
+                break;
+
+            case kJobRunning:
+                if (job->state.compare_exchange_weak(state, kJobRunningWoken))
+                {
+                    return;
+                }
+                break;
+
+            default:
+                return;
+        }
+    }
+}
+
+void EnforthExecutor::fire_timers()
+{
+    std::vector<JobPtr> due;
+
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        const uint64_t now = now_ms();
+        while (!mTimers.empty() && (mTimers.front().deadline <= now))
+        {
+            std::pop_heap(mTimers.begin(), mTimers.end());
+            due.push_back(mTimers.back().job);
+            mTimers.pop_back();
+        }
+
+        mNextDeadline = mTimers.empty() ? UINT64_MAX : mTimers.front().deadline;
+    }
+
+    for (size_t i = 0; i < due.size(); i++)
+    {
+        wake_job(due[i]);
+    }
+}
+
+EnforthExecutor::JobPtr EnforthExecutor::find_job(EnforthVM * vm)
+{
+    std::lock_guard<std::mutex> guard(mJobsLock);
+    std::unordered_map<EnforthVM *, JobPtr>::iterator it = mJobs.find(vm);
+    return it != mJobs.end() ? it->second : JobPtr();
+}
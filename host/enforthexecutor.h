@@ -0,0 +1,160 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ENFORTHEXECUTOR_H_
+#define ENFORTHEXECUTOR_H_
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* C++ includes. */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Enforth includes. */
+#include "enforth.h"
+
+
+
+/* -------------------------------------
+ * Enforth executor.
+ *
+ * Runs any number of VMs on a fixed pool of worker threads (hosted
+ * platforms only).  Each worker keeps a deque of runnable VMs and runs
+ * them one budget at a time with enforth_run, moving VMs that yielded
+ * to the back of its deque; idle workers steal VMs from the other
+ * workers' deques.  VMs whose tasks are all waiting are parked (they
+ * are not in any deque) until the host wakes them with signal,
+ * complete, or wake, or until their earliest sleeping task is due.
+ *
+ * The executor gives every VM that does not already have one a
+ * millisecond tick source and a time slice, so that MS works and so
+ * that a task that never pauses still gives up its worker at the end of
+ * each budget.  KEY only parks the VM if the host sets key_event (and
+ * signals it when input arrives); otherwise it keeps the VM runnable
+ * while it polls KEY?.
+ */
+
+class EnforthExecutor
+{
+public:
+    /* Called on a worker thread when a VM's operator task halts.  The
+     * VM is no longer part of the executor at that point and can be
+     * submitted again. */
+    typedef std::function<void(EnforthVM *)> HaltHandler;
+
+    /* Creates an executor with the given number of worker threads (the
+     * number of hardware threads if zero).  slices is the budget of
+     * task switches that a VM gets each time that it runs, and
+     * time_slice is the time slice given to VMs that do not set their
+     * own. */
+    EnforthExecutor(
+            unsigned threads = 0,
+            HaltHandler on_halt = HaltHandler(),
+            EnforthUnsigned slices = 8,
+            EnforthUnsigned time_slice = 1000);
+
+    /* Stops the workers once their current VMs have used up their
+     * budgets.  VMs that are still in the executor are left as they
+     * are (and can be run again with enforth_resume). */
+    ~EnforthExecutor();
+
+    /* Adds a VM to the executor, first preparing it to evaluate text if
+     * text is not NULL.  The VM must have been initialized and must not
+     * already be in the executor, and must not be used directly by the
+     * host until it halts.  submit sets the VM's ticks to ticks() if it
+     * is NULL and its time_slice to the executor's time slice if it is
+     * zero; the VM keeps those settings after it halts. */
+    void submit(EnforthVM * vm, const char * text = NULL);
+
+    /* Signals a host event (see enforth_signal) and wakes the VM. */
+    void signal(EnforthVM * vm, EnforthUnsigned event);
+
+    /* Completes an asynchronous FFI call (see enforth_complete) and wakes
+     * the VM.  The completion is applied by the worker that next runs
+     * the VM, so this can be called from any thread at any time. */
+    void complete(EnforthVM * vm, EnforthCell handle, EnforthCell result);
+
+    /* Makes a parked VM runnable (and does nothing if the VM is already
+     * runnable, or is not in the executor). */
+    void wake(EnforthVM * vm);
+
+    /* Returns the number of VMs in the executor. */
+    size_t size();
+
+    /* The millisecond tick source that the executor gives VMs. */
+    static EnforthUnsigned ticks();
+
+private:
+    struct Job;
+    typedef std::shared_ptr<Job> JobPtr;
+
+    struct Worker
+    {
+        std::mutex lock;
+        std::deque<JobPtr> jobs;
+        std::thread thread;
+    };
+
+    struct Timer
+    {
+        uint64_t deadline;
+        JobPtr job;
+
+        bool operator<(const Timer & other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
+    void run_worker(unsigned index);
+    JobPtr next_job(unsigned index);
+    void run_job(unsigned index, const JobPtr & job);
+    void enqueue(unsigned index, const JobPtr & job);
+    void wake_job(const JobPtr & job);
+    void fire_timers();
+    JobPtr find_job(EnforthVM * vm);
+
+    const HaltHandler mOnHalt;
+    const EnforthUnsigned mSlices;
+    const EnforthUnsigned mTimeSlice;
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::atomic<unsigned> mNextWorker;
+    std::atomic<size_t> mQueued;
+    std::atomic<unsigned> mSleeping;
+    std::atomic<bool> mStopping;
+
+    /* Protects the timers and is the lock that idle workers wait on. */
+    std::mutex mLock;
+    std::condition_variable mWork;
+    std::vector<Timer> mTimers;
+    std::atomic<uint64_t> mNextDeadline;
+
+    /* Maps VMs to their jobs for signal, complete, and wake. */
+    std::mutex mJobsLock;
+    std::unordered_map<EnforthVM *, JobPtr> mJobs;
+};
+
+#endif /* ENFORTHEXECUTOR_H_ */
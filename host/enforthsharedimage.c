@@ -0,0 +1,108 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/* Enforth includes. */
+#include "enforthsharedimage.h"
+
+
+
+/* -------------------------------------
+ * Public functions.
+ */
+
+int enforth_freeze_shared_image(
+        EnforthVM * const vm, EnforthSharedImage * const image)
+{
+    const char * tmpdir = getenv("TMPDIR");
+    char path[256];
+    const EnforthUnsigned extent = enforth_prepare_image(vm);
+
+    /* The image lives in an unlinked temporary file, so that it is
+     * released along with the last mapping of it. */
+    snprintf(path, sizeof(path), "%s/enforthXXXXXX", tmpdir != NULL ? tmpdir : "/tmp");
+    image->fd = mkstemp(path);
+    if (image->fd == -1)
+    {
+        return 0;
+    }
+
+    unlink(path);
+
+    if (write(image->fd, vm->dictionary.ram, extent) != (ssize_t)extent)
+    {
+        close(image->fd);
+        image->fd = -1;
+        return 0;
+    }
+
+    image->extent = extent;
+    return -1;
+}
+
+uint8_t * enforth_map_shared_image(
+        const EnforthSharedImage * const image, int dictionary_size)
+{
+    uint8_t * dictionary;
+
+    if ((image->fd == -1) || (image->extent > (EnforthUnsigned)dictionary_size))
+    {
+        return NULL;
+    }
+
+    /* Reserve the full dictionary and then map the image over the start
+     * of that region; the rest of the dictionary is private to the VM
+     * from the start. */
+    dictionary = (uint8_t *)mmap(NULL, dictionary_size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if ((dictionary == MAP_FAILED)
+        || (mmap(dictionary, image->extent, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, image->fd, 0) == MAP_FAILED))
+    {
+        if (dictionary != MAP_FAILED)
+        {
+            munmap(dictionary, dictionary_size);
+        }
+
+        return NULL;
+    }
+
+    return dictionary;
+}
+
+void enforth_unmap_shared_image(
+        uint8_t * const dictionary, int dictionary_size)
+{
+    munmap(dictionary, dictionary_size);
+}
+
+void enforth_release_shared_image(
+        EnforthSharedImage * const image)
+{
+    if (image->fd != -1)
+    {
+        close(image->fd);
+        image->fd = -1;
+    }
+}
@@ -0,0 +1,87 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ENFORTHSHAREDIMAGE_H_
+#define ENFORTHSHAREDIMAGE_H_
+
+/* Enforth includes. */
+#include "enforth.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* -------------------------------------
+ * Shared image types.
+ *
+ * A shared image is a frozen dictionary that any number of VMs can use
+ * as the base of their own dictionaries (POSIX hosts only).  Each VM
+ * maps the image copy-on-write: pages of the image that a VM never
+ * writes to (compiled code, mostly) are shared by every VM, and only the
+ * pages that a VM changes (its stacks, variables that it stores to, and
+ * its own definitions) take up memory of their own.  Dictionary
+ * addresses and XTs are the same in every VM, since all of them are
+ * relative to the start of the dictionary.
+ *
+ * Variables that are written by every VM should be defined together
+ * (or be allotted after the image is frozen) so that they do not turn
+ * the pages holding compiled code into private copies.
+ */
+
+typedef struct
+{
+    /* Unlinked file holding the image. */
+    int fd;
+
+    /* Size of the image in bytes. */
+    EnforthUnsigned extent;
+} EnforthSharedImage;
+
+
+
+/* -------------------------------------
+ * Functions definitions.
+ */
+
+/* Freezes the used portion of the VM's dictionary into a shared image.
+ * The VM must not be running (enforth_evaluate has returned, for
+ * example), and can continue to be used afterwards.  Returns zero if
+ * the image could not be created. */
+int enforth_freeze_shared_image(
+        EnforthVM * const vm, EnforthSharedImage * const image);
+
+/* Maps a new dictionary of dictionary_size bytes that begins with a
+ * copy-on-write view of the image, for use with enforth_load_image.
+ * Returns NULL if the image does not fit or cannot be mapped. */
+uint8_t * enforth_map_shared_image(
+        const EnforthSharedImage * const image, int dictionary_size);
+
+/* Unmaps a dictionary returned by enforth_map_shared_image. */
+void enforth_unmap_shared_image(
+        uint8_t * const dictionary, int dictionary_size);
+
+/* Releases the image; dictionaries that are still mapped keep their
+ * view of it. */
+void enforth_release_shared_image(
+        EnforthSharedImage * const image);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENFORTHSHAREDIMAGE_H_ */
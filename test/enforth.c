@@ -21,8 +21,13 @@
 /* ANSI C includes. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/select.h>
+#include <time.h>
 
 /* Curses includes. */
 #include <curses.h>
@@ -106,6 +111,13 @@ static void enforthCursesEmit(char ch)
     refresh();
 }
 
+static void enforthCursesType(const char * text, int len)
+{
+    /* Output the string and then refresh the screen once. */
+    addnstr(text, len);
+    refresh();
+}
+
 
 
 /* -------------------------------------
@@ -120,7 +132,8 @@ static int enforthLoad(uint8_t * dictionary, int size)
         return 0;
     }
 
-    if (read(fd, dictionary, size) != size)
+    /* Images only contain the used portion of the dictionary. */
+    if (read(fd, dictionary, size) <= 0)
     {
         close(fd);
         return 0;
@@ -150,6 +163,73 @@ static int enforthSave(uint8_t * dictionary, int size)
 
 
 
+/* -------------------------------------
+ * Mapped dictionary storage primitives.
+ *
+ * With -m the dictionary is a shared mapping of enforth.img, so every
+ * change to the dictionary is already a change to the image file.  LOAD
+ * only has to restart the image and SAVE only has to flush the pages
+ * that changed.
+ */
+
+/* RAM XTs are 14-bit offsets, so definitions cannot be located beyond
+ * the first 16KB of the dictionary. */
+#define kMaxMappedDictionarySize 16384
+
+static int enforthMappedLoad(uint8_t * dictionary, int size)
+{
+    /* The dictionary already contains the image (if it was ever
+     * saved). */
+    return ((EnforthImageHeader *)dictionary)->magic == kEnforthImageMagic ? -1 : 0;
+}
+
+static int enforthMappedSaveRange(const uint8_t * dictionary, int offset, int len, int extent)
+{
+    /* msync requires a page-aligned address. */
+    const int start = offset - (offset % sysconf(_SC_PAGESIZE));
+
+    return msync((void *)(dictionary + start), (offset + len) - start, MS_SYNC) == 0 ? -1 : 0;
+}
+
+/* Maps enforth.img as the dictionary, growing the file to size bytes if
+ * it is smaller than that.  A larger file (from an earlier run with a
+ * larger dictionary) keeps its size.  Returns NULL if the file could not
+ * be mapped, otherwise returns the mapping and its size. */
+static uint8_t * enforthMapDictionary(int * size)
+{
+    struct stat st;
+    uint8_t * dictionary;
+    int fd = open("enforth.img", O_RDWR|O_CREAT, 0644);
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    if (fstat(fd, &st) == -1)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    if (st.st_size > *size)
+    {
+        *size = st.st_size < kMaxMappedDictionarySize
+            ? st.st_size : kMaxMappedDictionarySize;
+    }
+    else if (ftruncate(fd, *size) == -1)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    dictionary = mmap(NULL, *size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return dictionary == MAP_FAILED ? NULL : dictionary;
+}
+
+
+
 /* -------------------------------------
  * Globals.
  */
@@ -159,12 +239,69 @@ static unsigned char enforthDict[512];
 
 
 
+/* -------------------------------------
+ * Enforth scheduler primitives.
+ */
+
+/* The event that is signaled when a key is available. */
+#define kKeyEvent 0
+
+static EnforthUnsigned enforthTicks(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (EnforthUnsigned)((now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
+
+/* Sleeps until a key is available or the next task wakes up, instead of
+ * spinning on getch(). */
+static int enforthIdle(EnforthUnsigned ticks)
+{
+    fd_set readfds;
+    struct timeval timeout;
+
+    FD_ZERO(&readfds);
+    FD_SET(STDIN_FILENO, &readfds);
+    timeout.tv_sec = ticks / 1000;
+    timeout.tv_usec = (ticks % 1000) * 1000;
+
+    if (select(STDIN_FILENO + 1, &readfds, NULL, NULL,
+            ticks == ~(EnforthUnsigned)0 ? NULL : &timeout) > 0)
+    {
+        enforth_signal(&enforthVM, kKeyEvent);
+    }
+
+    return -1;
+}
+
+
+
 /* -------------------------------------
  * main()
  */
 
 int main(int argc, char **argv)
 {
+    uint8_t * mappedDict = NULL;
+    int mappedDictSize = kMaxMappedDictionarySize;
+
+    /* "-m [size]" uses a dictionary that is mapped from enforth.img. */
+    if ((argc > 1) && (strcmp(argv[1], "-m") == 0))
+    {
+        if ((argc > 2) && (atoi(argv[2]) > 0))
+        {
+            mappedDictSize = atoi(argv[2]) < kMaxMappedDictionarySize
+                ? atoi(argv[2]) : kMaxMappedDictionarySize;
+        }
+
+        mappedDict = enforthMapDictionary(&mappedDictSize);
+        if (mappedDict == NULL)
+        {
+            perror("enforth.img");
+            return 1;
+        }
+    }
+
     /* Initialize curses: disable line buffering and local echo, enable
      * line-oriented scrolling, do not block during reads. */
     initscr();
@@ -182,9 +319,33 @@ int main(int argc, char **argv)
             enforthCursesKeyQuestion, enforthCursesKey, enforthCursesEmit,
             enforthLoad, enforthSave);
 
-    /* Add a couple of definitions. */
-    enforth_evaluate(&enforthVM, ": favnum 27 ;");
-    enforth_evaluate(&enforthVM, ": 2x dup + ;");
+    /* Boot from the mapped image if it contains one.  Otherwise start
+     * with a new dictionary in the mapping (or in memory without -m),
+     * to which we add a couple of definitions. */
+    enforthVM.type = enforthCursesType;
+    enforthVM.ticks = enforthTicks;
+    enforthVM.idle = enforthIdle;
+    enforthVM.key_event = kKeyEvent;
+
+    if (mappedDict != NULL)
+    {
+        enforthVM.load = enforthMappedLoad;
+        enforthVM.save_range = enforthMappedSaveRange;
+    }
+
+    if ((mappedDict == NULL)
+        || !enforth_load_image(&enforthVM, mappedDict, mappedDictSize))
+    {
+        if (mappedDict != NULL)
+        {
+            enforthVM.dictionary.ram = mappedDict;
+            enforthVM.dictionary_size.u = mappedDictSize;
+            enforth_reset(&enforthVM);
+        }
+
+        enforth_evaluate(&enforthVM, ": favnum 27 ;");
+        enforth_evaluate(&enforthVM, ": 2x dup + ;");
+    }
 
     /* Launch the enforth interpreter. */
     enforth_go(&enforthVM);
@@ -0,0 +1,195 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* Measures the executor with many VMs:
+ *
+ * - Throughput: the time taken by 1..N worker threads to run a script
+ *   that mixes computation and PAUSE in every VM.
+ * - Latency: the time from signaling a blocked VM to that VM halting,
+ *   while the executor is busy with VMs that never stop running.
+ *
+ * Usage: enforthexecbench [vms] */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* C++ includes. */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/* Enforth includes. */
+#include "enforth.h"
+#include "enforthexecutor.h"
+
+
+
+/* -------------------------------------
+ * Benchmark VMs.
+ */
+
+struct BenchVM
+{
+    EnforthVM vm;
+    unsigned char dictionary[2048];
+};
+
+static int enforthBenchKeyQuestion(void)
+{
+    return 0;
+}
+
+static char enforthBenchKey(void)
+{
+    return '\n';
+}
+
+static void enforthBenchEmit(char ch)
+{
+}
+
+static void init_bench_vm(BenchVM & benchVM)
+{
+    enforth_init(
+            &benchVM.vm,
+            benchVM.dictionary, sizeof(benchVM.dictionary),
+            NULL,
+            enforthBenchKeyQuestion, enforthBenchKey, enforthBenchEmit,
+            NULL, NULL);
+}
+
+static double now()
+{
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void wait_for(std::atomic<int> & count, int expected)
+{
+    while (count < expected)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+
+
+/* -------------------------------------
+ * Benchmarks.
+ */
+
+static double time_throughput(std::vector<BenchVM> & vms, unsigned threads)
+{
+    std::atomic<int> halted(0);
+    EnforthExecutor executor(threads, [&](EnforthVM *) { halted++; });
+
+    for (size_t i = 0; i < vms.size(); i++)
+    {
+        init_bench_vm(vms[i]);
+    }
+
+    const double start = now();
+    for (size_t i = 0; i < vms.size(); i++)
+    {
+        executor.submit(&vms[i].vm, ": W 0 20000 0 DO I XOR 1+ I 63 AND 0= IF PAUSE THEN LOOP ; W");
+    }
+
+    wait_for(halted, vms.size());
+    return now() - start;
+}
+
+static void measure_latency(std::vector<BenchVM> & vms, unsigned threads)
+{
+    const int kPings = 200;
+    std::vector<BenchVM> pings(kPings);
+    std::vector<double> latencies;
+    std::atomic<int> halted(0);
+    EnforthExecutor executor(threads, [&](EnforthVM *) { halted++; });
+
+    /* Keep every worker busy. */
+    for (size_t i = 0; i < vms.size(); i++)
+    {
+        init_bench_vm(vms[i]);
+        executor.submit(&vms[i].vm, ": SPIN BEGIN AGAIN ; SPIN");
+    }
+
+    for (int i = 0; i < kPings; i++)
+    {
+        init_bench_vm(pings[i]);
+        executor.submit(&pings[i].vm, "3 BLOCK-ON");
+    }
+
+    /* Give the ping VMs a chance to block before timing them. */
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    for (int i = 0; i < kPings; i++)
+    {
+        const double start = now();
+        executor.signal(&pings[i].vm, 3);
+        wait_for(halted, i + 1);
+        latencies.push_back(now() - start);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    printf("%7u  %9zu  %8.3f  %8.3f  %8.3f\n",
+            threads, vms.size(),
+            latencies[kPings / 2] * 1000,
+            latencies[(kPings * 99) / 100] * 1000,
+            latencies[kPings - 1] * 1000);
+
+    /* The spinning VMs are abandoned (not resumed) when the executor
+     * is destroyed. */
+}
+
+
+
+/* -------------------------------------
+ * Main entry point.
+ */
+
+int main(int argc, char * argv[])
+{
+    const int numVMs = argc > 1 ? atoi(argv[1]) : 2000;
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<BenchVM> vms(numVMs > 0 ? numVMs : 1);
+
+    printf("Throughput (%zu VMs)\n", vms.size());
+    printf("Threads   Seconds   Speedup\n");
+    const double single = time_throughput(vms, 1);
+    printf("%7u  %8.3f  %8.2f\n", 1u, single, 1.0);
+    for (unsigned threads = 2; threads <= maxThreads; threads *= 2)
+    {
+        const double elapsed = time_throughput(vms, threads);
+        printf("%7u  %8.3f  %8.2f\n", threads, elapsed, single / elapsed);
+    }
+
+    printf("\nWake latency in ms, with busy VMs\n");
+    printf("Threads   Busy VMs       p50       p99       max\n");
+    for (size_t busy = std::max((size_t)1, vms.size() / 4); busy <= vms.size(); busy *= 2)
+    {
+        std::vector<BenchVM> busyVMs(vms.begin(), vms.begin() + busy);
+        measure_latency(busyVMs, maxThreads);
+    }
+
+    return 0;
+}
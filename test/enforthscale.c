@@ -0,0 +1,154 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* Measures how Enforth scales across threads: the same CPU-bound word
+ * is run in 1..N independent VMs, one thread per VM, and the aggregate
+ * throughput is compared to that of a single VM.  VMs share nothing but
+ * the ROM definitions, so the speedup should track the number of cores.
+ *
+ * Usage: enforthscale [max-vms] */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* Enforth includes. */
+#include "enforth.h"
+
+
+
+/* -------------------------------------
+ * Benchmark.
+ */
+
+#define MAX_VMS 64
+
+/* Each VM runs SPIN ITERATIONS times; SPIN is a tight loop of the
+ * primitives that dominate typical Forth code. */
+#define ITERATIONS "20"
+static const char kBenchmark[] =
+    ": SPIN 0 100000 0 DO I XOR 1+ DUP 2* DROP LOOP DROP ; "
+    ": BENCH " ITERATIONS " 0 DO SPIN LOOP ;";
+
+typedef struct
+{
+    EnforthVM vm;
+    unsigned char dictionary[4096];
+    pthread_t thread;
+} BenchVM;
+
+static BenchVM benchVMs[MAX_VMS];
+
+static int enforthScaleKeyQuestion(void)
+{
+    return -1;
+}
+
+static char enforthScaleKey(void)
+{
+    return '\n';
+}
+
+static void enforthScaleEmit(char ch)
+{
+    putchar(ch);
+}
+
+static void * run_benchmark(void * arg)
+{
+    enforth_evaluate(&((BenchVM *)arg)->vm, "BENCH");
+    return NULL;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/* Returns the wall-clock time taken by n VMs to run the benchmark. */
+static double time_vms(int n)
+{
+    double start;
+
+    for (int i = 0; i < n; i++)
+    {
+        memset(&benchVMs[i], 0, sizeof(benchVMs[i]));
+        enforth_init(
+                &benchVMs[i].vm,
+                benchVMs[i].dictionary, sizeof(benchVMs[i].dictionary),
+                NULL,
+                enforthScaleKeyQuestion, enforthScaleKey, enforthScaleEmit,
+                NULL, NULL);
+        enforth_evaluate(&benchVMs[i].vm, kBenchmark);
+    }
+
+    start = now();
+    for (int i = 0; i < n; i++)
+    {
+        pthread_create(&benchVMs[i].thread, NULL, run_benchmark, &benchVMs[i]);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        pthread_join(benchVMs[i].thread, NULL);
+    }
+
+    return now() - start;
+}
+
+
+
+/* -------------------------------------
+ * Main entry point.
+ */
+
+int main(int argc, char * argv[])
+{
+    int maxVMs = argc > 1 ? atoi(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+    double single;
+
+    if (maxVMs < 1)
+    {
+        maxVMs = 1;
+    }
+
+    if (maxVMs > MAX_VMS)
+    {
+        maxVMs = MAX_VMS;
+    }
+
+    printf("VMs   Seconds   Speedup\n");
+    single = time_vms(1);
+    printf("%3d  %8.3f  %8.2f\n", 1, single, 1.0);
+
+    for (int n = 2; n <= maxVMs; n++)
+    {
+        double elapsed = time_vms(n);
+        printf("%3d  %8.3f  %8.2f\n", n, elapsed, (n * single) / elapsed);
+    }
+
+    return 0;
+}
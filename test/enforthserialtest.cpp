@@ -43,6 +43,15 @@ typedef int EnforthVM;
 extern "C" EnforthVM * const get_test_vm();
 extern "C" void enforth_evaluate(EnforthVM * const vm, const char * const text);
 extern "C" bool enforth_test(EnforthVM * const vm, const char * const text);
+extern "C" void relocate_test_vm(EnforthVM * const vm);
+extern "C" bool load_test_image(EnforthVM * const vm);
+extern "C" bool type_test_keys(EnforthVM * const vm, const char * const keys);
+extern "C" bool complete_test_ffi(EnforthVM * const vm, int handle, int result);
+extern "C" bool enforth_test_result(EnforthVM * const vm);
+extern "C" void signal_test_event(EnforthVM * const vm, int event);
+extern "C" bool check_test_ffi_stats(unsigned calls, unsigned total_time, int bucket);
+extern "C" bool check_test_output(EnforthVM * const vm, const char * const text, const char * const expected);
+extern "C" bool check_test_abort(EnforthVM * const vm, const char * const text);
 
 
 
@@ -554,11 +563,63 @@ void enforth_evaluate(EnforthVM * const vm, const char * const text)
 	}
 }
 
+void relocate_test_vm(EnforthVM * const vm)
+{
+	/* The dictionary cannot be moved on the target. */
+}
+
+bool load_test_image(EnforthVM * const vm)
+{
+	/* The target only loads images with LOAD. */
+	return false;
+}
+
+bool type_test_keys(EnforthVM * const vm, const char * const keys)
+{
+	/* The target reads its keys from the serial port. */
+	return false;
+}
+
+bool complete_test_ffi(EnforthVM * const vm, int handle, int result)
+{
+	/* The target has no asynchronous FFIs. */
+	return false;
+}
+
+void signal_test_event(EnforthVM * const vm, int event)
+{
+	/* The target has no host events. */
+}
+
+bool check_test_ffi_stats(unsigned calls, unsigned total_time, int bucket)
+{
+	/* FFI statistics are not available on the target. */
+	return false;
+}
+
+bool check_test_output(EnforthVM * const vm, const char * const text, const char * const expected)
+{
+	/* The target's output is not captured. */
+	return false;
+}
+
+bool check_test_abort(EnforthVM * const vm, const char * const text)
+{
+	/* The target keeps running QUIT after an ABORT. */
+	return false;
+}
+
 bool enforth_test(EnforthVM * const vm, const char * const text)
 {
     /* Run the test. */
     enforth_evaluate(vm, text);
 
+    /* Check the result. */
+    return enforth_test_result(vm);
+}
+
+bool enforth_test_result(EnforthVM * const vm)
+{
 	/* Read to the "ok " prompt. */
 	ReadToOkPrompt(*vm);
 
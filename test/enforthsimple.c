@@ -21,8 +21,11 @@
 /* ANSI C includes. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* Enforth includes. */
 #include "enforth.h"
@@ -82,6 +85,36 @@ static void enforthSimpleEmit(char ch)
     putchar(ch);
 }
 
+static void enforthSimpleType(const char * text, int len)
+{
+    fwrite(text, 1, len, stdout);
+}
+
+static int enforthSimpleAccept(uint8_t * buf, int max)
+{
+    int len = 0;
+    int c;
+
+    /* Report the end of the input so that the VM returns from
+     * enforth_go and piped scripts terminate.  Characters past the end
+     * of the buffer are discarded. */
+    fflush(stdout);
+    while (((c = getchar()) != EOF) && (c != '\n'))
+    {
+        if (len < max)
+        {
+            buf[len++] = c;
+        }
+    }
+
+    if ((c == EOF) && (len == 0))
+    {
+        return -1;
+    }
+
+    return len;
+}
+
 
 
 /* -------------------------------------
@@ -96,7 +129,8 @@ static int enforthLoad(uint8_t * dictionary, int size)
         return 0;
     }
 
-    if (read(fd, dictionary, size) != size)
+    /* Images only contain the used portion of the dictionary. */
+    if (read(fd, dictionary, size) <= 0)
     {
         close(fd);
         return 0;
@@ -126,6 +160,113 @@ static int enforthSave(uint8_t * dictionary, int size)
 
 
 
+/* Writes one changed range of the dictionary into the image file, which
+ * is then truncated to the extent of the image. */
+static int enforthSaveRange(const uint8_t * dictionary, int offset, int len, int extent)
+{
+    int fd = open("enforthsimple.img", O_WRONLY|O_CREAT, 0644);
+    if (fd == -1)
+    {
+        return 0;
+    }
+
+    if ((pwrite(fd, dictionary + offset, len, offset) != len)
+        || (ftruncate(fd, extent) == -1))
+    {
+        close(fd);
+        return 0;
+    }
+
+    close(fd);
+    return -1;
+}
+
+/* Maps a previously-saved image into memory so that the VM can boot from
+ * it without copying it into the dictionary.  The mapping is private, so
+ * new definitions are not written back to the file until SAVE is used.
+ * Returns NULL if there is no image. */
+static uint8_t * enforthMapImage(int size)
+{
+    struct stat st;
+    uint8_t * image;
+    int fd = open("enforthsimple.img", O_RDONLY);
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    if ((fstat(fd, &st) == -1) || (st.st_size == 0) || (st.st_size > size))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    /* Reserve the full dictionary and then map the image over the start
+     * of that region. */
+    image = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if ((image == MAP_FAILED)
+        || (mmap(image, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fd, 0) == MAP_FAILED))
+    {
+        if (image != MAP_FAILED)
+        {
+            munmap(image, size);
+        }
+
+        close(fd);
+        return NULL;
+    }
+
+    close(fd);
+    return image;
+}
+
+
+
+/* -------------------------------------
+ * Enforth source provider.
+ */
+
+static EnforthCell enforthOpenSource(const uint8_t * name, int len)
+{
+    char path[256];
+    EnforthCell fileid;
+
+    fileid.ram = NULL;
+    if (len < (int)sizeof(path))
+    {
+        memcpy(path, name, len);
+        path[len] = '\0';
+        fileid.ram = (uint8_t *)fopen(path, "r");
+    }
+
+    return fileid;
+}
+
+static int enforthReadLine(EnforthCell fileid, uint8_t * buf, int max)
+{
+    FILE * const f = (FILE *)fileid.ram;
+    int len = 0;
+    int c;
+
+    /* Characters past the end of the buffer are discarded. */
+    while (((c = getc(f)) != EOF) && (c != '\n'))
+    {
+        if (len < max)
+        {
+            buf[len++] = c;
+        }
+    }
+
+    return ((c == EOF) && (len == 0)) ? -1 : len;
+}
+
+static void enforthCloseSource(EnforthCell fileid)
+{
+    fclose((FILE *)fileid.ram);
+}
+
+
+
 /* -------------------------------------
  * Globals.
  */
@@ -140,6 +281,8 @@ static unsigned char enforthDict[512];
 
 int main(int argc, char **argv)
 {
+    uint8_t * image;
+
     /* Initialize Enforth. */
     enforth_init(
             &enforthVM,
@@ -148,10 +291,35 @@ int main(int argc, char **argv)
             enforthSimpleKeyQuestion, enforthSimpleKey, enforthSimpleEmit,
             enforthLoad, enforthSave);
 
-    /* Add a couple of definitions (one of which is multiline). */
-    enforth_evaluate(&enforthVM, ": favnum 27 ;");
-    enforth_evaluate(&enforthVM, ": 2x dup");
-    enforth_evaluate(&enforthVM, "     + ;");
+    /* Allow INCLUDE and INCLUDED to load source files. */
+    enforthVM.open_source = enforthOpenSource;
+    enforthVM.read_line = enforthReadLine;
+    enforthVM.close_source = enforthCloseSource;
+
+    /* Write output a buffer at a time and read input a line at a
+     * time. */
+    enforthVM.type = enforthSimpleType;
+    enforthVM.accept = enforthSimpleAccept;
+
+    /* Only write the parts of the image that changed. */
+    enforthVM.save_range = enforthSaveRange;
+
+    /* Boot from the saved image if there is one (which will run its
+     * TURNKEY word), otherwise add a couple of definitions (one of
+     * which is multiline). */
+    image = enforthMapImage(sizeof(enforthDict));
+    if ((image == NULL)
+        || !enforth_load_image(&enforthVM, image, sizeof(enforthDict)))
+    {
+        if (image != NULL)
+        {
+            munmap(image, sizeof(enforthDict));
+        }
+
+        enforth_evaluate(&enforthVM, ": favnum 27 ;");
+        enforth_evaluate(&enforthVM, ": 2x dup");
+        enforth_evaluate(&enforthVM, "     + ;");
+    }
 
     /* Launch the Enforth interpreter. */
     enforth_go(&enforthVM);
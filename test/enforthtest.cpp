@@ -20,6 +20,7 @@
 
 /* ANSI C includes. */
 #include <stdio.h>
+#include <string.h>
 
 /* Enforth includes. */
 #include "enforth.h"
@@ -40,6 +41,15 @@
 extern "C" EnforthVM * const get_test_vm();
 extern "C" void enforth_evaluate(EnforthVM * const vm, const char * const text);
 extern "C" bool enforth_test(EnforthVM * const vm, const char * const text);
+extern "C" void relocate_test_vm(EnforthVM * const vm);
+extern "C" bool load_test_image(EnforthVM * const vm);
+extern "C" bool type_test_keys(EnforthVM * const vm, const char * const keys);
+extern "C" bool complete_test_ffi(EnforthVM * const vm, int handle, int result);
+extern "C" bool enforth_test_result(EnforthVM * const vm);
+extern "C" void signal_test_event(EnforthVM * const vm, int event);
+extern "C" bool check_test_ffi_stats(unsigned calls, unsigned total_time, int bucket);
+extern "C" bool check_test_output(EnforthVM * const vm, const char * const text, const char * const expected);
+extern "C" bool check_test_abort(EnforthVM * const vm, const char * const text);
 
 
 
@@ -57,6 +67,40 @@ static int doubleNumber(int num)
     return num + num;
 }
 
+static int weightedSum(int a, int b, int c, int d, int e)
+{
+    return (a * 10000) + (b * 1000) + (c * 100) + (d * 10) + e;
+}
+
+static EnforthDoubleInt stashedDouble = ((EnforthDoubleInt)1 << (kEnforthCellSize * 8)) + 5;
+
+static EnforthDoubleInt fetchDouble()
+{
+    return stashedDouble;
+}
+
+static void stashDouble(EnforthDoubleInt d)
+{
+    stashedDouble = d;
+}
+
+/* Starts an asynchronous "read" of sensor n; the handle is $100+n, so
+ * the read of sensor -$100 cannot be started. */
+static int startRead(int n)
+{
+    return 0x100 + n;
+}
+
+static int addNumbers(int a, int b)
+{
+    return a + b;
+}
+
+static EnforthDoubleInt subtractDouble(EnforthDoubleInt d1, EnforthDoubleInt d2)
+{
+    return d1 - d2;
+}
+
 /* Externs */
 ENFORTH_EXTERN(twoseven, twoSeven, 0)
 #undef LAST_FFI
@@ -66,25 +110,227 @@ ENFORTH_EXTERN(dubnum, doubleNumber, 1)
 #undef LAST_FFI
 #define LAST_FFI GET_LAST_FFI(dubnum)
 
+ENFORTH_EXTERN(wsum, weightedSum, 5)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(wsum)
+
+ENFORTH_EXTERN_DOUBLE(dfetch, fetchDouble, 0)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(dfetch)
+
+ENFORTH_EXTERN_VOID_DOUBLE_ARGS(dstash, stashDouble, 1)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(dstash)
+
+ENFORTH_EXTERN_DOUBLE_ARGS(dsub, subtractDouble, 2)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(dsub)
+
+ENFORTH_EXTERN_ASYNC(aread, startRead, 1)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(aread)
+
+/* ROM FFI words; romadd is only available as a ROM FFI word. */
+ENFORTH_EXTERN(romadd, addNumbers, 2)
+
+#define TEST_ROM_FFIS(X) X(romadd) X(twoseven)
+ENFORTH_ROM_FFIS(kTestROMFFIs, TEST_ROM_FFIS)
+
 
 
 /* -------------------------------------
  * Enforth I/O primitives.
  */
 
+#if ENABLE_FFI_STATS
+/* Every FFI call takes exactly five ticks on this clock. */
+static uint32_t enforthTestClock(void)
+{
+    static uint32_t now = 0;
+    return now += 5;
+}
+#endif
+
+/* Simulated millisecond clock, which only advances while the VM idles;
+ * this keeps the sleep tests deterministic. */
+static EnforthUnsigned enforthTestTicks;
+
+static EnforthUnsigned enforthTicks(void)
+{
+    return enforthTestTicks;
+}
+
+static int enforthIdle(EnforthUnsigned ticks)
+{
+    /* Return to the test if every task is blocked on an event. */
+    if (ticks == ~(EnforthUnsigned)0)
+    {
+        return 0;
+    }
+
+    enforthTestTicks += ticks;
+    return -1;
+}
+
 static int enforthSimpleKeyQuestion(void)
 {
     return -1;
 }
 
+/* Keys queued by type_test_keys, which KEY reads before the console. */
+static const char * testKeys = NULL;
+
 static char enforthSimpleKey(void)
 {
+    if ((testKeys != NULL) && (*testKeys != '\0'))
+    {
+        return *testKeys++;
+    }
+
     return getchar();
 }
 
+/* Output captured by check_test_output; output goes to the console
+ * when testOutputLen is negative. */
+static char testOutput[256];
+static int testOutputLen = -1;
+
 static void enforthSimpleEmit(char ch)
 {
-    putchar(ch);
+    if (testOutputLen < 0)
+    {
+        putchar(ch);
+    }
+    else if (testOutputLen < (int)sizeof(testOutput) - 1)
+    {
+        testOutput[testOutputLen++] = ch;
+    }
+}
+
+static void enforthSimpleType(const char * text, int len)
+{
+    while (len-- > 0)
+    {
+        enforthSimpleEmit(*text++);
+    }
+}
+
+static int enforthSimpleAccept(uint8_t * buf, int max)
+{
+    /* The tests never read from the console, so ACCEPT always receives
+     * the same line. */
+    static const char line[] = "ACCEPTED";
+    const int lineLen = sizeof(line) - 1;
+    int len = lineLen < max ? lineLen : max;
+
+    memcpy(buf, line, len);
+    return len;
+}
+
+
+
+/* -------------------------------------
+ * Enforth storage primitives (an in-memory image for SAVE and LOAD).
+ */
+
+static uint8_t savedImage[8192];
+static int savedImageSize = 0;
+
+static int enforthLoad(uint8_t * dictionary, int size)
+{
+    if ((savedImageSize == 0) || (savedImageSize > size))
+    {
+        return 0;
+    }
+
+    memcpy(dictionary, savedImage, savedImageSize);
+    return -1;
+}
+
+static int enforthSaveRange(const uint8_t * dictionary, int offset, int len, int extent)
+{
+    if (extent > sizeof(savedImage))
+    {
+        return 0;
+    }
+
+    memcpy(savedImage + offset, dictionary + offset, len);
+    savedImageSize = extent;
+    return -1;
+}
+
+
+
+/* -------------------------------------
+ * Enforth source provider (in-memory sources for INCLUDED tests).
+ */
+
+static const struct
+{
+    const char * name;
+    const char * text;
+} kTestSources[] = {
+    { "gi1.fs", ": GI1 1 ;\n: GI2\n    GI1 1+ ;\n" },
+    { "gi2.fs", "INCLUDE gi1.fs  : GI3 GI2 1+ ;\n\n\\ Comment\n" },
+    { "gi3.fs", "SOURCE-ID\nREFILL" },
+    { "gi4.fs", "1                                                                               2\n3\n" },
+};
+
+/* Read position of each open source; fileid is the index plus one. */
+static const char * openSources[ENFORTH_MAX_SOURCE_DEPTH];
+
+static EnforthCell enforthOpenSource(const uint8_t * name, int len)
+{
+    EnforthCell fileid;
+    fileid.ram = NULL;
+
+    for (int i = 0; i < sizeof(kTestSources) / sizeof(kTestSources[0]); i++)
+    {
+        if ((strlen(kTestSources[i].name) != len)
+                || (memcmp(kTestSources[i].name, name, len) != 0))
+        {
+            continue;
+        }
+
+        for (int slot = 0; slot < ENFORTH_MAX_SOURCE_DEPTH; slot++)
+        {
+            if (openSources[slot] == NULL)
+            {
+                openSources[slot] = kTestSources[i].text;
+                fileid.u = slot + 1;
+                break;
+            }
+        }
+        break;
+    }
+
+    return fileid;
+}
+
+static int enforthReadLine(EnforthCell fileid, uint8_t * buf, int max)
+{
+    const char * p = openSources[fileid.u - 1];
+    if (*p == '\0')
+    {
+        return -1;
+    }
+
+    int len = 0;
+    for (; (*p != '\0') && (*p != '\n'); p++)
+    {
+        if (len < max)
+        {
+            buf[len++] = *p;
+        }
+    }
+
+    openSources[fileid.u - 1] = *p == '\n' ? p + 1 : p;
+    return len;
+}
+
+static void enforthCloseSource(EnforthCell fileid)
+{
+    openSources[fileid.u - 1] = NULL;
 }
 
 
@@ -110,7 +356,23 @@ EnforthVM * const get_test_vm()
             enforthDict, sizeof(enforthDict),
             LAST_FFI,
             enforthSimpleKeyQuestion, enforthSimpleKey, enforthSimpleEmit,
-            NULL, NULL);
+            enforthLoad, NULL);
+
+    enforthVM.rom_ffis = kTestROMFFIs;
+#if ENABLE_FFI_STATS
+    enforthVM.ffi_clock = enforthTestClock;
+    enforth_clear_ffi_stats(&enforthVM);
+#endif
+    enforthVM.open_source = enforthOpenSource;
+    enforthVM.read_line = enforthReadLine;
+    enforthVM.close_source = enforthCloseSource;
+    enforthVM.type = enforthSimpleType;
+    enforthVM.accept = enforthSimpleAccept;
+    enforthVM.save_range = enforthSaveRange;
+    enforthVM.ticks = enforthTicks;
+    enforthVM.idle = enforthIdle;
+    enforthTestTicks = 0;
+    testKeys = NULL;
 
     /* Compile the tester words. */
     compile_tester(&enforthVM);
@@ -122,53 +384,133 @@ EnforthVM * const get_test_vm()
     return &enforthVM;
 }
 
-static EnforthCell enforth_push(EnforthVM * const vm, const EnforthCell cell)
+void relocate_test_vm(EnforthVM * const vm)
 {
-    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
-    EnforthCell * sp = (EnforthCell*)(saved_sp->ram);
+    /* Globals. */
+    static unsigned char relocatedDicts[2][8192];
+    static int nextDict = 0;
+
+    /* Copy the dictionary to the other buffer and then trash the old
+     * dictionary, which ensures that any absolute addresses into the
+     * dictionary will fail. */
+    uint8_t * const newDict = relocatedDicts[nextDict];
+    nextDict ^= 1;
 
-    *(--sp) = cell;
+    memcpy(newDict, vm->dictionary.ram, vm->dictionary_size.u);
+    memset(vm->dictionary.ram, 0xff, vm->dictionary_size.u);
 
-    saved_sp->ram = (uint8_t*)sp;
+    vm->cur_task.ram = newDict + (vm->cur_task.ram - vm->dictionary.ram);
+    vm->dictionary.ram = newDict;
 }
 
-static EnforthCell enforth_pop(EnforthVM * const vm)
+bool load_test_image(EnforthVM * const vm)
 {
-    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
-    EnforthCell * sp = (EnforthCell*)(saved_sp->ram);
-
-    EnforthCell tos = *sp++;
+    /* Load the image that SAVE left in the dictionary in place (as a
+     * host that maps its image would) and then let the VM run until
+     * the turnkey word halts. */
+    if (!enforth_load_image(vm, vm->dictionary.ram, vm->dictionary_size.u))
+    {
+        return false;
+    }
 
-    saved_sp->ram = (uint8_t*)sp;
+    enforth_resume(vm);
+    return true;
+}
 
-    return tos;
+bool type_test_keys(EnforthVM * const vm, const char * const keys)
+{
+    /* Remove the accept callback so that ACCEPT reads the keys a KEY at
+     * a time (for the rest of the test case). */
+    vm->accept = NULL;
+    testKeys = keys;
+    return true;
 }
 
-bool enforth_test(EnforthVM * const vm, const char * const text)
+bool complete_test_ffi(EnforthVM * const vm, int handle, int result)
 {
-    /* Run the test. */
-    enforth_evaluate(vm, text);
+    EnforthCell handleCell, resultCell;
+    handleCell.i = handle;
+    resultCell.i = result;
 
-    /* Check the stack. */
-    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
-    EnforthCell * sp = (EnforthCell*)(saved_sp->ram);
-    int depth = (EnforthCell*)(vm->cur_task.ram + 256) - sp;
-    if (depth < 3)
+    /* Complete the asynchronous FFI and then let the VM run until every
+     * task is waiting again (or the operator task halts). */
+    if (!enforth_complete(vm, handleCell, resultCell))
     {
         return false;
     }
 
-    /* Pop IP and RSP so that we can look at the stack itself. */
-    EnforthCell ip = enforth_pop(vm);
-    EnforthCell rsp = enforth_pop(vm);
+    enforth_resume(vm);
+    return true;
+}
+
+void signal_test_event(EnforthVM * const vm, int event)
+{
+    /* Signal the event and then let the VM run until every task is
+     * waiting again (or the operator task halts). */
+    enforth_signal(vm, event);
+    enforth_resume(vm);
+}
+
+bool check_test_ffi_stats(unsigned calls, unsigned total_time, int bucket)
+{
+#if ENABLE_FFI_STATS
+    /* Check the statistics of the twoseven FFI. */
+    const EnforthFFIStats * const stats = enforth_ffi_stats(GET_LAST_FFI(twoseven));
+    return (stats->calls == calls)
+        && (stats->total_time == total_time)
+        && (stats->histogram[bucket] == calls);
+#else
+    return false;
+#endif
+}
+
+bool check_test_output(EnforthVM * const vm, const char * const text, const char * const expected)
+{
+    /* Evaluate the text with its output captured, and then compare the
+     * output to the expected text. */
+    testOutputLen = 0;
+    enforth_evaluate(vm, text);
+    testOutput[testOutputLen] = '\0';
+    testOutputLen = -1;
+
+    return strcmp(testOutput, expected) == 0;
+}
+
+/* Set by enforthAbortAccept once QUIT tries to read a line. */
+static bool testAborted;
+
+static int enforthAbortAccept(uint8_t * buf, int max)
+{
+    testAborted = true;
+    return -1;
+}
+
+bool check_test_abort(EnforthVM * const vm, const char * const text)
+{
+    /* ABORT jumps to QUIT, which reads the next line from the terminal.
+     * Report the end of the input so that the VM halts there, and then
+     * clear the stack and restore the BASE that ABORT reset. */
+    int (* const accept)(uint8_t *, int) = vm->accept;
+
+    testAborted = false;
+    vm->accept = enforthAbortAccept;
+    enforth_evaluate(vm, text);
+    vm->accept = accept;
 
-    /* Pop the test result flag. */
-    bool success = enforth_pop(vm).u == -1;
+    enforth_evaluate(vm, "EMPTY-STACK HEX");
+    return testAborted;
+}
 
-    /* Push RSP and IP back onto the stack. */
-    enforth_push(vm, rsp);
-    enforth_push(vm, ip);
+bool enforth_test(EnforthVM * const vm, const char * const text)
+{
+    /* Run the test. */
+    enforth_evaluate(vm, text);
+
+    /* Check the result. */
+    return enforth_test_result(vm);
+}
 
-    /* Return the test result flag. */
-    return success;
+bool enforth_test_result(EnforthVM * const vm)
+{
+    return pop_test_result(vm);
 }
@@ -14,17 +14,21 @@
  * permissions and limitations under the License.
  */
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
 /* -------------------------------------
- * Harness-provided types and functions.
+ * Includes.
  */
 
-typedef void EnforthVM;
-extern "C" void enforth_evaluate(EnforthVM * const vm, const char * const text);
+/* Enforth includes.  compile_tester evaluates the tester words with
+ * whichever enforth_evaluate the harness links against, which may not
+ * be the one in enforth.c. */
+#include "enforth.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 
 
@@ -94,6 +98,76 @@ void compile_tester(EnforthVM * const vm)
     enforth_evaluate(vm, "   THEN ;");
 }
 
+void push_test_cell(EnforthVM * const vm, const EnforthCell cell)
+{
+    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
+    EnforthCell * sp = (EnforthCell*)(vm->dictionary.ram + saved_sp->u);
+
+    *(--sp) = cell;
+
+    saved_sp->u = (uint8_t*)sp - vm->dictionary.ram;
+}
+
+EnforthCell pop_test_cell(EnforthVM * const vm)
+{
+    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
+    EnforthCell * sp = (EnforthCell*)(vm->dictionary.ram + saved_sp->u);
+
+    EnforthCell tos = *sp++;
+
+    saved_sp->u = (uint8_t*)sp - vm->dictionary.ram;
+
+    return tos;
+}
+
+bool pop_test_result(EnforthVM * const vm)
+{
+    /* Check the stack. */
+    EnforthCell * saved_sp = (EnforthCell*)(vm->cur_task.ram + kEnforthCellSize);
+    EnforthCell * sp = (EnforthCell*)(vm->dictionary.ram + saved_sp->u);
+    int depth = ((EnforthCell*)vm->cur_task.ram + 64) - sp;
+    if (depth < 3)
+    {
+        return false;
+    }
+
+    /* Pop IP and RSP so that we can look at the stack itself. */
+    EnforthCell ip = pop_test_cell(vm);
+    EnforthCell rsp = pop_test_cell(vm);
+
+    /* Pop the test result flag. */
+    bool success = pop_test_cell(vm).i == -1;
+
+    /* Push RSP and IP back onto the stack. */
+    push_test_cell(vm, rsp);
+    push_test_cell(vm, ip);
+
+    /* Return the test result flag. */
+    return success;
+}
+
+EnforthInt operator_tos(EnforthVM * const vm)
+{
+    EnforthCell * task = (EnforthCell*)vm->cur_task.ram;
+    EnforthCell * sp = (EnforthCell*)(vm->dictionary.ram + task[1].u);
+    return sp[2].i;
+}
+
+int test_key_question(void)
+{
+    return 0;
+}
+
+char test_key(void)
+{
+    return '\n';
+}
+
+void test_emit(char ch)
+{
+    (void)ch;
+}
+
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,28 @@ extern "C" {
 
 void compile_tester(EnforthVM * const vm);
 
+#ifdef ENFORTH_H_
+/* Push and pop cells on the operator task's data stack while the VM is
+ * halted (the saved IP and RSP are on top of that stack). */
+void push_test_cell(EnforthVM * const vm, const EnforthCell cell);
+EnforthCell pop_test_cell(EnforthVM * const vm);
+
+/* Pops the flag left by a T{ ... }T test in a halted VM and returns true
+ * if the test passed. */
+bool pop_test_result(EnforthVM * const vm);
+
+/* Returns the top of the operator task's stack, below the saved IP and
+ * RSP, of a VM that has halted. */
+EnforthInt operator_tos(EnforthVM * const vm);
+
+/* I/O primitives for test VMs that neither read input nor show output:
+ * no key is ever ready, KEY ends every line right away, and output is
+ * discarded. */
+int test_key_question(void);
+char test_key(void);
+void test_emit(char ch);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,202 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* Runs the CORE tests in several VMs at once, one thread per VM.  Every
+ * line that a test evaluates is evaluated by all of the VMs in
+ * parallel, and a test only passes if it passed in every VM.  This
+ * catches any state that is accidentally shared between VMs.
+ *
+ * The CORE tests call enforth_evaluate themselves, so test_core.cpp is
+ * compiled with enforth_evaluate renamed to enforth_test_evaluate (see
+ * the Makefile), which this harness provides for a group of VMs.  Each
+ * VM evaluates the text with enforth_begin_evaluate and enforth_run. */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* C++ includes. */
+#include <thread>
+#include <vector>
+
+/* Enforth includes. */
+#include "enforth.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+/* Catch includes. */
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+
+
+/* -------------------------------------
+ * Harness-provided types and functions.
+ */
+
+typedef struct EnforthTestVMs EnforthTestVMs;
+extern "C" EnforthTestVMs * const get_test_vm();
+extern "C" void enforth_test_evaluate(EnforthTestVMs * const vms, const char * const text);
+extern "C" bool enforth_test(EnforthTestVMs * const vms, const char * const text);
+
+
+
+/* -------------------------------------
+ * Test VMs.
+ */
+
+static const int kMaxTestVMs = 16;
+
+struct EnforthTestVMs
+{
+    int count;
+    EnforthVM vm[kMaxTestVMs];
+    unsigned char dictionary[kMaxTestVMs][8192];
+};
+
+/* The number of VMs defaults to the number of hardware threads (but
+ * always at least two, so that there is something to collide with) and
+ * can be overridden with the ENFORTH_TEST_VMS environment variable. */
+static int test_vm_count()
+{
+    const char * const env = getenv("ENFORTH_TEST_VMS");
+    int count = env != NULL ? atoi(env) : std::thread::hardware_concurrency();
+
+    if (count < 2)
+    {
+        count = 2;
+    }
+
+    if (count > kMaxTestVMs)
+    {
+        count = kMaxTestVMs;
+    }
+
+    return count;
+}
+
+
+
+/* -------------------------------------
+ * Enforth I/O primitives.
+ *
+ * Output from the VMs would be interleaved, so it is discarded.
+ */
+
+static int enforthThreadKeyQuestion(void)
+{
+    return -1;
+}
+
+static char enforthThreadKey(void)
+{
+    return '\n';
+}
+
+static void enforthThreadEmit(char ch)
+{
+}
+
+static void enforthThreadType(const char * text, int len)
+{
+}
+
+
+
+/* -------------------------------------
+ * Harness functions.
+ */
+
+EnforthTestVMs * const get_test_vm()
+{
+    /* Globals. */
+    static EnforthTestVMs enforthVMs;
+
+
+    /* Clear out the dictionaries and VM structures. */
+    memset(&enforthVMs, 0, sizeof(enforthVMs));
+    enforthVMs.count = test_vm_count();
+
+    /* Initialize every VM. */
+    for (int i = 0; i < enforthVMs.count; i++)
+    {
+        enforth_init(
+                &enforthVMs.vm[i],
+                enforthVMs.dictionary[i], sizeof(enforthVMs.dictionary[i]),
+                NULL,
+                enforthThreadKeyQuestion, enforthThreadKey,
+                enforthThreadEmit, NULL, NULL);
+        enforthVMs.vm[i].type = enforthThreadType;
+
+        /* Compile the tester words. */
+        compile_tester(&enforthVMs.vm[i]);
+    }
+
+    /* Return the VMs. */
+    return &enforthVMs;
+}
+
+/* Evaluates text in one VM, running the VM until the operator task
+ * halts. */
+static void evaluate_in_vm(EnforthVM * const vm, const char * const text)
+{
+    enforth_begin_evaluate(vm, text);
+    while (enforth_run(vm, 0) != kEnforthRunHalted)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void enforth_test_evaluate(EnforthTestVMs * const vms, const char * const text)
+{
+    std::vector<std::thread> threads;
+
+    /* Evaluate the text in every VM at the same time. */
+    for (int i = 0; i < vms->count; i++)
+    {
+        threads.push_back(std::thread(evaluate_in_vm, &vms->vm[i], text));
+    }
+
+    for (int i = 0; i < vms->count; i++)
+    {
+        threads[i].join();
+    }
+}
+
+bool enforth_test(EnforthTestVMs * const vms, const char * const text)
+{
+    /* Run the test. */
+    enforth_test_evaluate(vms, text);
+
+    /* Check the result in every VM (and always pop every VM's flag so
+     * that the VMs stay in step). */
+    bool success = true;
+    for (int i = 0; i < vms->count; i++)
+    {
+        if (!pop_test_result(&vms->vm[i]))
+        {
+            success = false;
+        }
+    }
+
+    return success;
+}
@@ -0,0 +1,121 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* C++ includes. */
+#include <thread>
+
+/* Enforth includes. */
+#include "enforth.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+/* Catch includes. */
+#include "catch.hpp"
+
+
+
+/* -------------------------------------
+ * Channel test VM.
+ */
+
+/* Evaluates text, running the VM until the text has been evaluated
+ * even if its tasks are waiting for the host in the meantime. */
+static EnforthInt evaluate_until_halted(EnforthVM * const vm, const char * const text)
+{
+    enforth_begin_evaluate(vm, text);
+    while (enforth_run(vm, 0) != kEnforthRunHalted)
+    {
+        std::this_thread::yield();
+    }
+
+    return operator_tos(vm);
+}
+
+
+
+/* -------------------------------------
+ * Channel tests.
+ */
+
+TEST_CASE( "Channel Tests" ) {
+    static uint8_t dictionary[4096];
+    static EnforthVM vm;
+    static EnforthCell slots[8];
+    static EnforthChannel channel;
+    char text[64];
+
+    memset(&vm, 0, sizeof(vm));
+    enforth_init(
+            &vm,
+            dictionary, sizeof(dictionary),
+            NULL,
+            test_key_question, test_key, test_emit,
+            NULL, NULL);
+
+    REQUIRE( !enforth_init_channel(&channel, slots, 6) );
+    REQUIRE( enforth_init_channel(&channel, slots, 8) );
+
+    snprintf(text, sizeof(text), "%llu CONSTANT GC1",
+            (unsigned long long)(uintptr_t)&channel);
+    enforth_evaluate(&vm, text);
+
+    SECTION( "Messages arrive in order and full channels refuse messages" ) {
+        REQUIRE( evaluate_until_halted(&vm, "GC1 ?DEQUEUE") == 0 );
+
+        for (int i = 0; i < 8; i++)
+        {
+            EnforthCell message;
+            message.i = i + 1;
+            REQUIRE( enforth_channel_send(&channel, message) );
+        }
+
+        EnforthCell message;
+        message.i = 9;
+        REQUIRE( !enforth_channel_send(&channel, message) );
+
+        REQUIRE( evaluate_until_halted(&vm, "GC1 DEQUEUE GC1 DEQUEUE 10 * +") == 21 );
+        REQUIRE( enforth_channel_send(&channel, message) );
+        REQUIRE( evaluate_until_halted(&vm, ": GC4 0 7 0 DO GC1 DEQUEUE + LOOP ; GC4") == 42 );
+        REQUIRE( evaluate_until_halted(&vm, "GC1 ?DEQUEUE") == 0 );
+    }
+
+    SECTION( "A host thread streams messages to a running task" ) {
+        std::thread producer([]() {
+            for (int i = 1; i <= 20000; i++)
+            {
+                EnforthCell message;
+                message.i = i;
+                while (!enforth_channel_send(&channel, message))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        enforth_evaluate(&vm, "VARIABLE GC2 : GC3 0 20000 0 DO GC1 DEQUEUE + LOOP GC2 ! ;");
+        REQUIRE( evaluate_until_halted(&vm, "GC3 GC2 @") == 200010000 );
+        producer.join();
+    }
+}
@@ -31,6 +31,15 @@ typedef void EnforthVM;
 extern "C" EnforthVM * const get_test_vm();
 extern "C" void enforth_evaluate(EnforthVM * const vm, const char * const text);
 extern "C" bool enforth_test(EnforthVM * const vm, const char * const text);
+extern "C" void relocate_test_vm(EnforthVM * const vm);
+extern "C" bool load_test_image(EnforthVM * const vm);
+extern "C" bool type_test_keys(EnforthVM * const vm, const char * const keys);
+extern "C" bool complete_test_ffi(EnforthVM * const vm, int handle, int result);
+extern "C" bool enforth_test_result(EnforthVM * const vm);
+extern "C" void signal_test_event(EnforthVM * const vm, int event);
+extern "C" bool check_test_ffi_stats(unsigned calls, unsigned total_time, int bucket);
+extern "C" bool check_test_output(EnforthVM * const vm, const char * const text, const char * const expected);
+extern "C" bool check_test_abort(EnforthVM * const vm, const char * const text);
 
 
 
@@ -57,4 +66,359 @@ TEST_CASE( "FFI Tests" ) {
 
     REQUIRE( enforth_test(vm, "T{ twoseven -> 1B }T") );
     REQUIRE( enforth_test(vm, "T{ twoseven dubnum -> 36 }T") );
+
+    /* Arguments are passed in stack order, deepest first. */
+    REQUIRE( enforth_test(vm, "T{ USE: wsum -> }T") );
+    REQUIRE( enforth_test(vm, "T{ 9 1 2 3 4 5 wsum -> 9 3039 }T") );
+
+    /* Double-cell arguments and results use the ( lo hi ) layout. */
+    REQUIRE( enforth_test(vm, "T{ USE: dfetch USE: dstash USE: dsub -> }T") );
+    REQUIRE( enforth_test(vm, "T{ dfetch -> 5 1 }T") );
+    REQUIRE( enforth_test(vm, "T{ 7 -1 0 dstash -> 7 }T") );
+    REQUIRE( enforth_test(vm, "T{ dfetch -> -1 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ 0 1 1 0 dsub -> -1 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ 1 0 3 0 dsub -> -2 -1 }T") );
+
+    /* ROM FFI words can be used without USE:, which does nothing for
+     * them. */
+    REQUIRE( enforth_test(vm, "T{ 3 4 romadd -> 7 }T") );
+    REQUIRE( enforth_test(vm, "T{ : RF1 3 4 romadd twoseven ; RF1 -> 7 1B }T") );
+    REQUIRE( enforth_test(vm, "T{ 5 6 ' romadd EXECUTE -> B }T") );
+    REQUIRE( enforth_test(vm, "T{ : RF2 ['] ROMADD EXECUTE ; 1 2 RF2 -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ HERE USE: romadd HERE - -> 0 }T") );
+}
+
+TEST_CASE( "Async FFI Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING async FFI (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ USE: aread -> }T") );
+
+    /* The operator task waits for the result. */
+    enforth_evaluate(vm, "T{ 5 aread 1+ -> 2B }T");
+    REQUIRE_FALSE( complete_test_ffi(vm, 0x106, 0) );
+    REQUIRE( complete_test_ffi(vm, 0x105, 0x2A) );
+    REQUIRE( enforth_test_result(vm) );
+
+    /* Other tasks run (and start their own reads) while a task waits,
+     * and reads can complete in any order. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GA1 : GA2 6 aread GA1 ! BEGIN 9 aread DROP AGAIN ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ ' GA2 TASK -> }T") );
+    enforth_evaluate(vm, "T{ 5 aread GA1 @ -> 2A 7 }T");
+    REQUIRE( complete_test_ffi(vm, 0x106, 7) );
+    REQUIRE( complete_test_ffi(vm, 0x105, 0x2A) );
+    REQUIRE( enforth_test_result(vm) );
+
+    /* Reads that cannot be started (sensor -$100 has a zero handle)
+     * fail right away with a zero result. */
+    REQUIRE( enforth_test(vm, "T{ 1 -100 aread -> 1 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ : GA3 -100 aread 1+ ; GA3 -> 1 }T") );
+
+    /* Evaluating more text abandons a pending read (which has consumed
+     * its argument), and the read's result is then ignored. */
+    enforth_evaluate(vm, "5 aread 1+");
+    REQUIRE( enforth_test(vm, "T{ -> }T") );
+    REQUIRE_FALSE( complete_test_ffi(vm, 0x105, 0x2A) );
+}
+
+#if ENABLE_FFI_STATS
+TEST_CASE( "FFI Statistics Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING .FFI-STATS (Enforth)");
+
+    /* Each call takes five ticks, which is a three-bit latency. */
+    REQUIRE( check_test_ffi_stats(0, 0, 3) );
+    REQUIRE( enforth_test(vm, "T{ USE: twoseven twoseven twoseven 2DROP -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GFS twoseven ; GFS -> 1B }T") );
+    REQUIRE( check_test_ffi_stats(3, 15, 3) );
+
+    /* .FFI-STATS lists the FFIs that have been called (in HEX). */
+    REQUIRE( check_test_output(vm, ".FFI-STATS", "twoseven 3 F 3:3\n") );
+}
+#endif
+
+TEST_CASE( "PARSE and PARSE-WORD Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING PARSE PARSE-WORD (Enforth)");
+
+    /* Control characters are whitespace when parsing words. */
+    REQUIRE( enforth_test(vm, "T{ 1\t2\t+ -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ 1\r\n2\n+ -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ 1                                  2 + -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ BL PARSE-WORD                      abcdefghijklmnopqrstuvwxyz NIP -> 1A }T") );
+
+    /* PARSE does not skip leading delimiters. */
+    REQUIRE( enforth_test(vm, "T{ CHAR ) PARSE abc) NIP -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ CHAR ) PARSE ) NIP -> 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ : GP1 S\" \" NIP ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ GP1 -> 0 }T") );
+
+    /* Comments only extend to the end of the current line. */
+    REQUIRE( enforth_test(vm, "T{ 1 ( 2 ) 3 -> 1 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ 1 \\ 2 3\n 4 -> 1 4 }T") );
+}
+
+TEST_CASE( "Number Prefix Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING NUMBER? (Enforth)");
+
+    /* Base prefixes override BASE (which is HEX during the tests). */
+    REQUIRE( enforth_test(vm, "T{ #10 -> A }T") );
+    REQUIRE( enforth_test(vm, "T{ $10 -> 10 }T") );
+    REQUIRE( enforth_test(vm, "T{ %101 -> 5 }T") );
+    REQUIRE( enforth_test(vm, "T{ $ff -> FF }T") );
+    REQUIRE( enforth_test(vm, "T{ 'A' -> 41 }T") );
+
+    /* The sign can appear before or after the prefix. */
+    REQUIRE( enforth_test(vm, "T{ -$10 -> -10 }T") );
+    REQUIRE( enforth_test(vm, "T{ $-10 -> -10 }T") );
+    REQUIRE( enforth_test(vm, "T{ #-10 -> -A }T") );
+
+    /* A trailing period makes a double-cell number. */
+    REQUIRE( enforth_test(vm, "T{ 1. -> 1 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ -1. -> -1 -1 }T") );
+    REQUIRE( enforth_test(vm, "T{ #-10. -> -A -1 }T") );
+    REQUIRE( enforth_test(vm, "T{ : GN1 $20. #-3 ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ GN1 -> 20 0 -3 }T") );
+
+    /* >NUMBER stops at the first non-digit. */
+    REQUIRE( enforth_test(vm, "T{ : GN2 0 0 S\" 12Z\" >NUMBER NIP ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ GN2 -> 12 0 1 }T") );
+}
+
+TEST_CASE( "Numeric Output Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING . U. D. .R U.R (Enforth)");
+
+    /* The native conversions leave their string in the pictured numeric
+     * output buffer, which #> can retrieve. */
+    REQUIRE( enforth_test(vm, "T{ -1A 0 .R 0 0 #> NIP -> 3 }T") );
+    REQUIRE( enforth_test(vm, "T{ -1A 5 .R 0 0 #> DROP DUP C@ SWAP 2 + C@ -> 2D 41 }T") );
+    REQUIRE( enforth_test(vm, "T{ -1 U. 0 0 #> NIP -> 1 CELLS 2* }T") );
+    REQUIRE( enforth_test(vm, "T{ -1 3 U.R 0 0 #> DROP C@ -> 46 }T") );
+    REQUIRE( enforth_test(vm, "T{ -1 -1 D. 0 0 #> NIP -> 2 }T") );
+    REQUIRE( enforth_test(vm, "T{ A BASE ! -123 . 0 0 #> NIP HEX -> 4 }T") );
+    REQUIRE( enforth_test(vm, "T{ 2 BASE ! 101 U. 0 0 #> NIP HEX -> 3 }T") );
+}
+
+TEST_CASE( "ACCEPT Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING ACCEPT (Enforth)");
+
+    /* The harness's accept callback supplies the line "ACCEPTED". */
+    REQUIRE( enforth_test(vm, "T{ HERE 20 ACCEPT HERE C@ -> 8 41 }T") );
+    REQUIRE( enforth_test(vm, "T{ HERE 3 ACCEPT HERE 2 + C@ -> 3 43 }T") );
+
+    /* Without an accept callback the line is read a KEY at a time,
+     * backspaces remove the previous character, and characters past
+     * the end of the buffer are discarded. */
+    REQUIRE( type_test_keys(vm, "KEYX\bS\nABCDE\n") );
+    REQUIRE( enforth_test(vm, "T{ HERE 20 ACCEPT HERE 3 + C@ -> 4 53 }T") );
+    REQUIRE( enforth_test(vm, "T{ HERE 3 ACCEPT HERE 2 + C@ -> 3 43 }T") );
+}
+
+TEST_CASE( "INCLUDED and REFILL Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING INCLUDED INCLUDE-FILE REFILL SOURCE-ID (Enforth)");
+
+    /* EVALUATE strings cannot be refilled. */
+    REQUIRE( enforth_test(vm, "T{ SOURCE-ID -> -1 }T") );
+    REQUIRE( enforth_test(vm, "T{ REFILL -> 0 }T") );
+
+    /* Definitions can span lines in an included source. */
+    REQUIRE( enforth_test(vm, "T{ INCLUDE gi1.fs -> }T") );
+    REQUIRE( enforth_test(vm, "T{ GI2 -> 2 }T") );
+
+    /* Nested sources resume the enclosing line where they left off. */
+    REQUIRE( enforth_test(vm, "T{ INCLUDE gi2.fs GI3 -> 3 }T") );
+
+    /* SOURCE-ID is the fileid and REFILL fails at the end of a file. */
+    REQUIRE( enforth_test(vm, "T{ INCLUDE gi3.fs -> 1 0 }T") );
+
+    /* Lines are truncated to the size of the line buffer. */
+    REQUIRE( enforth_test(vm, "T{ INCLUDE gi4.fs -> 1 3 }T") );
+}
+
+TEST_CASE( "Relocatable Dictionary Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING relocation (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ : GR1 1 2 + ; VARIABLE GR2 4 GR2 ! -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GR3 BEGIN PAUSE AGAIN ; ' GR3 TASK -> }T") );
+
+    /* Definitions, DP, and the tasks all survive a move. */
+    relocate_test_vm(vm);
+    REQUIRE( enforth_test(vm, "T{ GR1 GR2 @ -> 3 4 }T") );
+    REQUIRE( enforth_test(vm, "T{ : GR4 GR1 1+ ; GR4 -> 4 }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE PAUSE -> }T") );
+
+    relocate_test_vm(vm);
+    REQUIRE( enforth_test(vm, "T{ GR4 PAUSE GR2 @ -> 4 4 }T") );
+}
+
+TEST_CASE( "Task Stack Size Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING TASK SIZED-TASK (Enforth)");
+
+    /* A task is eight user variables followed by its stacks. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GZ1 : GZ2 1 2 3 + + GZ1 ! BEGIN PAUSE AGAIN ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ HERE ' GZ2 8 A SIZED-TASK HERE SWAP - -> 1A CELLS }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE GZ1 @ -> 6 }T") );
+    REQUIRE( enforth_test(vm, "T{ HERE ' GZ2 TASK HERE SWAP - -> 40 CELLS }T") );
+    REQUIRE( enforth_test(vm, "T{ 0 GZ1 ! PAUSE GZ1 @ -> 6 }T") );
+
+    /* Stacks that are too small or too large are rejected without
+     * creating a task. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GZ3 HERE GZ3 ! -> }T") );
+    REQUIRE( check_test_abort(vm, "' GZ2 3 A SIZED-TASK") );
+    REQUIRE( check_test_abort(vm, "' GZ2 100 A SIZED-TASK") );
+    REQUIRE( check_test_abort(vm, "' GZ2 8 100 SIZED-TASK") );
+    REQUIRE_FALSE( check_test_abort(vm, "1 2 +") );
+    REQUIRE( enforth_test(vm, "T{ HERE GZ3 @ - -> 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ ' GZ2 4 FF SIZED-TASK HERE GZ3 @ - -> 10B CELLS }T") );
+}
+
+TEST_CASE( "Time Slicing Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING TIME-SLICE (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ TIME-SLICE @ -> 0 }T") );
+
+    /* Neither task calls PAUSE, so the operator task only finishes if
+     * both of them are preempted. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GT1 0 GT1 ! : GT2 BEGIN 1 GT1 +! AGAIN ; ' GT2 TASK -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GT3 BEGIN GT1 @ UNTIL ; 10 TIME-SLICE ! GT3 -> }T") );
+    REQUIRE( enforth_test(vm, "T{ 0 TIME-SLICE ! GT1 @ 0= -> 0 }T") );
+}
+
+TEST_CASE( "Sleep Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING TICKS MS SLEEP-UNTIL (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ TICKS 40 MS TICKS SWAP - -> 40 }T") );
+    REQUIRE( enforth_test(vm, "T{ TICKS 1- SLEEP-UNTIL -> }T") );
+
+    /* The VM idles until the earliest wake time whenever every task is
+     * asleep, and sleeping tasks are not run until they wake up. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GS1 0 GS1 ! : GS2 BEGIN 1 GS1 +! 64 MS AGAIN ; ' GS2 TASK -> }T") );
+    REQUIRE( enforth_test(vm, "T{ TICKS 96 MS TICKS SWAP - GS1 @ -> 96 2 }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE PAUSE GS1 @ -> 2 }T") );
+    REQUIRE( enforth_test(vm, "T{ 64 MS GS1 @ -> 3 }T") );
+}
+
+TEST_CASE( "Host Event Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING BLOCK-ON (Enforth)");
+
+    /* Events outside of the range of event numbers just pause. */
+    REQUIRE( enforth_test(vm, "T{ -1 BLOCK-ON -> }T") );
+
+    /* The operator task runs again once its event has been signaled
+     * (and not when some other event is signaled). */
+    enforth_evaluate(vm, "T{ 3 BLOCK-ON 1 -> 1 }T");
+    signal_test_event(vm, 4);
+    signal_test_event(vm, 3);
+    REQUIRE( enforth_test_result(vm) );
+
+    /* A signal wakes a single blocked task, and is not lost if it
+     * arrives before the task blocks. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GE1 0 GE1 ! : GE2 BEGIN 5 BLOCK-ON 1 GE1 +! AGAIN ; ' GE2 TASK -> }T") );
+    enforth_evaluate(vm, "T{ 5 BLOCK-ON GE1 @ -> 0 }T");
+    signal_test_event(vm, 5);
+    REQUIRE( enforth_test_result(vm) );
+    REQUIRE( enforth_test(vm, "T{ 4 BLOCK-ON GE1 @ -> 0 }T") );
+}
+
+TEST_CASE( "Mailbox Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING MAILBOX SEND RECEIVE ?RECEIVE TRY-SEND (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ 3 MAILBOX GM1 -> }T") );
+
+    /* Mailboxes must be able to hold at least one cell. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GM0 HERE GM0 ! -> }T") );
+    REQUIRE( check_test_abort(vm, "0 MAILBOX GM5") );
+    REQUIRE( enforth_test(vm, "T{ HERE GM0 @ - -> 0 }T") );
+
+    REQUIRE( enforth_test(vm, "T{ GM1 ?RECEIVE -> 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ 1 GM1 TRY-SEND 2 GM1 TRY-SEND -> -1 -1 }T") );
+    REQUIRE( enforth_test(vm, "T{ GM1 RECEIVE GM1 ?RECEIVE -> 1 2 -1 }T") );
+
+    /* Messages wrap around the end of the mailbox. */
+    REQUIRE( enforth_test(vm, "T{ 3 GM1 SEND 4 GM1 SEND 5 GM1 SEND 6 GM1 TRY-SEND -> 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ GM1 RECEIVE GM1 RECEIVE GM1 RECEIVE -> 3 4 5 }T") );
+
+    /* Tasks park on empty and full mailboxes, and do not run again
+     * until the other side has received or sent a message. */
+    REQUIRE( enforth_test(vm, "T{ 1 MAILBOX GM2 1 MAILBOX GM3 VARIABLE GM4 0 GM4 ! -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GM5 BEGIN 1 GM4 +! GM2 RECEIVE DUP + GM3 SEND AGAIN ; ' GM5 TASK -> }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE PAUSE PAUSE GM4 @ -> 1 }T") );
+    REQUIRE( enforth_test(vm, "T{ 5 GM2 SEND 6 GM2 SEND GM3 RECEIVE GM3 RECEIVE -> A C }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE PAUSE GM4 @ -> 3 }T") );
+}
+
+TEST_CASE( "Atomic Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING ATOMIC@ ATOMIC! CAS (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GA1 5 GA1 ATOMIC! GA1 ATOMIC@ GA1 @ -> 5 5 }T") );
+    REQUIRE( enforth_test(vm, "T{ 5 6 GA1 CAS GA1 @ -> -1 6 }T") );
+    REQUIRE( enforth_test(vm, "T{ 5 7 GA1 CAS GA1 @ -> 0 6 }T") );
+}
+
+TEST_CASE( "Task HALT Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING HALT from a task (Enforth)");
+
+    /* HALT in a background task returns to the host, but the next
+     * evaluation still runs in the operator task, and the background
+     * task continues where it halted. */
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GH1 0 GH1 ! : GH2 HALT 5 GH1 ! BEGIN PAUSE AGAIN ; -> }T") );
+    enforth_evaluate(vm, "' GH2 TASK PAUSE");
+    REQUIRE( enforth_test(vm, "T{ GH1 @ -> 0 }T") );
+    REQUIRE( enforth_test(vm, "T{ PAUSE GH1 @ -> 5 }T") );
+}
+
+TEST_CASE( "Image Tests" ) {
+    EnforthVM * const vm = get_test_vm();
+    enforth_evaluate(vm, "TESTING SAVE LOAD TURNKEY (Enforth)");
+
+    REQUIRE( enforth_test(vm, "T{ VARIABLE GS1 4 GS1 ! : GS2 GS1 @ 1+ ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GS3 GS2 5 = HALT ; ' GS3 TURNKEY -> }T") );
+    REQUIRE( enforth_test(vm, "T{ SAVE -> TRUE }T") );
+
+    /* LOAD restores the saved dictionary and then restarts at COLD,
+     * which runs the turnkey word (and its HALT returns the flag). */
+    REQUIRE( enforth_test(vm, "T{ 6 GS1 ! GS2 -> 7 }T") );
+    REQUIRE( enforth_test(vm, "LOAD") );
+    REQUIRE( enforth_test(vm, "T{ GS2 -> 5 }T") );
+
+    /* Later saves only write the pages that changed (including new
+     * definitions), but LOAD still sees the complete image. */
+    REQUIRE( enforth_test(vm, "T{ 9 GS1 ! : GS4 GS2 2* ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GS5 GS4 14 = HALT ; ' GS5 TURNKEY SAVE -> TRUE }T") );
+    REQUIRE( enforth_test(vm, "T{ 0 GS1 ! GS4 -> 2 }T") );
+    REQUIRE( enforth_test(vm, "LOAD") );
+    REQUIRE( enforth_test(vm, "T{ GS1 @ -> 9 }T") );
+
+    /* Saves also capture the state of tasks and mailboxes that changed
+     * without a store from Forth, so that a background task continues
+     * where it left off after LOAD. */
+    REQUIRE( enforth_test(vm, "T{ 2 MAILBOX GS6 VARIABLE GS7 0 GS7 ! -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GS8 0 BEGIN GS6 RECEIVE + DUP GS7 ! AGAIN ; ' GS8 TASK -> }T") );
+    REQUIRE( enforth_test(vm, "T{ : GS9 7 GS6 SEND PAUSE GS7 @ #12 = HALT ; ' GS9 TURNKEY SAVE -> TRUE }T") );
+    REQUIRE( enforth_test(vm, "T{ 5 GS6 SEND PAUSE GS7 @ -> 5 }T") );
+    REQUIRE( enforth_test(vm, "T{ SAVE -> TRUE }T") );
+    REQUIRE( enforth_test(vm, "LOAD") );
+    REQUIRE( enforth_test(vm, "T{ GS7 @ -> #12 }T") );
+
+    /* The address of an FFI definition that USE: compiled may not be
+     * valid in the process that loads the image, so loading links FFI
+     * words to the host's definitions again. */
+    REQUIRE( enforth_test(vm, "T{ USE: dubnum : GS10 3 dubnum 6 = HALT ; -> }T") );
+    REQUIRE( enforth_test(vm, "T{ ' GS10 TURNKEY SAVE -> TRUE }T") );
+    REQUIRE( enforth_test(vm, "T{ -1 ' dubnum >BODY ! -> }T") );
+    REQUIRE( load_test_image(vm) );
+    REQUIRE( enforth_test_result(vm) );
+    REQUIRE( enforth_test(vm, "T{ 4 dubnum -> 8 }T") );
 }
@@ -0,0 +1,207 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* C++ includes. */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/* Enforth includes. */
+#include "enforth.h"
+#include "enforthexecutor.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+/* Catch includes. */
+#include "catch.hpp"
+
+
+
+/* -------------------------------------
+ * Executor test VMs.
+ *
+ * These VMs are created by the tests themselves (rather than by the
+ * harness) since the executor tests need many of them.
+ */
+
+struct ExecutorTestVM
+{
+    EnforthVM vm;
+    unsigned char dictionary[4096];
+};
+
+/* Counts the asynchronous reads that have been started. */
+static std::atomic<int> executorReads(0);
+
+/* Starts an asynchronous read of sensor n, whose handle is n+256. */
+static int startExecutorRead(int n)
+{
+    executorReads++;
+    return n + 256;
+}
+
+ENFORTH_EXTERN_ASYNC(xread, startExecutorRead, 1)
+#undef LAST_FFI
+#define LAST_FFI GET_LAST_FFI(xread)
+
+static void init_executor_test_vm(ExecutorTestVM & testVM)
+{
+    enforth_init(
+            &testVM.vm,
+            testVM.dictionary, sizeof(testVM.dictionary),
+            LAST_FFI,
+            test_key_question, test_key, test_emit,
+            NULL, NULL);
+}
+
+/* Waits up to ten seconds for count to reach expected. */
+static bool wait_for_count(std::atomic<int> & count, int expected)
+{
+    for (int i = 0; (i < 10000) && (count < expected); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return count == expected;
+}
+
+
+
+/* -------------------------------------
+ * Executor tests.
+ */
+
+TEST_CASE( "Budgeted Run Tests" ) {
+    static ExecutorTestVM testVM;
+    EnforthVM * const vm = &testVM.vm;
+    init_executor_test_vm(testVM);
+
+    /* Runs end after the budgeted number of task switches. */
+    enforth_begin_evaluate(vm, ": GB1 0 10 0 DO PAUSE 1+ LOOP ; GB1");
+    REQUIRE( enforth_run(vm, 3) == kEnforthRunYielded );
+    REQUIRE( enforth_run(vm, 3) == kEnforthRunYielded );
+    REQUIRE( enforth_run(vm, 100) == kEnforthRunHalted );
+    REQUIRE( operator_tos(vm) == 10 );
+
+    /* Time slicing bounds the runs of words that never pause. */
+    vm->time_slice = 50;
+    enforth_begin_evaluate(vm, ": GB2 0 1000 0 DO 1+ LOOP ; GB2");
+    REQUIRE( enforth_run(vm, 1) == kEnforthRunYielded );
+    REQUIRE( enforth_run(vm, 1000) == kEnforthRunHalted );
+    REQUIRE( operator_tos(vm) == 1000 );
+
+    /* Budgeted runs return instead of idling. */
+    vm->time_slice = 0;
+    enforth_begin_evaluate(vm, "5 BLOCK-ON 7");
+    REQUIRE( enforth_run(vm, 8) == kEnforthRunWaiting );
+    REQUIRE( vm->wait_ticks == ~(EnforthUnsigned)0 );
+    enforth_signal(vm, 5);
+    REQUIRE( enforth_run(vm, 8) == kEnforthRunHalted );
+    REQUIRE( operator_tos(vm) == 7 );
+
+    /* Evaluating more text abandons what the operator task was
+     * waiting for. */
+    enforth_begin_evaluate(vm, "6 BLOCK-ON 7");
+    REQUIRE( enforth_run(vm, 8) == kEnforthRunWaiting );
+    enforth_begin_evaluate(vm, "9");
+    REQUIRE( enforth_run(vm, 8) == kEnforthRunHalted );
+    REQUIRE( operator_tos(vm) == 9 );
+
+    vm->ticks = EnforthExecutor::ticks;
+    enforth_begin_evaluate(vm, "1000 MS 8");
+    REQUIRE( enforth_run(vm, 8) == kEnforthRunWaiting );
+    REQUIRE( vm->wait_ticks > 0 );
+    REQUIRE( vm->wait_ticks <= 1000 );
+}
+
+TEST_CASE( "Executor Tests" ) {
+    static ExecutorTestVM testVMs[200];
+    std::atomic<int> halted(0);
+
+    SECTION( "Every VM runs to completion" ) {
+        EnforthExecutor executor(4, [&](EnforthVM *) { halted++; });
+
+        for (int i = 0; i < 200; i++)
+        {
+            init_executor_test_vm(testVMs[i]);
+            executor.submit(&testVMs[i].vm, ": GX1 0 2000 0 DO I + PAUSE LOOP ; GX1");
+        }
+
+        REQUIRE( wait_for_count(halted, 200) );
+        REQUIRE( executor.size() == 0 );
+        for (int i = 0; i < 200; i++)
+        {
+            REQUIRE( operator_tos(&testVMs[i].vm) == 1999000 );
+        }
+    }
+
+    SECTION( "VMs that never pause do not starve other VMs" ) {
+        EnforthExecutor executor(1, [&](EnforthVM *) { halted++; });
+
+        init_executor_test_vm(testVMs[0]);
+        init_executor_test_vm(testVMs[1]);
+        executor.submit(&testVMs[0].vm, ": GX2 BEGIN AGAIN ; GX2");
+        executor.submit(&testVMs[1].vm, "1 2 +");
+
+        REQUIRE( wait_for_count(halted, 1) );
+        REQUIRE( operator_tos(&testVMs[1].vm) == 3 );
+        REQUIRE( executor.size() == 1 );
+    }
+
+    SECTION( "Blocked and sleeping VMs are parked until they are woken" ) {
+        EnforthExecutor executor(2, [&](EnforthVM *) { halted++; });
+        const EnforthUnsigned start = EnforthExecutor::ticks();
+
+        init_executor_test_vm(testVMs[0]);
+        init_executor_test_vm(testVMs[1]);
+        executor.submit(&testVMs[0].vm, "3 BLOCK-ON 42");
+        executor.submit(&testVMs[1].vm, "20 MS 43");
+
+        REQUIRE( wait_for_count(halted, 1) );
+        REQUIRE( operator_tos(&testVMs[1].vm) == 43 );
+        REQUIRE( EnforthExecutor::ticks() - start >= 20 );
+
+        executor.signal(&testVMs[0].vm, 3);
+        REQUIRE( wait_for_count(halted, 2) );
+        REQUIRE( operator_tos(&testVMs[0].vm) == 42 );
+    }
+
+    SECTION( "VMs waiting for an asynchronous FFI are parked until it completes" ) {
+        EnforthExecutor executor(2, [&](EnforthVM *) { halted++; });
+        EnforthCell handle, result;
+
+        executorReads = 0;
+        init_executor_test_vm(testVMs[0]);
+        executor.submit(&testVMs[0].vm, "USE: xread 5 xread 1+");
+
+        REQUIRE( wait_for_count(executorReads, 1) );
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE( halted == 0 );
+        REQUIRE( executor.size() == 1 );
+
+        handle.i = 261;
+        result.i = 42;
+        executor.complete(&testVMs[0].vm, handle, result);
+        REQUIRE( wait_for_count(halted, 1) );
+        REQUIRE( operator_tos(&testVMs[0].vm) == 43 );
+    }
+}
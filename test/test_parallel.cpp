@@ -0,0 +1,186 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <string.h>
+
+/* C++ includes. */
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Enforth includes. */
+#include "enforth.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+/* Catch includes. */
+#include "catch.hpp"
+
+
+
+/* -------------------------------------
+ * Parallel test VM.
+ */
+
+static const int kParallelTestWorkers = 4;
+
+/* Runs the VM's tasks on worker threads while the calling thread
+ * evaluates text in the VM itself, and returns the value that the text
+ * left on top of the operator task's stack.  The tasks do not run
+ * before this (the VM is not time sliced until now, and the text that
+ * creates them does not PAUSE), so they all start out in parallel. */
+static EnforthInt evaluate_in_parallel(EnforthVM * const vm, const char * const text)
+{
+    static EnforthVM workers[kParallelTestWorkers];
+    std::vector<std::thread> threads;
+    std::atomic<bool> done(false);
+
+    vm->time_slice = 100;
+
+    for (int i = 0; i < kParallelTestWorkers; i++)
+    {
+        enforth_init_worker(&workers[i], vm);
+    }
+
+    for (int i = 0; i < kParallelTestWorkers; i++)
+    {
+        threads.push_back(std::thread([&done](EnforthVM * const worker) {
+            while (!done)
+            {
+                if (enforth_run(worker, 16) == kEnforthRunWaiting)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }, &workers[i]));
+    }
+
+    /* The operator task waits for the other tasks by polling, so the VM
+     * may return before the text has been evaluated. */
+    enforth_begin_evaluate(vm, text);
+    while (enforth_run(vm, 0) != kEnforthRunHalted)
+    {
+        std::this_thread::yield();
+    }
+
+    done = true;
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    return operator_tos(vm);
+}
+
+
+
+/* -------------------------------------
+ * Parallel output.
+ */
+
+static std::atomic<int> parallelNumbers;
+static std::atomic<int> badParallelNumbers;
+
+/* Counts the numbers in a buffer of output from one of the VMs.  The
+ * VMs never split a number across buffers, so every number should be
+ * one that a task printed, and not a mix of two of them. */
+static void count_parallel_numbers(const char * text, int len)
+{
+    const char * const end = text + len;
+
+    while (text < end)
+    {
+        const char * const start = text;
+        while ((text < end) && (*text != ' '))
+        {
+            text++;
+        }
+
+        if (text > start)
+        {
+            parallelNumbers++;
+            if (((text - start != 8) || (strncmp(start, "11111111", 8) != 0))
+                    && ((text - start != 4) || (strncmp(start, "2222", 4) != 0)))
+            {
+                badParallelNumbers++;
+            }
+        }
+
+        if (text < end)
+        {
+            text++;
+        }
+    }
+}
+
+
+
+/* -------------------------------------
+ * Parallel task tests.
+ */
+
+TEST_CASE( "Parallel Task Tests" ) {
+    static uint8_t dictionary[16384];
+    static EnforthVM vm;
+
+    memset(&vm, 0, sizeof(vm));
+    enforth_init(
+            &vm,
+            dictionary, sizeof(dictionary),
+            NULL,
+            test_key_question, test_key, test_emit,
+            NULL, NULL);
+
+    SECTION( "CAS counters are not lost between threads" ) {
+        enforth_evaluate(&vm, "VARIABLE GP1 0 GP1 ! 8 MAILBOX GP2 1 MAILBOX GP3");
+        enforth_evaluate(&vm, ": GP4 0 DO BEGIN GP1 ATOMIC@ DUP 1+ GP1 CAS UNTIL LOOP ;");
+        enforth_evaluate(&vm, ": GP5 20000 GP4 1 GP2 SEND GP3 RECEIVE ;");
+        enforth_evaluate(&vm, "' GP5 TASK ' GP5 TASK ' GP5 TASK ' GP5 TASK ' GP5 TASK ' GP5 TASK");
+        enforth_evaluate(&vm, ": GP6 0 6 0 DO GP2 RECEIVE + LOOP ;");
+
+        REQUIRE( evaluate_in_parallel(&vm, "GP6 GP1 ATOMIC@ +") == 120006 );
+    }
+
+    SECTION( "Mailboxes pass messages between threads" ) {
+        enforth_evaluate(&vm, "2 MAILBOX GP7 1 MAILBOX GP8 1 MAILBOX GP9");
+        enforth_evaluate(&vm, ": GP10 1001 1 DO I GP7 SEND LOOP GP9 RECEIVE ;");
+        enforth_evaluate(&vm, ": GP11 0 1000 0 DO GP7 RECEIVE + LOOP GP8 SEND GP9 RECEIVE ;");
+        enforth_evaluate(&vm, "' GP10 TASK ' GP11 TASK");
+
+        REQUIRE( evaluate_in_parallel(&vm, "GP8 RECEIVE") == 500500 );
+    }
+
+    SECTION( "Workers have their own pictured numeric output" ) {
+        enforth_evaluate(&vm, "1 MAILBOX GP12 1 MAILBOX GP13");
+        enforth_evaluate(&vm, ": GP14 DECIMAL 20000 0 DO 11111111 0 40 D.R LOOP 1 GP12 SEND GP13 RECEIVE ;");
+        enforth_evaluate(&vm, ": GP15 DECIMAL 20000 0 DO 2222 0 40 D.R LOOP 2 GP12 SEND GP13 RECEIVE ;");
+        enforth_evaluate(&vm, "' GP14 TASK ' GP15 TASK");
+
+        parallelNumbers = 0;
+        badParallelNumbers = 0;
+        vm.type = count_parallel_numbers;
+
+        REQUIRE( evaluate_in_parallel(&vm, "GP12 RECEIVE GP12 RECEIVE +") == 3 );
+        REQUIRE( parallelNumbers == 40000 );
+        REQUIRE( badParallelNumbers == 0 );
+    }
+}
@@ -0,0 +1,113 @@
+/* Copyright 2008-2017 Michael Alyn Miller
+ * vi:ts=4:sts=4:et:sw=4:sr:et:tw=72:fo=tcrq
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* -------------------------------------
+ * Includes.
+ */
+
+/* ANSI C includes. */
+#include <string.h>
+#include <unistd.h>
+
+/* Enforth includes. */
+#include "enforth.h"
+#include "enforthsharedimage.h"
+
+/* Test includes. */
+#include "enforthtesthelper.h"
+
+/* Catch includes. */
+#include "catch.hpp"
+
+
+
+/* -------------------------------------
+ * Shared image test VMs.
+ */
+
+static const int kSharedTestDictionarySize = 16384;
+
+static void init_shared_test_vm(EnforthVM * const vm, uint8_t * const dictionary)
+{
+    memset(vm, 0, sizeof(*vm));
+    enforth_init(
+            vm,
+            dictionary, kSharedTestDictionarySize,
+            NULL,
+            test_key_question, test_key, test_emit,
+            NULL, NULL);
+}
+
+/* Evaluates text and returns the value that it left on top of the
+ * operator task's stack (below the saved IP and RSP). */
+static EnforthInt evaluate_tos(EnforthVM * const vm, const char * const text)
+{
+    enforth_evaluate(vm, text);
+
+    return operator_tos(vm);
+}
+
+
+
+/* -------------------------------------
+ * Shared image tests.
+ */
+
+TEST_CASE( "Shared Image Tests" ) {
+    static uint8_t baseDictionary[kSharedTestDictionarySize];
+    static uint8_t scratchDictionary[kSharedTestDictionarySize];
+    static EnforthVM baseVM, vm1, vm2;
+    EnforthSharedImage image;
+
+    /* Compile the application into a base VM and freeze it. */
+    init_shared_test_vm(&baseVM, baseDictionary);
+    enforth_evaluate(&baseVM, "VARIABLE GS1 5 GS1 ! : GS2 1 GS1 +! ; : GS3 GS1 @ ;");
+    REQUIRE( enforth_freeze_shared_image(&baseVM, &image) );
+    uint8_t * const gs1Address = (uint8_t*)(uintptr_t)evaluate_tos(&baseVM, "GS1");
+    const EnforthUnsigned gs1 = (EnforthUnsigned)(gs1Address - baseDictionary);
+
+    /* Start two VMs from the image. */
+    uint8_t * const dictionary1 = enforth_map_shared_image(&image, kSharedTestDictionarySize);
+    uint8_t * const dictionary2 = enforth_map_shared_image(&image, kSharedTestDictionarySize);
+    REQUIRE( dictionary1 != NULL );
+    REQUIRE( dictionary2 != NULL );
+
+    init_shared_test_vm(&vm1, scratchDictionary);
+    REQUIRE( enforth_load_image(&vm1, dictionary1, kSharedTestDictionarySize) );
+    init_shared_test_vm(&vm2, scratchDictionary);
+    REQUIRE( enforth_load_image(&vm2, dictionary2, kSharedTestDictionarySize) );
+
+    /* Both VMs run the shared definitions, but their variables and new
+     * definitions are their own. */
+    REQUIRE( evaluate_tos(&vm1, "GS2 GS2 GS3") == 7 );
+    REQUIRE( evaluate_tos(&vm2, "GS3") == 5 );
+    REQUIRE( evaluate_tos(&vm2, ": GS4 GS3 2* ; GS2 GS4") == 12 );
+    REQUIRE( evaluate_tos(&vm1, ": GS4 GS3 1- ; GS4") == 6 );
+    REQUIRE( evaluate_tos(&vm2, "GS4") == 12 );
+
+    /* The image itself is unchanged. */
+    EnforthCell frozen;
+    REQUIRE( pread(image.fd, &frozen, sizeof(frozen), gs1) == sizeof(frozen) );
+    REQUIRE( frozen.i == 5 );
+
+    /* Dictionaries that are already mapped outlive the image. */
+    enforth_release_shared_image(&image);
+    REQUIRE( evaluate_tos(&vm2, "GS4") == 12 );
+    REQUIRE( enforth_map_shared_image(&image, kSharedTestDictionarySize) == NULL );
+
+    enforth_unmap_shared_image(dictionary1, kSharedTestDictionarySize);
+    enforth_unmap_shared_image(dictionary2, kSharedTestDictionarySize);
+}
@@ -7,1677 +7,1933 @@
 0, 0x00,0x00, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, dictionary), PLUS, FETCH, EXIT,
 
-/* TICKPREVLEAVE */
+/* TICKKEYEVENT */
 #undef ROMDEF_LAST
-#define ROMDEF_TICKPREVLEAVE 0xC00B
+#define ROMDEF_TICKKEYEVENT 0xC00B
 #define ROMDEF_LAST 0xC00B
 0, 0xC0,0x00, 0, DOCOLONROM,
+VM, ICHARLIT, offsetof(EnforthVM, key_event), PLUS, EXIT,
+
+/* TICKPREVLEAVE */
+#undef ROMDEF_LAST
+#define ROMDEF_TICKPREVLEAVE 0xC015
+#define ROMDEF_LAST 0xC015
+0, 0xC0,0x0B, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, prev_leave), PLUS, EXIT,
 
 /* TICKROMDEF */
 #undef ROMDEF_LAST
-#define ROMDEF_TICKROMDEF 0xC015
-#define ROMDEF_LAST 0xC015
-0, 0xC0,0x0B, 0, TICKROMDEF,
+#define ROMDEF_TICKROMDEF 0xC01F
+#define ROMDEF_LAST 0xC01F
+0, 0xC0,0x15, 0, TICKROMDEF,
+
+/* TICKTURNKEY */
+#undef ROMDEF_LAST
+#define ROMDEF_TICKTURNKEY 0xC024
+#define ROMDEF_LAST 0xC024
+0, 0xC0,0x1F, 0, DOCOLONROM,
+0xC0,0x00, ICHARLIT, offsetof(EnforthImageHeader, turnkey), PLUS, EXIT,
 
 /* PPLUSLOOP */
 #undef ROMDEF_LAST
-#define ROMDEF_PPLUSLOOP 0xC01A
-#define ROMDEF_LAST 0xC01A
-0, 0xC0,0x15, 0, PPLUSLOOP,
+#define ROMDEF_PPLUSLOOP 0xC02F
+#define ROMDEF_LAST 0xC02F
+0, 0xC0,0x24, 0, PPLUSLOOP,
 
 /* PQDO */
 #undef ROMDEF_LAST
-#define ROMDEF_PQDO 0xC01F
-#define ROMDEF_LAST 0xC01F
-0, 0xC0,0x1A, 0, PQDO,
+#define ROMDEF_PQDO 0xC034
+#define ROMDEF_LAST 0xC034
+0, 0xC0,0x2F, 0, PQDO,
+
+/* PACCEPT */
+#undef ROMDEF_LAST
+#define ROMDEF_PACCEPT 0xC039
+#define ROMDEF_LAST 0xC039
+0, 0xC0,0x34, 0, PACCEPT,
+
+/* PAWAIT */
+#undef ROMDEF_LAST
+#define ROMDEF_PAWAIT 0xC03E
+#define ROMDEF_LAST 0xC03E
+0, 0xC0,0x39, 0, PAWAIT,
 
 /* PDO */
 #undef ROMDEF_LAST
-#define ROMDEF_PDO 0xC024
-#define ROMDEF_LAST 0xC024
-0, 0xC0,0x1F, 0, PDO,
+#define ROMDEF_PDO 0xC043
+#define ROMDEF_LAST 0xC043
+0, 0xC0,0x3E, 0, PDO,
 
 /* PHALT */
 #undef ROMDEF_LAST
-#define ROMDEF_PHALT 0xC029
-#define ROMDEF_LAST 0xC029
-0, 0xC0,0x24, 0, PHALT,
+#define ROMDEF_PHALT 0xC048
+#define ROMDEF_LAST 0xC048
+0, 0xC0,0x43, 0, PHALT,
 
 /* PILOOP */
 #undef ROMDEF_LAST
-#define ROMDEF_PILOOP 0xC02E
-#define ROMDEF_LAST 0xC02E
-0, 0xC0,0x29, 0, PILOOP,
+#define ROMDEF_PILOOP 0xC04D
+#define ROMDEF_LAST 0xC04D
+0, 0xC0,0x48, 0, PILOOP,
 
 /* PISQUOTE */
 #undef ROMDEF_LAST
-#define ROMDEF_PISQUOTE 0xC033
-#define ROMDEF_LAST 0xC033
-0, 0xC0,0x2E, 0, PISQUOTE,
+#define ROMDEF_PISQUOTE 0xC052
+#define ROMDEF_LAST 0xC052
+0, 0xC0,0x4D, 0, PISQUOTE,
 
 /* PKEY */
 #undef ROMDEF_LAST
-#define ROMDEF_PKEY 0xC038
-#define ROMDEF_LAST 0xC038
-0, 0xC0,0x33, 0, PKEY,
+#define ROMDEF_PKEY 0xC057
+#define ROMDEF_LAST 0xC057
+0, 0xC0,0x52, 0, PKEY,
 
 /* LIT */
 #undef ROMDEF_LAST
-#define ROMDEF_LIT 0xC03D
-#define ROMDEF_LAST 0xC03D
-0, 0xC0,0x38, 0, LIT,
+#define ROMDEF_LIT 0xC05C
+#define ROMDEF_LAST 0xC05C
+0, 0xC0,0x57, 0, LIT,
 
 /* PLOOP */
 #undef ROMDEF_LAST
-#define ROMDEF_PLOOP 0xC042
-#define ROMDEF_LAST 0xC042
-0, 0xC0,0x3D, 0, PLOOP,
+#define ROMDEF_PLOOP 0xC061
+#define ROMDEF_LAST 0xC061
+0, 0xC0,0x5C, 0, PLOOP,
+
+/* PPARK */
+#undef ROMDEF_LAST
+#define ROMDEF_PPARK 0xC066
+#define ROMDEF_LAST 0xC066
+0, 0xC0,0x61, 0, PPARK,
+
+/* PREFILL */
+#undef ROMDEF_LAST
+#define ROMDEF_PREFILL 0xC06B
+#define ROMDEF_LAST 0xC06B
+0, 0xC0,0x66, 0, PREFILL,
 
 /* PSQUOTE */
 #undef ROMDEF_LAST
-#define ROMDEF_PSQUOTE 0xC047
-#define ROMDEF_LAST 0xC047
-0, 0xC0,0x42, 0, PSQUOTE,
+#define ROMDEF_PSQUOTE 0xC070
+#define ROMDEF_LAST 0xC070
+0, 0xC0,0x6B, 0, PSQUOTE,
 
 /* PDOES */
 #undef ROMDEF_LAST
-#define ROMDEF_PDOES 0xC04C
-#define ROMDEF_LAST 0xC04C
-0, 0xC0,0x47, 0, DOCOLONROM,
-RFROM, 0xC0,0x79, 0xC2,0xF9, FETCH, 0xC0,0x6D, ICHARLIT, kNFAtoCFA, PLUS, 0xC3,0xA9, EXIT,
+#define ROMDEF_PDOES 0xC075
+#define ROMDEF_LAST 0xC075
+0, 0xC0,0x70, 0, DOCOLONROM,
+RFROM, 0xC0,0xA7, 0xC2,0xEB, FETCH, 0xC0,0x96, ICHARLIT, kNFAtoCFA, PLUS, 0xC3,0x6B, EXIT,
 
 /* ZBRANCH */
 #undef ROMDEF_LAST
-#define ROMDEF_ZBRANCH 0xC05F
-#define ROMDEF_LAST 0xC05F
-0, 0xC0,0x4C, 0, ZBRANCH,
+#define ROMDEF_ZBRANCH 0xC088
+#define ROMDEF_LAST 0xC088
+0, 0xC0,0x75, 0, ZBRANCH,
 
 /* TOFFIDEF */
 #undef ROMDEF_LAST
-#define ROMDEF_TOFFIDEF 0xC064
-#define ROMDEF_LAST 0xC064
-0, 0xC0,0x5F, 0, DOCOLONROM,
-0xC5,0xDE, FETCH, EXIT,
+#define ROMDEF_TOFFIDEF 0xC08D
+#define ROMDEF_LAST 0xC08D
+0, 0xC0,0x88, 0, DOCOLONROM,
+0xC5,0xA7, FETCH, EXIT,
 
 /* TONFA */
 #undef ROMDEF_LAST
-#define ROMDEF_TONFA 0xC06D
-#define ROMDEF_LAST 0xC06D
-0, 0xC0,0x64, 0, DOCOLONROM,
-0xC3,0xE1, AND, 0xC0,0x00, PLUS, EXIT,
+#define ROMDEF_TONFA 0xC096
+#define ROMDEF_LAST 0xC096
+0, 0xC0,0x8D, 0, DOCOLONROM,
+0xC3,0xA3, AND, 0xC0,0x00, PLUS, EXIT,
+
+/* PUSHSOURCE */
+#undef ROMDEF_LAST
+#define ROMDEF_PUSHSOURCE 0xC0A2
+#define ROMDEF_LAST 0xC0A2
+0, 0xC0,0x96, 0, PUSHSOURCE,
 
 /* TOXT */
 #undef ROMDEF_LAST
-#define ROMDEF_TOXT 0xC079
-#define ROMDEF_LAST 0xC079
-0, 0xC0,0x6D, 0, DOCOLONROM,
-0xC0,0x00, MINUS, 0xC3,0xD6, OR, EXIT,
+#define ROMDEF_TOXT 0xC0A7
+#define ROMDEF_LAST 0xC0A7
+0, 0xC0,0xA2, 0, DOCOLONROM,
+0xC0,0x00, MINUS, 0xC3,0x98, OR, EXIT,
 
 /* QDNEGATE */
 #undef ROMDEF_LAST
-#define ROMDEF_QDNEGATE 0xC085
-#define ROMDEF_LAST 0xC085
-0, 0xC0,0x79, 0, DOCOLONROM,
-ZEROLESS, IZBRANCH, 3, 0xC8,0x78, EXIT,
+#define ROMDEF_QDNEGATE 0xC0B3
+#define ROMDEF_LAST 0xC0B3
+0, 0xC0,0xA7, 0, DOCOLONROM,
+ZEROLESS, IZBRANCH, 3, 0xC8,0x9C, EXIT,
 
 /* QNEGATE */
 #undef ROMDEF_LAST
-#define ROMDEF_QNEGATE 0xC090
-#define ROMDEF_LAST 0xC090
-0, 0xC0,0x85, 0, DOCOLONROM,
+#define ROMDEF_QNEGATE 0xC0BE
+#define ROMDEF_LAST 0xC0BE
+0, 0xC0,0xB3, 0, DOCOLONROM,
 ZEROLESS, IZBRANCH, 2, NEGATE, EXIT,
 
 /* BRANCH */
 #undef ROMDEF_LAST
-#define ROMDEF_BRANCH 0xC09A
-#define ROMDEF_LAST 0xC09A
-0, 0xC0,0x90, 0, BRANCH,
+#define ROMDEF_BRANCH 0xC0C8
+#define ROMDEF_LAST 0xC0C8
+0, 0xC0,0xBE, 0, BRANCH,
 
 /* CFETCHXT */
 #undef ROMDEF_LAST
-#define ROMDEF_CFETCHXT 0xC09F
-#define ROMDEF_LAST 0xC09F
-0, 0xC0,0x9A, 0, DOCOLONROM,
-DUP, ICHARLIT, 14, RSHIFT, ICHARLIT, 3, EQUALS, IZBRANCH, 8, 0xC3,0xE1, AND, TICKROMDEF, PLUS, ICFETCH, EXIT, 0xC0,0x6D, CFETCH, EXIT,
+#define ROMDEF_CFETCHXT 0xC0CD
+#define ROMDEF_LAST 0xC0CD
+0, 0xC0,0xC8, 0, DOCOLONROM,
+DUP, ICHARLIT, 14, RSHIFT, ICHARLIT, 3, EQUALS, IZBRANCH, 8, 0xC3,0xA3, AND, TICKROMDEF, PLUS, ICFETCH, EXIT, 0xC0,0x96, CFETCH, EXIT,
 
 /* CHARLIT */
 #undef ROMDEF_LAST
-#define ROMDEF_CHARLIT 0xC0B8
-#define ROMDEF_LAST 0xC0B8
-0, 0xC0,0x9F, 0, CHARLIT,
+#define ROMDEF_CHARLIT 0xC0E6
+#define ROMDEF_LAST 0xC0E6
+0, 0xC0,0xCD, 0, CHARLIT,
 
 /* COLD */
 #undef ROMDEF_LAST
-#define ROMDEF_COLD 0xC0BD
-#define ROMDEF_LAST 0xC0BD
-0, 0xC0,0xB8, 0, DOCOLONROM,
-PISQUOTE, 31, 'E', 'n', 'f', 'o', 'r', 't', 'h', ' ', '(', 'C', ')', ' ', 'M', 'i', 'c', 'h', 'a', 'e', 'l', ' ', 'A', 'l', 'y', 'n', ' ', 'M', 'i', 'l', 'l', 'e', 'r', 0xC2,0xD4, 0xC7,0xE5, ABORT, EXIT,
-
-/* DIGITQ */
-#undef ROMDEF_LAST
-#define ROMDEF_DIGITQ 0xC0E9
-#define ROMDEF_LAST 0xC0E9
-0, 0xC0,0xBD, 0, DOCOLONROM,
-0xC6,0x35, ICHARLIT, '0', MINUS, DUP, ZEROLESS, IZBRANCH, 4, DROP, ZERO, EXIT, DUP, ICHARLIT, 9, GREATERTHAN, IZBRANCH, 13, DUP, ICHARLIT, 17, LESSTHAN, IZBRANCH, 4, DROP, FALSE, EXIT, ICHARLIT, 7, MINUS, DUP, ONEPLUS, BASE, FETCH, UGREATERTHAN, IZBRANCH, 4, DROP, FALSE, EXIT, TRUE, EXIT,
+#define ROMDEF_COLD 0xC0EB
+#define ROMDEF_LAST 0xC0EB
+0, 0xC0,0xE6, 0, DOCOLONROM,
+0xC0,0x24, FETCH, QDUP, IZBRANCH, 4, EXECUTE, IBRANCH, 38, PISQUOTE, 31, 'E', 'n', 'f', 'o', 'r', 't', 'h', ' ', '(', 'C', ')', ' ', 'M', 'i', 'c', 'h', 'a', 'e', 'l', ' ', 'A', 'l', 'y', 'n', ' ', 'M', 'i', 'l', 'l', 'e', 'r', 0xC2,0xC6, 0xC7,0xDF, ABORT, EXIT,
 
 /* DP */
 #undef ROMDEF_LAST
-#define ROMDEF_DP 0xC118
-#define ROMDEF_LAST 0xC118
-0, 0xC0,0xE9, 0, DOCOLONROM,
-0xC0,0x00, EXIT,
-
-/* ENDLOOP */
-#undef ROMDEF_LAST
-#define ROMDEF_ENDLOOP 0xC120
+#define ROMDEF_DP 0xC120
 #define ROMDEF_LAST 0xC120
-0, 0xC1,0x18, 0, DOCOLONROM,
-0xC7,0x96, 0xC9,0xDC, MINUS, 0xC7,0x34, 0xC0,0x0B, FETCH, 0xC2,0x36, EXIT,
+0, 0xC0,0xEB, 0, DOCOLONROM,
+0xC0,0x00, ICHARLIT, sizeof(EnforthImageHeader), PLUS, EXIT,
 
-/* EVALUATE */
+/* ENDLOOP */
 #undef ROMDEF_LAST
-#define ROMDEF_EVALUATE 0xC132
-#define ROMDEF_LAST 0xC132
+#define ROMDEF_ENDLOOP 0xC12B
+#define ROMDEF_LAST 0xC12B
 0, 0xC1,0x20, 0, DOCOLONROM,
-0xC2,0x90, EXIT,
+0xC7,0x87, 0xCA,0x21, MINUS, 0xC7,0x1E, 0xC0,0x15, FETCH, 0xC2,0x2D, EXIT,
 
 /* FFIQ */
 #undef ROMDEF_LAST
-#define ROMDEF_FFIQ 0xC13A
-#define ROMDEF_LAST 0xC13A
-0, 0xC1,0x32, 0, DOCOLONROM,
-0xC0,0x9F, ICHARLIT, 32, AND, ZERONOTEQUALS, EXIT,
-
-/* FFIDEFARITY */
-#undef ROMDEF_LAST
-#define ROMDEF_FFIDEFARITY 0xC146
-#define ROMDEF_LAST 0xC146
-0, 0xC1,0x3A, 0, DOCOLONROM,
-ICHARLIT, offsetof(EnforthFFIDef, arity), PLUS, ICFETCH, EXIT,
+#define ROMDEF_FFIQ 0xC13D
+#define ROMDEF_LAST 0xC13D
+0, 0xC1,0x2B, 0, DOCOLONROM,
+0xC0,0xCD, ICHARLIT, 32, AND, ZERONOTEQUALS, EXIT,
 
 /* FFIDEFNAME */
 #undef ROMDEF_LAST
-#define ROMDEF_FFIDEFNAME 0xC150
-#define ROMDEF_LAST 0xC150
-0, 0xC1,0x46, 0, DOCOLONROM,
+#define ROMDEF_FFIDEFNAME 0xC149
+#define ROMDEF_LAST 0xC149
+0, 0xC1,0x3D, 0, DOCOLONROM,
 ICHARLIT, offsetof(EnforthFFIDef, name), PLUS, IFETCH, EXIT,
 
 /* FFIDEFNAMELEN */
 #undef ROMDEF_LAST
-#define ROMDEF_FFIDEFNAMELEN 0xC15A
-#define ROMDEF_LAST 0xC15A
-0, 0xC1,0x50, 0, DOCOLONROM,
-0xC1,0x50, DUP, DUP, ICFETCH, IZBRANCH, 4, ONEPLUS, IBRANCH, -6, SWAP, MINUS, EXIT,
+#define ROMDEF_FFIDEFNAMELEN 0xC153
+#define ROMDEF_LAST 0xC153
+0, 0xC1,0x49, 0, DOCOLONROM,
+0xC1,0x49, DUP, DUP, ICFETCH, IZBRANCH, 4, ONEPLUS, IBRANCH, -6, SWAP, MINUS, EXIT,
 
 /* FINDFFIDEF */
 #undef ROMDEF_LAST
-#define ROMDEF_FINDFFIDEF 0xC16C
-#define ROMDEF_LAST 0xC16C
-0, 0xC1,0x5A, 0, DOCOLONROM,
-TWOTOR, VM, ICHARLIT, offsetof(EnforthVM, last_ffi), PLUS, FETCH, QDUP, IZBRANCH, 22, RFETCH, OVER, 0xC1,0x5A, EQUALS, IZBRANCH, 12, DUP, TWORFETCH, ROT, 0xC1,0xC5, IZBRANCH, 5, TWORFROM, TWODROP, TRUE, EXIT, IFETCH, IBRANCH, -23, TWORFROM, TWODROP, FALSE, EXIT,
+#define ROMDEF_FINDFFIDEF 0xC165
+#define ROMDEF_LAST 0xC165
+0, 0xC1,0x53, 0, DOCOLONROM,
+TWOTOR, VM, ICHARLIT, offsetof(EnforthVM, last_ffi), PLUS, FETCH, QDUP, IZBRANCH, 22, RFETCH, OVER, 0xC1,0x53, EQUALS, IZBRANCH, 12, DUP, TWORFETCH, ROT, 0xC1,0xC3, IZBRANCH, 5, TWORFROM, TWODROP, TRUE, EXIT, IFETCH, IBRANCH, -23, TWORFROM, TWODROP, FALSE, EXIT,
+
+/* FINDROMFFI */
+#undef ROMDEF_LAST
+#define ROMDEF_FINDROMFFI 0xC18C
+#define ROMDEF_LAST 0xC18C
+0, 0xC1,0x65, 0, FINDROMFFI,
 
 /* FINDWORD */
 #undef ROMDEF_LAST
-#define ROMDEF_FINDWORD 0xC193
-#define ROMDEF_LAST 0xC193
-0, 0xC1,0x6C, 0, DOCOLONROM,
-TWOTOR, 0xC2,0xF9, FETCH, QDUP, IZBRANCH, 26, DUP, TWORFETCH, ROT, 0xC1,0xE9, IZBRANCH, 15, DUP, 0xC0,0x9F, ICHARLIT, 128, AND, ZERONOTEQUALS, ICHARLIT, 2, AND, ONEMINUS, TWORFROM, TWODROP, EXIT, 0xC3,0x03, IBRANCH, -27, TWORFROM, FALSE, EXIT,
+#define ROMDEF_FINDWORD 0xC191
+#define ROMDEF_LAST 0xC191
+0, 0xC1,0x8C, 0, DOCOLONROM,
+TWOTOR, 0xC2,0xEB, FETCH, QDUP, IZBRANCH, 26, DUP, TWORFETCH, ROT, 0xC1,0xE7, IZBRANCH, 15, DUP, 0xC0,0xCD, ICHARLIT, 128, AND, ZERONOTEQUALS, ICHARLIT, 2, AND, ONEMINUS, TWORFROM, TWODROP, EXIT, 0xC2,0xF5, IBRANCH, -27, TWORFROM, FINDROMFFI, EXIT,
 
 /* FOUNDFFIQ */
 #undef ROMDEF_LAST
-#define ROMDEF_FOUNDFFIQ 0xC1BB
-#define ROMDEF_LAST 0xC1BB
-0, 0xC1,0x93, 0, DOCOLONROM,
-0xC0,0x64, 0xC1,0xC5, EXIT,
+#define ROMDEF_FOUNDFFIQ 0xC1B9
+#define ROMDEF_LAST 0xC1B9
+0, 0xC1,0x91, 0, DOCOLONROM,
+0xC0,0x8D, 0xC1,0xC3, EXIT,
 
 /* FOUNDFFIDEFQ */
 #undef ROMDEF_LAST
-#define ROMDEF_FOUNDFFIDEFQ 0xC1C5
-#define ROMDEF_LAST 0xC1C5
-0, 0xC1,0xBB, 0, DOCOLONROM,
-0xC1,0x50, SWAP, QDUP, IZBRANCH, 23, ONEMINUS, TOR, OVER, CFETCH, OVER, ICFETCH, 0xC8,0x32, IZBRANCH, 6, TWODROP, RFROM, DROP, FALSE, EXIT, ONEPLUS, SWAP, ONEPLUS, SWAP, RFROM, IBRANCH, -24, TWODROP, TRUE, EXIT,
+#define ROMDEF_FOUNDFFIDEFQ 0xC1C3
+#define ROMDEF_LAST 0xC1C3
+0, 0xC1,0xB9, 0, DOCOLONROM,
+0xC1,0x49, SWAP, QDUP, IZBRANCH, 23, ONEMINUS, TOR, OVER, CFETCH, OVER, ICFETCH, 0xC8,0x2B, IZBRANCH, 6, TWODROP, RFROM, DROP, FALSE, EXIT, ONEPLUS, SWAP, ONEPLUS, SWAP, RFROM, IBRANCH, -24, TWODROP, TRUE, EXIT,
 
 /* FOUNDQ */
 #undef ROMDEF_LAST
-#define ROMDEF_FOUNDQ 0xC1E9
-#define ROMDEF_LAST 0xC1E9
-0, 0xC1,0xC5, 0, DOCOLONROM,
-DUP, 0xC0,0x9F, ICHARLIT, 64, AND, ZERONOTEQUALS, IZBRANCH, 5, DROP, TWODROP, FALSE, EXIT, TWODUP, 0xC3,0x0C, NOTEQUALS, IZBRANCH, 5, DROP, TWODROP, FALSE, EXIT, DUP, 0xC1,0x3A, IZBRANCH, 4, 0xC1,0xBB, EXIT, ONEMINUS, SWAP, QDUP, IZBRANCH, 27, ONEMINUS, TOR, OVER, CFETCH, OVER, 0xC0,0x9F, ICHARLIT, 127, AND, 0xC8,0x32, IZBRANCH, 6, TWODROP, RFROM, DROP, FALSE, EXIT, ONEMINUS, SWAP, ONEPLUS, SWAP, RFROM, IBRANCH, -28, TWODROP, TRUE, EXIT,
-
-/* HALT */
-#undef ROMDEF_LAST
-#define ROMDEF_HALT 0xC22F
-#define ROMDEF_LAST 0xC22F
-0, 0xC1,0xE9, 0, DOCOLONROM,
-PHALT, EXIT,
+#define ROMDEF_FOUNDQ 0xC1E7
+#define ROMDEF_LAST 0xC1E7
+0, 0xC1,0xC3, 0, DOCOLONROM,
+DUP, 0xC0,0xCD, ICHARLIT, 64, AND, ZERONOTEQUALS, IZBRANCH, 5, DROP, TWODROP, FALSE, EXIT, TWODUP, 0xC2,0xFE, NOTEQUALS, IZBRANCH, 5, DROP, TWODROP, FALSE, EXIT, DUP, 0xC1,0x3D, IZBRANCH, 4, 0xC1,0xB9, EXIT, ONEMINUS, SWAP, QDUP, IZBRANCH, 27, ONEMINUS, TOR, OVER, CFETCH, OVER, 0xC0,0xCD, ICHARLIT, 127, AND, 0xC8,0x2B, IZBRANCH, 6, TWODROP, RFROM, DROP, FALSE, EXIT, ONEMINUS, SWAP, ONEPLUS, SWAP, RFROM, IBRANCH, -28, TWODROP, TRUE, EXIT,
 
 /* HERETOCHAIN */
 #undef ROMDEF_LAST
-#define ROMDEF_HERETOCHAIN 0xC236
-#define ROMDEF_LAST 0xC236
-0, 0xC2,0x2F, 0, DOCOLONROM,
-QDUP, IZBRANCH, 21, DUP, CFETCH, OVER, DUP, 0xC9,0xDC, SWAP, MINUS, SWAP, CSTORE, QDUP, IZBRANCH, 4, MINUS, IBRANCH, 3, DROP, ZERO, IBRANCH, -22, EXIT,
+#define ROMDEF_HERETOCHAIN 0xC22D
+#define ROMDEF_LAST 0xC22D
+0, 0xC1,0xE7, 0, DOCOLONROM,
+QDUP, IZBRANCH, 21, DUP, CFETCH, OVER, DUP, 0xCA,0x21, SWAP, MINUS, SWAP, CSTORE, QDUP, IZBRANCH, 4, MINUS, IBRANCH, 3, DROP, ZERO, IBRANCH, -22, EXIT,
 
 /* HIDE */
 #undef ROMDEF_LAST
-#define ROMDEF_HIDE 0xC253
-#define ROMDEF_LAST 0xC253
-0, 0xC2,0x36, 0, DOCOLONROM,
-0xC2,0xF9, FETCH, 0xC0,0x6D, DUP, CFETCH, ICHARLIT, 64, OR, SWAP, CSTORE, EXIT,
+#define ROMDEF_HIDE 0xC24A
+#define ROMDEF_LAST 0xC24A
+0, 0xC2,0x2D, 0, DOCOLONROM,
+0xC2,0xEB, FETCH, 0xC0,0x96, DUP, CFETCH, ICHARLIT, 64, OR, SWAP, CSTORE, EXIT,
 
 /* HLD */
 #undef ROMDEF_LAST
-#define ROMDEF_HLD 0xC265
-#define ROMDEF_LAST 0xC265
-0, 0xC2,0x53, 0, DOCOLONROM,
+#define ROMDEF_HLD 0xC25C
+#define ROMDEF_LAST 0xC25C
+0, 0xC2,0x4A, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, hld), PLUS, EXIT,
 
 /* HLDEND */
 #undef ROMDEF_LAST
-#define ROMDEF_HLDEND 0xC26F
-#define ROMDEF_LAST 0xC26F
-0, 0xC2,0x65, 0, DOCOLONROM,
-ICHARLIT, kEnforthCellSize * 8 * 3, EXIT,
+#define ROMDEF_HLDEND 0xC266
+#define ROMDEF_LAST 0xC266
+0, 0xC2,0x5C, 0, HLDEND,
 
 /* IFETCH */
 #undef ROMDEF_LAST
-#define ROMDEF_IFETCH 0xC277
-#define ROMDEF_LAST 0xC277
-0, 0xC2,0x6F, 0, IFETCH,
+#define ROMDEF_IFETCH 0xC26B
+#define ROMDEF_LAST 0xC26B
+0, 0xC2,0x66, 0, IFETCH,
 
 /* IBRANCH */
 #undef ROMDEF_LAST
-#define ROMDEF_IBRANCH 0xC27C
-#define ROMDEF_LAST 0xC27C
-0, 0xC2,0x77, 0, IBRANCH,
+#define ROMDEF_IBRANCH 0xC270
+#define ROMDEF_LAST 0xC270
+0, 0xC2,0x6B, 0, IBRANCH,
 
 /* ICFETCH */
 #undef ROMDEF_LAST
-#define ROMDEF_ICFETCH 0xC281
-#define ROMDEF_LAST 0xC281
-0, 0xC2,0x7C, 0, ICFETCH,
+#define ROMDEF_ICFETCH 0xC275
+#define ROMDEF_LAST 0xC275
+0, 0xC2,0x70, 0, ICFETCH,
 
 /* ICHARLIT */
 #undef ROMDEF_LAST
-#define ROMDEF_ICHARLIT 0xC286
-#define ROMDEF_LAST 0xC286
-0, 0xC2,0x81, 0, ICHARLIT,
+#define ROMDEF_ICHARLIT 0xC27A
+#define ROMDEF_LAST 0xC27A
+0, 0xC2,0x75, 0, ICHARLIT,
 
 /* INITRP */
 #undef ROMDEF_LAST
-#define ROMDEF_INITRP 0xC28B
-#define ROMDEF_LAST 0xC28B
-0, 0xC2,0x86, 0, INITRP,
+#define ROMDEF_INITRP 0xC27F
+#define ROMDEF_LAST 0xC27F
+0, 0xC2,0x7A, 0, INITRP,
 
 /* INTERPRET */
 #undef ROMDEF_LAST
-#define ROMDEF_INTERPRET 0xC290
-#define ROMDEF_LAST 0xC290
-0, 0xC2,0x8B, 0, DOCOLONROM,
-VM, ICHARLIT, offsetof(EnforthVM, source_len), PLUS, TWOSTORE, ZERO, 0xC5,0xF0, STORE, 0xC7,0x23, 0xCB,0x34, DUP, IZBRANCH, 46, 0xC1,0x93, QDUP, IZBRANCH, 16, ONEPLUS, 0xCC,0xC6, FETCH, ZEROEQUALS, OR, IZBRANCH, 4, EXECUTE, IBRANCH, 28, 0xC7,0x96, IBRANCH, 24, 0xC3,0x28, IZBRANCH, 10, 0xCC,0xC6, FETCH, IZBRANCH, 15, 0xCA,0x8A, IBRANCH, 11, 0xCD,0x54, 0xCC,0xA4, ICHARLIT, '?', EMIT, 0xC7,0xE5, ABORT, IBRANCH, -51, TWODROP, EXIT,
+#define ROMDEF_INTERPRET 0xC284
+#define ROMDEF_LAST 0xC284
+0, 0xC2,0x7F, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, DUP, IZBRANCH, 54, 0xC1,0x91, QDUP, IZBRANCH, 16, ONEPLUS, 0xCE,0x2E, FETCH, ZEROEQUALS, OR, IZBRANCH, 4, EXECUTE, IBRANCH, 36, 0xC7,0x87, IBRANCH, 32, NUMBERQ, QDUP, IZBRANCH, 19, 0xCE,0x2E, FETCH, IZBRANCH, 11, ONEMINUS, IZBRANCH, 4, SWAP, 0xCB,0x23, 0xCB,0x23, IBRANCH, 13, DROP, IBRANCH, 10, TYPE, 0xCE,0x0C, ICHARLIT, '?', EMIT, 0xC7,0xDF, ABORT, IBRANCH, -58, TWODROP, EXIT,
 
 /* ITYPE */
 #undef ROMDEF_LAST
-#define ROMDEF_ITYPE 0xC2D4
-#define ROMDEF_LAST 0xC2D4
-0, 0xC2,0x90, 0, DOCOLONROM,
+#define ROMDEF_ITYPE 0xC2C6
+#define ROMDEF_LAST 0xC2C6
+0, 0xC2,0x84, 0, DOCOLONROM,
 OVER, PLUS, SWAP, TWODUP, NOTEQUALS, IZBRANCH, 7, DUP, ICFETCH, EMIT, ONEPLUS, IBRANCH, -9, TWODROP, EXIT,
 
 /* IZBRANCH */
 #undef ROMDEF_LAST
-#define ROMDEF_IZBRANCH 0xC2E8
-#define ROMDEF_LAST 0xC2E8
-0, 0xC2,0xD4, 0, IZBRANCH,
+#define ROMDEF_IZBRANCH 0xC2DA
+#define ROMDEF_LAST 0xC2DA
+0, 0xC2,0xC6, 0, IZBRANCH,
 
 /* LASTTASK */
 #undef ROMDEF_LAST
-#define ROMDEF_LASTTASK 0xC2ED
-#define ROMDEF_LAST 0xC2ED
-0, 0xC2,0xE8, 0, DOCOLONROM,
-0xC0,0x00, 0xC7,0x4F, 0xC7,0x4F, EXIT,
+#define ROMDEF_LASTTASK 0xC2DF
+#define ROMDEF_LAST 0xC2DF
+0, 0xC2,0xDA, 0, DOCOLONROM,
+0xC1,0x20, 0xC7,0x41, 0xC7,0x41, EXIT,
 
 /* LATEST */
 #undef ROMDEF_LAST
-#define ROMDEF_LATEST 0xC2F9
-#define ROMDEF_LAST 0xC2F9
-0, 0xC2,0xED, 0, DOCOLONROM,
-0xC0,0x00, 0xC7,0x4F, EXIT,
+#define ROMDEF_LATEST 0xC2EB
+#define ROMDEF_LAST 0xC2EB
+0, 0xC2,0xDF, 0, DOCOLONROM,
+0xC1,0x20, 0xC7,0x41, EXIT,
 
 /* LFAFETCH */
 #undef ROMDEF_LAST
-#define ROMDEF_LFAFETCH 0xC303
-#define ROMDEF_LAST 0xC303
-0, 0xC2,0xF9, 0, DOCOLONROM,
-ONEPLUS, 0xC3,0xC5, EXIT,
+#define ROMDEF_LFAFETCH 0xC2F5
+#define ROMDEF_LAST 0xC2F5
+0, 0xC2,0xEB, 0, DOCOLONROM,
+ONEPLUS, 0xC3,0x87, EXIT,
 
 /* NAMELENGTH */
 #undef ROMDEF_LAST
-#define ROMDEF_NAMELENGTH 0xC30C
-#define ROMDEF_LAST 0xC30C
-0, 0xC3,0x03, 0, DOCOLONROM,
-0xC0,0x9F, ICHARLIT, 31, AND, EXIT,
+#define ROMDEF_NAMELENGTH 0xC2FE
+#define ROMDEF_LAST 0xC2FE
+0, 0xC2,0xF5, 0, DOCOLONROM,
+0xC0,0xCD, ICHARLIT, 31, AND, EXIT,
 
 /* NFALENGTH */
 #undef ROMDEF_LAST
-#define ROMDEF_NFALENGTH 0xC317
-#define ROMDEF_LAST 0xC317
-0, 0xC3,0x0C, 0, DOCOLONROM,
-DUP, 0xC1,0x3A, IZBRANCH, 5, DROP, ZERO, IBRANCH, 3, 0xC3,0x0C, EXIT,
+#define ROMDEF_NFALENGTH 0xC309
+#define ROMDEF_LAST 0xC309
+0, 0xC2,0xFE, 0, DOCOLONROM,
+DUP, 0xC1,0x3D, IZBRANCH, 5, DROP, ZERO, IBRANCH, 3, 0xC2,0xFE, EXIT,
 
 /* NUMBERQ */
 #undef ROMDEF_LAST
-#define ROMDEF_NUMBERQ 0xC328
-#define ROMDEF_LAST 0xC328
-0, 0xC3,0x17, 0, DOCOLONROM,
-OVER, CFETCH, DUP, ICHARLIT, '-', EQUALS, OVER, ICHARLIT, '+', EQUALS, OR, IZBRANCH, 18, ICHARLIT, '-', EQUALS, IZBRANCH, 4, TRUE, IBRANCH, 2, FALSE, TOR, ICHARLIT, 1, 0xC4,0xF1, RFROM, IBRANCH, 3, DROP, ZERO, TOR, TWODUP, ZERO, ZERO, TWOSWAP, 0xC6,0x01, IZBRANCH, 8, DROP, TWODROP, RFROM, DROP, ZERO, IBRANCH, 10, DROP, TWONIP, DROP, RFROM, ZEROLESS, IZBRANCH, 2, NEGATE, TRUE, EXIT,
+#define ROMDEF_NUMBERQ 0xC31A
+#define ROMDEF_LAST 0xC31A
+0, 0xC3,0x09, 0, NUMBERQ,
+
+/* OPENSOURCE */
+#undef ROMDEF_LAST
+#define ROMDEF_OPENSOURCE 0xC31F
+#define ROMDEF_LAST 0xC31F
+0, 0xC3,0x1A, 0, OPENSOURCE,
 
 /* REVEAL */
 #undef ROMDEF_LAST
-#define ROMDEF_REVEAL 0xC367
-#define ROMDEF_LAST 0xC367
-0, 0xC3,0x28, 0, DOCOLONROM,
-0xC2,0xF9, FETCH, 0xC0,0x6D, DUP, CFETCH, ICHARLIT, 191, AND, SWAP, CSTORE, EXIT,
+#define ROMDEF_REVEAL 0xC324
+#define ROMDEF_LAST 0xC324
+0, 0xC3,0x1F, 0, DOCOLONROM,
+0xC2,0xEB, FETCH, 0xC0,0x96, DUP, CFETCH, ICHARLIT, 191, AND, SWAP, CSTORE, EXIT,
+
+/* POPSOURCE */
+#undef ROMDEF_LAST
+#define ROMDEF_POPSOURCE 0xC336
+#define ROMDEF_LAST 0xC336
+0, 0xC3,0x24, 0, POPSOURCE,
 
 /* TIB */
 #undef ROMDEF_LAST
-#define ROMDEF_TIB 0xC379
-#define ROMDEF_LAST 0xC379
-0, 0xC3,0x67, 0, DOCOLONROM,
+#define ROMDEF_TIB 0xC33B
+#define ROMDEF_LAST 0xC33B
+0, 0xC3,0x36, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, tib), PLUS, EXIT,
 
 /* TIBSIZE */
 #undef ROMDEF_LAST
-#define ROMDEF_TIBSIZE 0xC383
-#define ROMDEF_LAST 0xC383
-0, 0xC3,0x79, 0, DOCOLONROM,
-ICHARLIT, 80, EXIT,
+#define ROMDEF_TIBSIZE 0xC345
+#define ROMDEF_LAST 0xC345
+0, 0xC3,0x3B, 0, DOCOLONROM,
+ICHARLIT, ENFORTH_TIB_SIZE, EXIT,
 
 /* TOKENQ */
 #undef ROMDEF_LAST
-#define ROMDEF_TOKENQ 0xC38B
-#define ROMDEF_LAST 0xC38B
-0, 0xC3,0x83, 0, DOCOLONROM,
-0xC3,0xD6, AND, ZEROEQUALS, EXIT,
+#define ROMDEF_TOKENQ 0xC34D
+#define ROMDEF_LAST 0xC34D
+0, 0xC3,0x45, 0, DOCOLONROM,
+0xC3,0x98, AND, ZEROEQUALS, EXIT,
 
 /* UDSLASHMOD */
 #undef ROMDEF_LAST
-#define ROMDEF_UDSLASHMOD 0xC395
-#define ROMDEF_LAST 0xC395
-0, 0xC3,0x8B, 0, DOCOLONROM,
+#define ROMDEF_UDSLASHMOD 0xC357
+#define ROMDEF_LAST 0xC357
+0, 0xC3,0x4D, 0, DOCOLONROM,
 TOR, ZERO, RFETCH, UMSLASHMOD, RFROM, SWAP, TOR, UMSLASHMOD, RFROM, EXIT,
 
 /* VM */
 #undef ROMDEF_LAST
-#define ROMDEF_VM 0xC3A4
-#define ROMDEF_LAST 0xC3A4
-0, 0xC3,0x95, 0, VM,
+#define ROMDEF_VM 0xC366
+#define ROMDEF_LAST 0xC366
+0, 0xC3,0x57, 0, VM,
 
 /* XTSTORE */
 #undef ROMDEF_LAST
-#define ROMDEF_XTSTORE 0xC3A9
-#define ROMDEF_LAST 0xC3A9
-0, 0xC3,0xA4, 0, DOCOLONROM,
+#define ROMDEF_XTSTORE 0xC36B
+#define ROMDEF_LAST 0xC36B
+0, 0xC3,0x66, 0, DOCOLONROM,
 OVER, ICHARLIT, 8, RSHIFT, OVER, CSTORE, ONEPLUS, CSTORE, EXIT,
 
 /* XTCOMMA */
 #undef ROMDEF_LAST
-#define ROMDEF_XTCOMMA 0xC3B7
-#define ROMDEF_LAST 0xC3B7
-0, 0xC3,0xA9, 0, DOCOLONROM,
-DUP, ICHARLIT, 8, RSHIFT, 0xC7,0x34, 0xC7,0x34, EXIT,
+#define ROMDEF_XTCOMMA 0xC379
+#define ROMDEF_LAST 0xC379
+0, 0xC3,0x6B, 0, DOCOLONROM,
+DUP, ICHARLIT, 8, RSHIFT, 0xC7,0x1E, 0xC7,0x1E, EXIT,
 
 /* XTFETCHXT */
 #undef ROMDEF_LAST
-#define ROMDEF_XTFETCHXT 0xC3C5
-#define ROMDEF_LAST 0xC3C5
-0, 0xC3,0xB7, 0, DOCOLONROM,
-DUP, 0xC0,0x9F, ICHARLIT, 8, LSHIFT, SWAP, ONEPLUS, 0xC0,0x9F, OR, EXIT,
+#define ROMDEF_XTFETCHXT 0xC387
+#define ROMDEF_LAST 0xC387
+0, 0xC3,0x79, 0, DOCOLONROM,
+DUP, 0xC0,0xCD, ICHARLIT, 8, LSHIFT, SWAP, ONEPLUS, 0xC0,0xCD, OR, EXIT,
 
 /* XTFLAG */
 #undef ROMDEF_LAST
-#define ROMDEF_XTFLAG 0xC3D6
-#define ROMDEF_LAST 0xC3D6
-0, 0xC3,0xC5, 0, DOCOLONROM,
+#define ROMDEF_XTFLAG 0xC398
+#define ROMDEF_LAST 0xC398
+0, 0xC3,0x87, 0, DOCOLONROM,
 ICHARLIT, 128, ICHARLIT, 8, LSHIFT, EXIT,
 
 /* XTMASK */
 #undef ROMDEF_LAST
-#define ROMDEF_XTMASK 0xC3E1
-#define ROMDEF_LAST 0xC3E1
-0, 0xC3,0xD6, 0, DOCOLONROM,
+#define ROMDEF_XTMASK 0xC3A3
+#define ROMDEF_LAST 0xC3A3
+0, 0xC3,0x98, 0, DOCOLONROM,
 ICHARLIT, 255, ICHARLIT, 63, ICHARLIT, 8, LSHIFT, OR, EXIT,
 
 /* STORE */
 0x80|'!',
 #undef ROMDEF_LAST
-#define ROMDEF_STORE 0xC3F0
-#define ROMDEF_LAST 0xC3F0
-1, 0xC3,0xE1, 0, STORE,
+#define ROMDEF_STORE 0xC3B2
+#define ROMDEF_LAST 0xC3B2
+1, 0xC3,0xA3, 0, STORE,
 
 /* NUMSIGN */
 0x80|'#',
 #undef ROMDEF_LAST
-#define ROMDEF_NUMSIGN 0xC3F6
-#define ROMDEF_LAST 0xC3F6
-1, 0xC3,0xF0, 0, DOCOLONROM,
-BASE, FETCH, 0xC3,0x95, ROT, DUP, ICHARLIT, 9, GREATERTHAN, ICHARLIT, 7, AND, PLUS, ICHARLIT, 48, PLUS, 0xC9,0xF6, EXIT,
+#define ROMDEF_NUMSIGN 0xC3B8
+#define ROMDEF_LAST 0xC3B8
+1, 0xC3,0xB2, 0, DOCOLONROM,
+BASE, FETCH, 0xC3,0x57, ROT, DUP, ICHARLIT, 9, GREATERTHAN, ICHARLIT, 7, AND, PLUS, ICHARLIT, 48, PLUS, 0xCA,0x3E, EXIT,
 
 /* NUMSIGNGRTR */
 0x80|'>', '#',
 #undef ROMDEF_LAST
-#define ROMDEF_NUMSIGNGRTR 0xC410
-#define ROMDEF_LAST 0xC410
-2, 0xC3,0xF6, 0, DOCOLONROM,
-DROP, DROP, 0xC2,0x65, FETCH, 0xC9,0xDC, 0xC2,0x6F, PLUS, OVER, MINUS, EXIT,
+#define ROMDEF_NUMSIGNGRTR 0xC3D2
+#define ROMDEF_LAST 0xC3D2
+2, 0xC3,0xB8, 0, DOCOLONROM,
+DROP, DROP, 0xC2,0x5C, FETCH, HLDEND, OVER, MINUS, EXIT,
 
 /* NUMSIGNS */
 0x80|'S', '#',
 #undef ROMDEF_LAST
-#define ROMDEF_NUMSIGNS 0xC424
-#define ROMDEF_LAST 0xC424
-2, 0xC4,0x10, 0, DOCOLONROM,
-0xC3,0xF6, TWODUP, OR, IZBRANCH, 3, IBRANCH, -7, EXIT,
+#define ROMDEF_NUMSIGNS 0xC3E2
+#define ROMDEF_LAST 0xC3E2
+2, 0xC3,0xD2, 0, DOCOLONROM,
+0xC3,0xB8, TWODUP, OR, IZBRANCH, 3, IBRANCH, -7, EXIT,
 
 /* TICK */
 0x80|'\'',
 #undef ROMDEF_LAST
-#define ROMDEF_TICK 0xC433
-#define ROMDEF_LAST 0xC433
-1, 0xC4,0x24, 0, DOCOLONROM,
-0xC7,0x23, 0xCB,0x34, 0xC1,0x93, ZEROEQUALS, IZBRANCH, 11, 0xCD,0x54, 0xCC,0xA4, ICHARLIT, '?', EMIT, 0xC7,0xE5, ABORT, EXIT,
+#define ROMDEF_TICK 0xC3F1
+#define ROMDEF_LAST 0xC3F1
+1, 0xC3,0xE2, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, 0xC1,0x91, ZEROEQUALS, IZBRANCH, 10, TYPE, 0xCE,0x0C, ICHARLIT, '?', EMIT, 0xC7,0xDF, ABORT, EXIT,
 
 /* PAREN */
 0x80|'(',
 #undef ROMDEF_LAST
-#define ROMDEF_PAREN 0xC44D
-#define ROMDEF_LAST 0xC44D
-0x80|1, 0xC4,0x33, 0, DOCOLONROM,
-ICHARLIT, ')', 0xCB,0x34, TWODROP, EXIT,
+#define ROMDEF_PAREN 0xC409
+#define ROMDEF_LAST 0xC409
+0x80|1, 0xC3,0xF1, 0, DOCOLONROM,
+ICHARLIT, ')', PARSE, TWODROP, EXIT,
 
 /* STAR */
 0x80|'*',
 #undef ROMDEF_LAST
-#define ROMDEF_STAR 0xC459
-#define ROMDEF_LAST 0xC459
-1, 0xC4,0x4D, 0, DOCOLONROM,
+#define ROMDEF_STAR 0xC414
+#define ROMDEF_LAST 0xC414
+1, 0xC4,0x09, 0, DOCOLONROM,
 UMSTAR, DROP, EXIT,
 
 /* STARSLASH */
 0x80|'/', '*',
 #undef ROMDEF_LAST
-#define ROMDEF_STARSLASH 0xC463
-#define ROMDEF_LAST 0xC463
-2, 0xC4,0x59, 0, DOCOLONROM,
-0xC4,0x71, NIP, EXIT,
+#define ROMDEF_STARSLASH 0xC41E
+#define ROMDEF_LAST 0xC41E
+2, 0xC4,0x14, 0, DOCOLONROM,
+0xC4,0x2C, NIP, EXIT,
 
 /* STARSLASHMOD */
 0x80|'D', 'O', 'M', '/', '*',
 #undef ROMDEF_LAST
-#define ROMDEF_STARSLASHMOD 0xC471
-#define ROMDEF_LAST 0xC471
-5, 0xC4,0x63, 0, DOCOLONROM,
-TOR, 0xCA,0xCA, RFROM, 0xCC,0x75, EXIT,
+#define ROMDEF_STARSLASHMOD 0xC42C
+#define ROMDEF_LAST 0xC42C
+5, 0xC4,0x1E, 0, DOCOLONROM,
+TOR, 0xCB,0x63, RFROM, 0xCD,0xC9, EXIT,
 
 /* PLUS */
 0x80|'+',
 #undef ROMDEF_LAST
-#define ROMDEF_PLUS 0xC47E
-#define ROMDEF_LAST 0xC47E
-1, 0xC4,0x71, 0, PLUS,
+#define ROMDEF_PLUS 0xC439
+#define ROMDEF_LAST 0xC439
+1, 0xC4,0x2C, 0, PLUS,
 
 /* PLUSSTORE */
 0x80|'!', '+',
 #undef ROMDEF_LAST
-#define ROMDEF_PLUSSTORE 0xC485
-#define ROMDEF_LAST 0xC485
-2, 0xC4,0x7E, 0, PLUSSTORE,
+#define ROMDEF_PLUSSTORE 0xC440
+#define ROMDEF_LAST 0xC440
+2, 0xC4,0x39, 0, PLUSSTORE,
 
 /* PLUSLOOP */
 0x80|'P', 'O', 'O', 'L', '+',
 #undef ROMDEF_LAST
-#define ROMDEF_PLUSLOOP 0xC48F
-#define ROMDEF_LAST 0xC48F
-0x80|5, 0xC4,0x85, 0, DOCOLONROM,
-ICHARLIT, PPLUSLOOP, 0xC1,0x20, EXIT,
+#define ROMDEF_PLUSLOOP 0xC44A
+#define ROMDEF_LAST 0xC44A
+0x80|5, 0xC4,0x40, 0, DOCOLONROM,
+ICHARLIT, PPLUSLOOP, 0xC1,0x2B, EXIT,
 
 /* COMMA */
 0x80|',',
 #undef ROMDEF_LAST
-#define ROMDEF_COMMA 0xC49A
-#define ROMDEF_LAST 0xC49A
-1, 0xC4,0x8F, 0, DOCOLONROM,
-0xC9,0xDC, STORE, ICHARLIT, 1, 0xC7,0x5D, 0xC6,0xFA, EXIT,
+#define ROMDEF_COMMA 0xC455
+#define ROMDEF_LAST 0xC455
+1, 0xC4,0x4A, 0, DOCOLONROM,
+0xCA,0x21, STORE, ICHARLIT, 1, 0xC7,0x4F, 0xC6,0xBF, EXIT,
 
 /* MINUS */
 0x80|'-',
 #undef ROMDEF_LAST
-#define ROMDEF_MINUS 0xC4AA
-#define ROMDEF_LAST 0xC4AA
-1, 0xC4,0x9A, 0, MINUS,
+#define ROMDEF_MINUS 0xC465
+#define ROMDEF_LAST 0xC465
+1, 0xC4,0x55, 0, MINUS,
 
 /* DOT */
 0x80|'.',
 #undef ROMDEF_LAST
-#define ROMDEF_DOT 0xC4B0
-#define ROMDEF_LAST 0xC4B0
-1, 0xC4,0xAA, 0, DOCOLONROM,
-BASE, FETCH, ICHARLIT, 10, NOTEQUALS, IZBRANCH, 4, 0xCD,0x6A, EXIT, DUP, ABS, ZERO, 0xC5,0xB8, 0xC4,0x24, ROT, 0xCC,0x62, 0xC4,0x10, 0xCD,0x54, 0xCC,0xA4, EXIT,
+#define ROMDEF_DOT 0xC46B
+#define ROMDEF_LAST 0xC46B
+1, 0xC4,0x65, 0, DOCOLONROM,
+BASE, FETCH, ICHARLIT, 10, NOTEQUALS, IZBRANCH, 4, 0xCE,0xB9, EXIT, 0xCD,0x08, ZERO, DDOTR, 0xCE,0x0C, EXIT,
+
+/* DOTFFISTATS */
+0x80|'S', 'T', 'A', 'T', 'S', '-', 'I', 'F', 'F', '.',
+#undef ROMDEF_LAST
+#define ROMDEF_DOTFFISTATS 0xC48B
+#define ROMDEF_LAST 0xC48B
+10, 0xC4,0x6B, 0, DOTFFISTATS,
+
+/* DOTR */
+0x80|'R', '.',
+#undef ROMDEF_LAST
+#define ROMDEF_DOTR 0xC492
+#define ROMDEF_LAST 0xC492
+2, 0xC4,0x8B, 0, DOCOLONROM,
+TOR, 0xCD,0x08, RFROM, DDOTR, EXIT,
 
 /* SLASH */
 0x80|'/',
 #undef ROMDEF_LAST
-#define ROMDEF_SLASH 0xC4D1
-#define ROMDEF_LAST 0xC4D1
-1, 0xC4,0xB0, 0, DOCOLONROM,
-0xC4,0xDE, NIP, EXIT,
+#define ROMDEF_SLASH 0xC49E
+#define ROMDEF_LAST 0xC49E
+1, 0xC4,0x92, 0, DOCOLONROM,
+0xC4,0xAB, NIP, EXIT,
 
 /* SLASHMOD */
 0x80|'D', 'O', 'M', '/',
 #undef ROMDEF_LAST
-#define ROMDEF_SLASHMOD 0xC4DE
-#define ROMDEF_LAST 0xC4DE
-4, 0xC4,0xD1, 0, DOCOLONROM,
-TOR, 0xCC,0x4D, RFROM, 0xCC,0x75, EXIT,
+#define ROMDEF_SLASHMOD 0xC4AB
+#define ROMDEF_LAST 0xC4AB
+4, 0xC4,0x9E, 0, DOCOLONROM,
+TOR, 0xCD,0x08, RFROM, 0xCD,0xC9, EXIT,
 
 /* SLASHSTRING */
 0x80|'G', 'N', 'I', 'R', 'T', 'S', '/',
 #undef ROMDEF_LAST
-#define ROMDEF_SLASHSTRING 0xC4F1
-#define ROMDEF_LAST 0xC4F1
-7, 0xC4,0xDE, 0, DOCOLONROM,
+#define ROMDEF_SLASHSTRING 0xC4BE
+#define ROMDEF_LAST 0xC4BE
+7, 0xC4,0xAB, 0, DOCOLONROM,
 ROT, OVER, PLUS, ROT, ROT, MINUS, EXIT,
 
 /* ZERO */
 0x80|'0',
 #undef ROMDEF_LAST
-#define ROMDEF_ZERO 0xC4FE
-#define ROMDEF_LAST 0xC4FE
-1, 0xC4,0xF1, 0, ZERO,
+#define ROMDEF_ZERO 0xC4CB
+#define ROMDEF_LAST 0xC4CB
+1, 0xC4,0xBE, 0, ZERO,
 
 /* ZEROLESS */
 0x80|'<', '0',
 #undef ROMDEF_LAST
-#define ROMDEF_ZEROLESS 0xC505
-#define ROMDEF_LAST 0xC505
-2, 0xC4,0xFE, 0, ZEROLESS,
+#define ROMDEF_ZEROLESS 0xC4D2
+#define ROMDEF_LAST 0xC4D2
+2, 0xC4,0xCB, 0, ZEROLESS,
 
 /* ZERONOTEQUALS */
 0x80|'>', '<', '0',
 #undef ROMDEF_LAST
-#define ROMDEF_ZERONOTEQUALS 0xC50D
-#define ROMDEF_LAST 0xC50D
-3, 0xC5,0x05, 0, ZERONOTEQUALS,
+#define ROMDEF_ZERONOTEQUALS 0xC4DA
+#define ROMDEF_LAST 0xC4DA
+3, 0xC4,0xD2, 0, ZERONOTEQUALS,
 
 /* ZEROEQUALS */
 0x80|'=', '0',
 #undef ROMDEF_LAST
-#define ROMDEF_ZEROEQUALS 0xC514
-#define ROMDEF_LAST 0xC514
-2, 0xC5,0x0D, 0, ZEROEQUALS,
+#define ROMDEF_ZEROEQUALS 0xC4E1
+#define ROMDEF_LAST 0xC4E1
+2, 0xC4,0xDA, 0, ZEROEQUALS,
 
 /* ONEPLUS */
 0x80|'+', '1',
 #undef ROMDEF_LAST
-#define ROMDEF_ONEPLUS 0xC51B
-#define ROMDEF_LAST 0xC51B
-2, 0xC5,0x14, 0, ONEPLUS,
+#define ROMDEF_ONEPLUS 0xC4E8
+#define ROMDEF_LAST 0xC4E8
+2, 0xC4,0xE1, 0, ONEPLUS,
 
 /* ONEMINUS */
 0x80|'-', '1',
 #undef ROMDEF_LAST
-#define ROMDEF_ONEMINUS 0xC522
-#define ROMDEF_LAST 0xC522
-2, 0xC5,0x1B, 0, ONEMINUS,
+#define ROMDEF_ONEMINUS 0xC4EF
+#define ROMDEF_LAST 0xC4EF
+2, 0xC4,0xE8, 0, ONEMINUS,
 
 /* TWOSTORE */
 0x80|'!', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOSTORE 0xC529
-#define ROMDEF_LAST 0xC529
-2, 0xC5,0x22, 0, TWOSTORE,
+#define ROMDEF_TWOSTORE 0xC4F6
+#define ROMDEF_LAST 0xC4F6
+2, 0xC4,0xEF, 0, TWOSTORE,
 
 /* TWOSTAR */
 0x80|'*', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOSTAR 0xC530
-#define ROMDEF_LAST 0xC530
-2, 0xC5,0x29, 0, TWOSTAR,
+#define ROMDEF_TWOSTAR 0xC4FD
+#define ROMDEF_LAST 0xC4FD
+2, 0xC4,0xF6, 0, TWOSTAR,
 
 /* TWOSLASH */
 0x80|'/', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOSLASH 0xC537
-#define ROMDEF_LAST 0xC537
-2, 0xC5,0x30, 0, TWOSLASH,
+#define ROMDEF_TWOSLASH 0xC504
+#define ROMDEF_LAST 0xC504
+2, 0xC4,0xFD, 0, TWOSLASH,
 
 /* TWOTOR */
 0x80|'R', '>', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOTOR 0xC53F
-#define ROMDEF_LAST 0xC53F
-3, 0xC5,0x37, 0, TWOTOR,
+#define ROMDEF_TWOTOR 0xC50C
+#define ROMDEF_LAST 0xC50C
+3, 0xC5,0x04, 0, TWOTOR,
 
 /* TWOFETCH */
 0x80|'@', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOFETCH 0xC546
-#define ROMDEF_LAST 0xC546
-2, 0xC5,0x3F, 0, TWOFETCH,
+#define ROMDEF_TWOFETCH 0xC513
+#define ROMDEF_LAST 0xC513
+2, 0xC5,0x0C, 0, TWOFETCH,
 
 /* TWODROP */
 0x80|'P', 'O', 'R', 'D', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWODROP 0xC550
-#define ROMDEF_LAST 0xC550
-5, 0xC5,0x46, 0, TWODROP,
+#define ROMDEF_TWODROP 0xC51D
+#define ROMDEF_LAST 0xC51D
+5, 0xC5,0x13, 0, TWODROP,
 
 /* TWODUP */
 0x80|'P', 'U', 'D', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWODUP 0xC559
-#define ROMDEF_LAST 0xC559
-4, 0xC5,0x50, 0, TWODUP,
+#define ROMDEF_TWODUP 0xC526
+#define ROMDEF_LAST 0xC526
+4, 0xC5,0x1D, 0, TWODUP,
 
 /* TWONIP */
 0x80|'P', 'I', 'N', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWONIP 0xC562
-#define ROMDEF_LAST 0xC562
-4, 0xC5,0x59, 0, TWONIP,
+#define ROMDEF_TWONIP 0xC52F
+#define ROMDEF_LAST 0xC52F
+4, 0xC5,0x26, 0, TWONIP,
 
 /* TWOOVER */
 0x80|'R', 'E', 'V', 'O', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOOVER 0xC56C
-#define ROMDEF_LAST 0xC56C
-5, 0xC5,0x62, 0, TWOOVER,
+#define ROMDEF_TWOOVER 0xC539
+#define ROMDEF_LAST 0xC539
+5, 0xC5,0x2F, 0, TWOOVER,
 
 /* TWORFROM */
 0x80|'>', 'R', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWORFROM 0xC574
-#define ROMDEF_LAST 0xC574
-3, 0xC5,0x6C, 0, TWORFROM,
+#define ROMDEF_TWORFROM 0xC541
+#define ROMDEF_LAST 0xC541
+3, 0xC5,0x39, 0, TWORFROM,
 
 /* TWORFETCH */
 0x80|'@', 'R', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWORFETCH 0xC57C
-#define ROMDEF_LAST 0xC57C
-3, 0xC5,0x74, 0, TWORFETCH,
+#define ROMDEF_TWORFETCH 0xC549
+#define ROMDEF_LAST 0xC549
+3, 0xC5,0x41, 0, TWORFETCH,
 
 /* TWOSWAP */
 0x80|'P', 'A', 'W', 'S', '2',
 #undef ROMDEF_LAST
-#define ROMDEF_TWOSWAP 0xC586
-#define ROMDEF_LAST 0xC586
-5, 0xC5,0x7C, 0, TWOSWAP,
+#define ROMDEF_TWOSWAP 0xC553
+#define ROMDEF_LAST 0xC553
+5, 0xC5,0x49, 0, TWOSWAP,
 
 /* COLON */
 0x80|':',
 #undef ROMDEF_LAST
-#define ROMDEF_COLON 0xC58C
-#define ROMDEF_LAST 0xC58C
-1, 0xC5,0x86, 0, DOCOLONROM,
-0xC7,0xF4, 0xC2,0x53, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xFA, ICHARLIT, DOCOLON, 0xC3,0xB7, 0xCE,0xE5, EXIT,
+#define ROMDEF_COLON 0xC559
+#define ROMDEF_LAST 0xC559
+1, 0xC5,0x53, 0, DOCOLONROM,
+0xC7,0xEE, 0xC2,0x4A, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xBF, ICHARLIT, DOCOLON, 0xC3,0x79, 0xD0,0x39, EXIT,
 
 /* SEMICOLON */
 0x80|';',
 #undef ROMDEF_LAST
-#define ROMDEF_SEMICOLON 0xC5A2
-#define ROMDEF_LAST 0xC5A2
-0x80|1, 0xC5,0x8C, 0, DOCOLONROM,
-ICHARLIT, EXIT, 0xC7,0x96, 0xC3,0x67, 0xCE,0xA8, EXIT,
+#define ROMDEF_SEMICOLON 0xC56F
+#define ROMDEF_LAST 0xC56F
+0x80|1, 0xC5,0x59, 0, DOCOLONROM,
+ICHARLIT, EXIT, 0xC7,0x87, 0xC3,0x24, 0xCF,0xFE, EXIT,
 
 /* LESSTHAN */
 0x80|'<',
 #undef ROMDEF_LAST
-#define ROMDEF_LESSTHAN 0xC5B1
-#define ROMDEF_LAST 0xC5B1
-1, 0xC5,0xA2, 0, LESSTHAN,
+#define ROMDEF_LESSTHAN 0xC57E
+#define ROMDEF_LAST 0xC57E
+1, 0xC5,0x6F, 0, LESSTHAN,
 
 /* LESSNUMSIGN */
 0x80|'#', '<',
 #undef ROMDEF_LAST
-#define ROMDEF_LESSNUMSIGN 0xC5B8
-#define ROMDEF_LAST 0xC5B8
-2, 0xC5,0xB1, 0, DOCOLONROM,
-0xC9,0xDC, 0xC2,0x6F, PLUS, 0xC2,0x65, STORE, EXIT,
+#define ROMDEF_LESSNUMSIGN 0xC585
+#define ROMDEF_LAST 0xC585
+2, 0xC5,0x7E, 0, DOCOLONROM,
+HLDEND, 0xC2,0x5C, STORE, EXIT,
 
 /* NOTEQUALS */
 0x80|'>', '<',
 #undef ROMDEF_LAST
-#define ROMDEF_NOTEQUALS 0xC5C8
-#define ROMDEF_LAST 0xC5C8
-2, 0xC5,0xB8, 0, NOTEQUALS,
+#define ROMDEF_NOTEQUALS 0xC591
+#define ROMDEF_LAST 0xC591
+2, 0xC5,0x85, 0, NOTEQUALS,
 
 /* EQUALS */
 0x80|'=',
 #undef ROMDEF_LAST
-#define ROMDEF_EQUALS 0xC5CE
-#define ROMDEF_LAST 0xC5CE
-1, 0xC5,0xC8, 0, EQUALS,
+#define ROMDEF_EQUALS 0xC597
+#define ROMDEF_LAST 0xC597
+1, 0xC5,0x91, 0, EQUALS,
 
 /* GREATERTHAN */
 0x80|'>',
 #undef ROMDEF_LAST
-#define ROMDEF_GREATERTHAN 0xC5D4
-#define ROMDEF_LAST 0xC5D4
-1, 0xC5,0xCE, 0, GREATERTHAN,
+#define ROMDEF_GREATERTHAN 0xC59D
+#define ROMDEF_LAST 0xC59D
+1, 0xC5,0x97, 0, GREATERTHAN,
 
 /* TOBODY */
 0x80|'Y', 'D', 'O', 'B', '>',
 #undef ROMDEF_LAST
-#define ROMDEF_TOBODY 0xC5DE
-#define ROMDEF_LAST 0xC5DE
-5, 0xC5,0xD4, 0, DOCOLONROM,
-0xC3,0xE1, AND, 0xC0,0x00, PLUS, ICHARLIT, kNFAtoPFA, PLUS, EXIT,
+#define ROMDEF_TOBODY 0xC5A7
+#define ROMDEF_LAST 0xC5A7
+5, 0xC5,0x9D, 0, DOCOLONROM,
+0xC3,0xA3, AND, 0xC0,0x00, PLUS, ICHARLIT, kNFAtoPFA, PLUS, EXIT,
 
 /* TOIN */
 0x80|'N', 'I', '>',
 #undef ROMDEF_LAST
-#define ROMDEF_TOIN 0xC5F0
-#define ROMDEF_LAST 0xC5F0
-3, 0xC5,0xDE, 0, DOCOLONROM,
+#define ROMDEF_TOIN 0xC5B9
+#define ROMDEF_LAST 0xC5B9
+3, 0xC5,0xA7, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, to_in), PLUS, EXIT,
 
 /* TONUMBER */
 0x80|'R', 'E', 'B', 'M', 'U', 'N', '>',
 #undef ROMDEF_LAST
-#define ROMDEF_TONUMBER 0xC601
-#define ROMDEF_LAST 0xC601
-7, 0xC5,0xF0, 0, DOCOLONROM,
-DUP, IZBRANCH, 31, OVER, CFETCH, 0xC0,0xE9, ZEROEQUALS, IZBRANCH, 2, EXIT, TOR, TWOSWAP, BASE, FETCH, DUP, TOR, UMSTAR, DROP, SWAP, RFROM, UMSTAR, ROT, PLUS, RFROM, MPLUS, TWOSWAP, ICHARLIT, 1, 0xC4,0xF1, IBRANCH, -32, EXIT,
+#define ROMDEF_TONUMBER 0xC5CA
+#define ROMDEF_LAST 0xC5CA
+7, 0xC5,0xB9, 0, TONUMBER,
 
 /* TOR */
 0x80|'R', '>',
 #undef ROMDEF_LAST
-#define ROMDEF_TOR 0xC62A
-#define ROMDEF_LAST 0xC62A
-2, 0xC6,0x01, 0, TOR,
+#define ROMDEF_TOR 0xC5D1
+#define ROMDEF_LAST 0xC5D1
+2, 0xC5,0xCA, 0, TOR,
 
 /* TOUPPER */
 0x80|'R', 'E', 'P', 'P', 'U', '>',
 #undef ROMDEF_LAST
-#define ROMDEF_TOUPPER 0xC635
-#define ROMDEF_LAST 0xC635
-6, 0xC6,0x2A, 0, DOCOLONROM,
+#define ROMDEF_TOUPPER 0xC5DC
+#define ROMDEF_LAST 0xC5DC
+6, 0xC5,0xD1, 0, DOCOLONROM,
 DUP, ICHARLIT, 'a', ONEMINUS, GREATERTHAN, OVER, ICHARLIT, 'z', ONEPLUS, LESSTHAN, AND, IZBRANCH, 4, ICHARLIT, 32, MINUS, EXIT,
 
+/* QDEQUEUE */
+0x80|'E', 'U', 'E', 'U', 'Q', 'E', 'D', '?',
+#undef ROMDEF_LAST
+#define ROMDEF_QDEQUEUE 0xC5FA
+#define ROMDEF_LAST 0xC5FA
+8, 0xC5,0xDC, 0, QDEQUEUE,
+
 /* QDO */
 0x80|'O', 'D', '?',
 #undef ROMDEF_LAST
-#define ROMDEF_QDO 0xC64E
-#define ROMDEF_LAST 0xC64E
-0x80|3, 0xC6,0x35, 0, DOCOLONROM,
-ICHARLIT, PQDO, 0xC7,0x96, 0xC9,0xDC, 0xC0,0x0B, STORE, ZERO, 0xC7,0x34, 0xC9,0xDC, EXIT,
+#define ROMDEF_QDO 0xC602
+#define ROMDEF_LAST 0xC602
+0x80|3, 0xC5,0xFA, 0, DOCOLONROM,
+ICHARLIT, PQDO, 0xC7,0x87, 0xCA,0x21, 0xC0,0x15, STORE, ZERO, 0xC7,0x1E, 0xCA,0x21, EXIT,
 
 /* QDUP */
 0x80|'P', 'U', 'D', '?',
 #undef ROMDEF_LAST
-#define ROMDEF_QDUP 0xC666
-#define ROMDEF_LAST 0xC666
-4, 0xC6,0x4E, 0, QDUP,
+#define ROMDEF_QDUP 0xC61A
+#define ROMDEF_LAST 0xC61A
+4, 0xC6,0x02, 0, QDUP,
+
+/* QRECEIVE */
+0x80|'E', 'V', 'I', 'E', 'C', 'E', 'R', '?',
+#undef ROMDEF_LAST
+#define ROMDEF_QRECEIVE 0xC627
+#define ROMDEF_LAST 0xC627
+8, 0xC6,0x1A, 0, QRECEIVE,
 
 /* FETCH */
 0x80|'@',
 #undef ROMDEF_LAST
-#define ROMDEF_FETCH 0xC66C
-#define ROMDEF_LAST 0xC66C
-1, 0xC6,0x66, 0, FETCH,
+#define ROMDEF_FETCH 0xC62D
+#define ROMDEF_LAST 0xC62D
+1, 0xC6,0x27, 0, FETCH,
 
 /* ABORT */
 0x80|'T', 'R', 'O', 'B', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ABORT 0xC676
-#define ROMDEF_LAST 0xC676
-5, 0xC6,0x6C, 0, ABORT,
+#define ROMDEF_ABORT 0xC637
+#define ROMDEF_LAST 0xC637
+5, 0xC6,0x2D, 0, ABORT,
 
 /* ABS */
 0x80|'S', 'B', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ABS 0xC67E
-#define ROMDEF_LAST 0xC67E
-3, 0xC6,0x76, 0, ABS,
+#define ROMDEF_ABS 0xC63F
+#define ROMDEF_LAST 0xC63F
+3, 0xC6,0x37, 0, ABS,
 
 /* ACCEPT */
 0x80|'T', 'P', 'E', 'C', 'C', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ACCEPT 0xC689
-#define ROMDEF_LAST 0xC689
-6, 0xC6,0x7E, 0, DOCOLONROM,
-OVER, PLUS, OVER, 0xCA,0x4B, DUP, ICHARLIT, 10, NOTEQUALS, IZBRANCH, 44, DUP, ICHARLIT, 8, EQUALS, OVER, ICHARLIT, 127, EQUALS, OR, IZBRANCH, 19, TWOOVER, DROP, NIP, OVER, NOTEQUALS, IZBRANCH, 10, ONEMINUS, ICHARLIT, 8, EMIT, 0xCC,0xA4, ICHARLIT, 8, EMIT, IBRANCH, 13, DUP, TWOOVER, NOTEQUALS, IZBRANCH, 7, EMIT, OVER, CSTORE, ONEPLUS, IBRANCH, 2, TWODROP, IBRANCH, -50, DROP, NIP, SWAP, MINUS, EXIT,
+#define ROMDEF_ACCEPT 0xC64A
+#define ROMDEF_LAST 0xC64A
+6, 0xC6,0x3F, 0, DOCOLONROM,
+PACCEPT, IZBRANCH, 2, EXIT, OVER, PLUS, OVER, 0xCA,0xDE, DUP, ICHARLIT, 10, NOTEQUALS, IZBRANCH, 44, DUP, ICHARLIT, 8, EQUALS, OVER, ICHARLIT, 127, EQUALS, OR, IZBRANCH, 19, TWOOVER, DROP, NIP, OVER, NOTEQUALS, IZBRANCH, 10, ONEMINUS, ICHARLIT, 8, EMIT, 0xCE,0x0C, ICHARLIT, 8, EMIT, IBRANCH, 13, DUP, TWOOVER, NOTEQUALS, IZBRANCH, 7, EMIT, OVER, CSTORE, ONEPLUS, IBRANCH, 2, TWODROP, IBRANCH, -50, DROP, NIP, SWAP, MINUS, EXIT,
 
 /* AGAIN */
 0x80|'N', 'I', 'A', 'G', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_AGAIN 0xC6CE
-#define ROMDEF_LAST 0xC6CE
-0x80|5, 0xC6,0x89, 0, DOCOLONROM,
-ICHARLIT, BRANCH, 0xC7,0x96, 0xC9,0xDC, MINUS, 0xC7,0x34, EXIT,
+#define ROMDEF_AGAIN 0xC693
+#define ROMDEF_LAST 0xC693
+0x80|5, 0xC6,0x4A, 0, DOCOLONROM,
+ICHARLIT, BRANCH, 0xC7,0x87, 0xCA,0x21, MINUS, 0xC7,0x1E, EXIT,
 
 /* ALIGN */
 0x80|'N', 'G', 'I', 'L', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ALIGN 0xC6E2
-#define ROMDEF_LAST 0xC6E2
-5, 0xC6,0xCE, 0, DOCOLONROM,
+#define ROMDEF_ALIGN 0xC6A7
+#define ROMDEF_LAST 0xC6A7
+5, 0xC6,0x93, 0, DOCOLONROM,
 EXIT,
 
 /* ALIGNED */
 0x80|'D', 'E', 'N', 'G', 'I', 'L', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ALIGNED 0xC6EF
-#define ROMDEF_LAST 0xC6EF
-7, 0xC6,0xE2, 0, DOCOLONROM,
+#define ROMDEF_ALIGNED 0xC6B4
+#define ROMDEF_LAST 0xC6B4
+7, 0xC6,0xA7, 0, DOCOLONROM,
 EXIT,
 
 /* ALLOT */
 0x80|'T', 'O', 'L', 'L', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_ALLOT 0xC6FA
-#define ROMDEF_LAST 0xC6FA
-5, 0xC6,0xEF, 0, DOCOLONROM,
-0xC1,0x18, PLUSSTORE, EXIT,
+#define ROMDEF_ALLOT 0xC6BF
+#define ROMDEF_LAST 0xC6BF
+5, 0xC6,0xB4, 0, DOCOLONROM,
+0xC1,0x20, PLUSSTORE, EXIT,
 
 /* AND */
 0x80|'D', 'N', 'A',
 #undef ROMDEF_LAST
-#define ROMDEF_AND 0xC706
-#define ROMDEF_LAST 0xC706
-3, 0xC6,0xFA, 0, AND,
+#define ROMDEF_AND 0xC6CB
+#define ROMDEF_LAST 0xC6CB
+3, 0xC6,0xBF, 0, AND,
+
+/* ATOMICSTORE */
+0x80|'!', 'C', 'I', 'M', 'O', 'T', 'A',
+#undef ROMDEF_LAST
+#define ROMDEF_ATOMICSTORE 0xC6D7
+#define ROMDEF_LAST 0xC6D7
+7, 0xC6,0xCB, 0, ATOMICSTORE,
+
+/* ATOMICFETCH */
+0x80|'@', 'C', 'I', 'M', 'O', 'T', 'A',
+#undef ROMDEF_LAST
+#define ROMDEF_ATOMICFETCH 0xC6E3
+#define ROMDEF_LAST 0xC6E3
+7, 0xC6,0xD7, 0, ATOMICFETCH,
 
 /* BASE */
 0x80|'E', 'S', 'A', 'B',
 #undef ROMDEF_LAST
-#define ROMDEF_BASE 0xC70F
-#define ROMDEF_LAST 0xC70F
-4, 0xC7,0x06, 0, BASE,
+#define ROMDEF_BASE 0xC6EC
+#define ROMDEF_LAST 0xC6EC
+4, 0xC6,0xE3, 0, BASE,
 
 /* BEGIN */
 0x80|'N', 'I', 'G', 'E', 'B',
 #undef ROMDEF_LAST
-#define ROMDEF_BEGIN 0xC719
-#define ROMDEF_LAST 0xC719
-0x80|5, 0xC7,0x0F, 0, DOCOLONROM,
-0xC9,0xDC, EXIT,
+#define ROMDEF_BEGIN 0xC6F6
+#define ROMDEF_LAST 0xC6F6
+0x80|5, 0xC6,0xEC, 0, DOCOLONROM,
+0xCA,0x21, EXIT,
 
 /* BL */
 0x80|'L', 'B',
 #undef ROMDEF_LAST
-#define ROMDEF_BL 0xC723
-#define ROMDEF_LAST 0xC723
-2, 0xC7,0x19, 0, DOCOLONROM,
+#define ROMDEF_BL 0xC700
+#define ROMDEF_LAST 0xC700
+2, 0xC6,0xF6, 0, DOCOLONROM,
 ICHARLIT, ' ', EXIT,
 
+/* BLOCKON */
+0x80|'N', 'O', '-', 'K', 'C', 'O', 'L', 'B',
+#undef ROMDEF_LAST
+#define ROMDEF_BLOCKON 0xC710
+#define ROMDEF_LAST 0xC710
+8, 0xC7,0x00, 0, BLOCKON,
+
 /* CSTORE */
 0x80|'!', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CSTORE 0xC72D
-#define ROMDEF_LAST 0xC72D
-2, 0xC7,0x23, 0, CSTORE,
+#define ROMDEF_CSTORE 0xC717
+#define ROMDEF_LAST 0xC717
+2, 0xC7,0x10, 0, CSTORE,
 
 /* CCOMMA */
 0x80|',', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CCOMMA 0xC734
-#define ROMDEF_LAST 0xC734
-2, 0xC7,0x2D, 0, DOCOLONROM,
-0xC9,0xDC, CSTORE, ICHARLIT, 1, 0xC7,0x88, 0xC6,0xFA, EXIT,
+#define ROMDEF_CCOMMA 0xC71E
+#define ROMDEF_LAST 0xC71E
+2, 0xC7,0x17, 0, DOCOLONROM,
+0xCA,0x21, CSTORE, ICHARLIT, 1, 0xC7,0x79, 0xC6,0xBF, EXIT,
 
 /* CFETCH */
 0x80|'@', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CFETCH 0xC745
-#define ROMDEF_LAST 0xC745
-2, 0xC7,0x34, 0, CFETCH,
+#define ROMDEF_CFETCH 0xC72F
+#define ROMDEF_LAST 0xC72F
+2, 0xC7,0x1E, 0, CFETCH,
+
+/* CAS */
+0x80|'S', 'A', 'C',
+#undef ROMDEF_LAST
+#define ROMDEF_CAS 0xC737
+#define ROMDEF_LAST 0xC737
+3, 0xC7,0x2F, 0, CAS,
 
 /* CELLPLUS */
 0x80|'+', 'L', 'L', 'E', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CELLPLUS 0xC74F
-#define ROMDEF_LAST 0xC74F
-5, 0xC7,0x45, 0, DOCOLONROM,
+#define ROMDEF_CELLPLUS 0xC741
+#define ROMDEF_LAST 0xC741
+5, 0xC7,0x37, 0, DOCOLONROM,
 ICHARLIT, kEnforthCellSize, PLUS, EXIT,
 
 /* CELLS */
 0x80|'S', 'L', 'L', 'E', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CELLS 0xC75D
-#define ROMDEF_LAST 0xC75D
-5, 0xC7,0x4F, 0, DOCOLONROM,
-ICHARLIT, kEnforthCellSize, 0xC4,0x59, EXIT,
+#define ROMDEF_CELLS 0xC74F
+#define ROMDEF_LAST 0xC74F
+5, 0xC7,0x41, 0, DOCOLONROM,
+ICHARLIT, kEnforthCellSize, 0xC4,0x14, EXIT,
 
 /* CHAR */
 0x80|'R', 'A', 'H', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CHAR 0xC76B
-#define ROMDEF_LAST 0xC76B
-4, 0xC7,0x5D, 0, DOCOLONROM,
-0xC7,0x23, 0xCB,0x34, DROP, CFETCH, EXIT,
+#define ROMDEF_CHAR 0xC75D
+#define ROMDEF_LAST 0xC75D
+4, 0xC7,0x4F, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, DROP, CFETCH, EXIT,
 
 /* CHARPLUS */
 0x80|'+', 'R', 'A', 'H', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CHARPLUS 0xC77C
-#define ROMDEF_LAST 0xC77C
-5, 0xC7,0x6B, 0, DOCOLONROM,
+#define ROMDEF_CHARPLUS 0xC76D
+#define ROMDEF_LAST 0xC76D
+5, 0xC7,0x5D, 0, DOCOLONROM,
 ONEPLUS, EXIT,
 
 /* CHARS */
 0x80|'S', 'R', 'A', 'H', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CHARS 0xC788
-#define ROMDEF_LAST 0xC788
-5, 0xC7,0x7C, 0, DOCOLONROM,
+#define ROMDEF_CHARS 0xC779
+#define ROMDEF_LAST 0xC779
+5, 0xC7,0x6D, 0, DOCOLONROM,
 EXIT,
 
 /* COMPILECOMMA */
 0x80|',', 'E', 'L', 'I', 'P', 'M', 'O', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_COMPILECOMMA 0xC796
-#define ROMDEF_LAST 0xC796
-8, 0xC7,0x88, 0, DOCOLONROM,
-DUP, 0xC3,0x8B, IZBRANCH, 4, 0xC7,0x34, EXIT, DUP, ONEPLUS, ONEPLUS, ONEPLUS, 0xC3,0xC5, DUP, ICHARLIT, 112, LESSTHAN, IZBRANCH, 6, 0xC7,0x34, DROP, IBRANCH, 4, DROP, 0xC3,0xB7, EXIT,
+#define ROMDEF_COMPILECOMMA 0xC787
+#define ROMDEF_LAST 0xC787
+8, 0xC7,0x79, 0, DOCOLONROM,
+DUP, 0xC3,0x4D, IZBRANCH, 13, DUP, ICHARLIT, 8, RSHIFT, IZBRANCH, 4, 0xC3,0x79, EXIT, 0xC7,0x1E, EXIT, DUP, ONEPLUS, ONEPLUS, ONEPLUS, 0xC3,0x87, DUP, ICHARLIT, 120, LESSTHAN, IZBRANCH, 6, 0xC7,0x1E, DROP, IBRANCH, 4, DROP, 0xC3,0x79, EXIT,
 
 /* CONSTANT */
 0x80|'T', 'N', 'A', 'T', 'S', 'N', 'O', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CONSTANT 0xC7C0
-#define ROMDEF_LAST 0xC7C0
-8, 0xC7,0x96, 0, DOCOLONROM,
-0xC7,0xF4, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xFA, ICHARLIT, DOCONSTANT, 0xC3,0xB7, 0xC4,0x9A, EXIT,
+#define ROMDEF_CONSTANT 0xC7BA
+#define ROMDEF_LAST 0xC7BA
+8, 0xC7,0x87, 0, DOCOLONROM,
+0xC7,0xEE, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xBF, ICHARLIT, DOCONSTANT, 0xC3,0x79, 0xC4,0x55, EXIT,
 
 /* COUNT */
 0x80|'T', 'N', 'U', 'O', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_COUNT 0xC7D8
-#define ROMDEF_LAST 0xC7D8
-5, 0xC7,0xC0, 0, DOCOLONROM,
+#define ROMDEF_COUNT 0xC7D2
+#define ROMDEF_LAST 0xC7D2
+5, 0xC7,0xBA, 0, DOCOLONROM,
 DUP, CFETCH, SWAP, ONEPLUS, SWAP, EXIT,
 
 /* CR */
 0x80|'R', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CR 0xC7E5
-#define ROMDEF_LAST 0xC7E5
-2, 0xC7,0xD8, 0, DOCOLONROM,
+#define ROMDEF_CR 0xC7DF
+#define ROMDEF_LAST 0xC7DF
+2, 0xC7,0xD2, 0, DOCOLONROM,
 ICHARLIT, 10, EMIT, EXIT,
 
 /* CREATE */
 0x80|'E', 'T', 'A', 'E', 'R', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CREATE 0xC7F4
-#define ROMDEF_LAST 0xC7F4
-6, 0xC7,0xE5, 0, DOCOLONROM,
-0xC7,0x23, 0xCB,0x34, DUP, ZEROEQUALS, IZBRANCH, 2, ABORT, TUCK, OVER, PLUS, ONEMINUS, DUP, CFETCH, ICHARLIT, 128, OR, 0xC7,0x34, TWODUP, NOTEQUALS, IZBRANCH, 8, ONEMINUS, DUP, CFETCH, 0xC7,0x34, IBRANCH, -10, TWODROP, 0xC9,0xDC, 0xC0,0x79, SWAP, 0xC7,0x34, 0xC2,0xF9, FETCH, 0xC3,0xB7, 0xC2,0xF9, STORE, ICHARLIT, DOCREATE, 0xC3,0xB7, 0xC6,0xE2, EXIT,
+#define ROMDEF_CREATE 0xC7EE
+#define ROMDEF_LAST 0xC7EE
+6, 0xC7,0xDF, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, DUP, ZEROEQUALS, IZBRANCH, 2, ABORT, TUCK, OVER, PLUS, ONEMINUS, DUP, CFETCH, ICHARLIT, 128, OR, 0xC7,0x1E, TWODUP, NOTEQUALS, IZBRANCH, 8, ONEMINUS, DUP, CFETCH, 0xC7,0x1E, IBRANCH, -10, TWODROP, 0xCA,0x21, 0xC0,0xA7, SWAP, 0xC7,0x1E, 0xC2,0xEB, FETCH, 0xC3,0x79, 0xC2,0xEB, STORE, ICHARLIT, DOCREATE, 0xC3,0x79, 0xC6,0xA7, EXIT,
 
 /* CNOTSIMILAR */
 0x80|'}', '{', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CNOTSIMILAR 0xC832
-#define ROMDEF_LAST 0xC832
-3, 0xC7,0xF4, 0, DOCOLONROM,
-0xC8,0x3D, INVERT, EXIT,
+#define ROMDEF_CNOTSIMILAR 0xC82B
+#define ROMDEF_LAST 0xC82B
+3, 0xC7,0xEE, 0, DOCOLONROM,
+0xC8,0x36, INVERT, EXIT,
 
 /* CSIMILAR */
 0x80|'~', 'C',
 #undef ROMDEF_LAST
-#define ROMDEF_CSIMILAR 0xC83D
-#define ROMDEF_LAST 0xC83D
-2, 0xC8,0x32, 0, DOCOLONROM,
-0xC6,0x35, SWAP, 0xC6,0x35, EQUALS, EXIT,
+#define ROMDEF_CSIMILAR 0xC836
+#define ROMDEF_LAST 0xC836
+2, 0xC8,0x2B, 0, DOCOLONROM,
+0xC5,0xDC, SWAP, 0xC5,0xDC, EQUALS, EXIT,
+
+/* DDOT */
+0x80|'.', 'D',
+#undef ROMDEF_LAST
+#define ROMDEF_DDOT 0xC844
+#define ROMDEF_LAST 0xC844
+2, 0xC8,0x36, 0, DOCOLONROM,
+ZERO, DDOTR, 0xCE,0x0C, EXIT,
+
+/* DDOTR */
+0x80|'R', '.', 'D',
+#undef ROMDEF_LAST
+#define ROMDEF_DDOTR 0xC851
+#define ROMDEF_LAST 0xC851
+3, 0xC8,0x44, 0, DDOTR,
 
 /* DABS */
 0x80|'S', 'B', 'A', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DABS 0xC84D
-#define ROMDEF_LAST 0xC84D
-4, 0xC8,0x3D, 0, DOCOLONROM,
-DUP, 0xC0,0x85, EXIT,
+#define ROMDEF_DABS 0xC85A
+#define ROMDEF_LAST 0xC85A
+4, 0xC8,0x51, 0, DOCOLONROM,
+DUP, 0xC0,0xB3, EXIT,
 
 /* DECIMAL */
 0x80|'L', 'A', 'M', 'I', 'C', 'E', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DECIMAL 0xC85D
-#define ROMDEF_LAST 0xC85D
-7, 0xC8,0x4D, 0, DOCOLONROM,
+#define ROMDEF_DECIMAL 0xC86A
+#define ROMDEF_LAST 0xC86A
+7, 0xC8,0x5A, 0, DOCOLONROM,
 ICHARLIT, 10, BASE, STORE, EXIT,
 
 /* DEPTH */
 0x80|'H', 'T', 'P', 'E', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DEPTH 0xC86C
-#define ROMDEF_LAST 0xC86C
-5, 0xC8,0x5D, 0, DEPTH,
+#define ROMDEF_DEPTH 0xC879
+#define ROMDEF_LAST 0xC879
+5, 0xC8,0x6A, 0, DEPTH,
+
+/* DEQUEUE */
+0x80|'E', 'U', 'E', 'U', 'Q', 'E', 'D',
+#undef ROMDEF_LAST
+#define ROMDEF_DEQUEUE 0xC885
+#define ROMDEF_LAST 0xC885
+7, 0xC8,0x79, 0, DOCOLONROM,
+DUP, QDEQUEUE, ZEROEQUALS, IZBRANCH, 5, DUP, PAWAIT, IBRANCH, -8, NIP, EXIT,
 
 /* DNEGATE */
 0x80|'E', 'T', 'A', 'G', 'E', 'N', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DNEGATE 0xC878
-#define ROMDEF_LAST 0xC878
-7, 0xC8,0x6C, 0, DOCOLONROM,
+#define ROMDEF_DNEGATE 0xC89C
+#define ROMDEF_LAST 0xC89C
+7, 0xC8,0x85, 0, DOCOLONROM,
 INVERT, SWAP, INVERT, SWAP, ICHARLIT, 1, MPLUS, EXIT,
 
 /* DO */
 0x80|'O', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DO 0xC887
-#define ROMDEF_LAST 0xC887
-0x80|2, 0xC8,0x78, 0, DOCOLONROM,
-ZERO, 0xC0,0x0B, STORE, ICHARLIT, PDO, 0xC7,0x96, 0xC9,0xDC, EXIT,
+#define ROMDEF_DO 0xC8AB
+#define ROMDEF_LAST 0xC8AB
+0x80|2, 0xC8,0x9C, 0, DOCOLONROM,
+ZERO, 0xC0,0x15, STORE, ICHARLIT, PDO, 0xC7,0x87, 0xCA,0x21, EXIT,
 
 /* DOES */
 0x80|'>', 'S', 'E', 'O', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DOES 0xC89C
-#define ROMDEF_LAST 0xC89C
-0x80|5, 0xC8,0x87, 0, DOCOLONROM,
-ICHARLIT, ((uint8_t)((ROMDEF_PDOES >> 8) & 0xff)), ICHARLIT, 8, LSHIFT, ICHARLIT, ((uint8_t)((ROMDEF_PDOES     ) & 0xff)), OR, 0xC3,0xB7, EXIT,
+#define ROMDEF_DOES 0xC8C0
+#define ROMDEF_LAST 0xC8C0
+0x80|5, 0xC8,0xAB, 0, DOCOLONROM,
+ICHARLIT, ((uint8_t)((ROMDEF_PDOES >> 8) & 0xff)), ICHARLIT, 8, LSHIFT, ICHARLIT, ((uint8_t)((ROMDEF_PDOES     ) & 0xff)), OR, 0xC3,0x79, EXIT,
 
 /* DROP */
 0x80|'P', 'O', 'R', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DROP 0xC8B0
-#define ROMDEF_LAST 0xC8B0
-4, 0xC8,0x9C, 0, DROP,
+#define ROMDEF_DROP 0xC8D4
+#define ROMDEF_LAST 0xC8D4
+4, 0xC8,0xC0, 0, DROP,
 
 /* DUMP */
 0x80|'P', 'M', 'U', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DUMP 0xC8B9
-#define ROMDEF_LAST 0xC8B9
-4, 0xC8,0xB0, 0, DOCOLONROM,
-BASE, FETCH, TOR, 0xC9,0xE8, QDUP, IZBRANCH, 98, TWODUP, ICHARLIT, 16, MIN, TUCK, 0xC7,0xE5, OVER, ZERO, 0xC5,0xB8, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC3,0xF6, 0xC4,0x10, 0xCD,0x54, ICHARLIT, 2, 0xCC,0xB3, DUP, ZERO, PDO, OVER, I, PLUS, CFETCH, ZERO, 0xC5,0xB8, 0xC3,0xF6, 0xC3,0xF6, 0xC4,0x10, 0xCD,0x54, 0xCC,0xA4, PILOOP, -18, ICHARLIT, 16, OVER, MINUS, ICHARLIT, 3, 0xC4,0x59, 0xCC,0xB3, 0xCC,0xA4, ZERO, PDO, DUP, I, PLUS, CFETCH, DUP, ICHARLIT, 32, LESSTHAN, OVER, ICHARLIT, 127, GREATERTHAN, OR, IZBRANCH, 4, DROP, ICHARLIT, '.', EMIT, PILOOP, -20, DROP, 0xC4,0xF1, IBRANCH, -99, DROP, RFROM, BASE, STORE, EXIT,
+#define ROMDEF_DUMP 0xC8DD
+#define ROMDEF_LAST 0xC8DD
+4, 0xC8,0xD4, 0, DOCOLONROM,
+BASE, FETCH, TOR, 0xCA,0x30, QDUP, IZBRANCH, 96, TWODUP, ICHARLIT, 16, MIN, TUCK, 0xC7,0xDF, OVER, ZERO, 0xC5,0x85, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xD2, TYPE, ICHARLIT, 2, 0xCE,0x1B, DUP, ZERO, PDO, OVER, I, PLUS, CFETCH, ZERO, 0xC5,0x85, 0xC3,0xB8, 0xC3,0xB8, 0xC3,0xD2, TYPE, 0xCE,0x0C, PILOOP, -17, ICHARLIT, 16, OVER, MINUS, ICHARLIT, 3, 0xC4,0x14, 0xCE,0x1B, 0xCE,0x0C, ZERO, PDO, DUP, I, PLUS, CFETCH, DUP, ICHARLIT, 32, LESSTHAN, OVER, ICHARLIT, 127, GREATERTHAN, OR, IZBRANCH, 4, DROP, ICHARLIT, '.', EMIT, PILOOP, -20, DROP, 0xC4,0xBE, IBRANCH, -97, DROP, RFROM, BASE, STORE, EXIT,
 
 /* DUP */
 0x80|'P', 'U', 'D',
 #undef ROMDEF_LAST
-#define ROMDEF_DUP 0xC92F
-#define ROMDEF_LAST 0xC92F
-3, 0xC8,0xB9, 0, DUP,
+#define ROMDEF_DUP 0xC951
+#define ROMDEF_LAST 0xC951
+3, 0xC8,0xDD, 0, DUP,
 
 /* ELSE */
 0x80|'E', 'S', 'L', 'E',
 #undef ROMDEF_LAST
-#define ROMDEF_ELSE 0xC938
-#define ROMDEF_LAST 0xC938
-0x80|4, 0xC9,0x2F, 0, DOCOLONROM,
-ICHARLIT, BRANCH, 0xC7,0x96, 0xC9,0xDC, ZERO, 0xC7,0x34, SWAP, 0xCD,0x32, EXIT,
+#define ROMDEF_ELSE 0xC95A
+#define ROMDEF_LAST 0xC95A
+0x80|4, 0xC9,0x51, 0, DOCOLONROM,
+ICHARLIT, BRANCH, 0xC7,0x87, 0xCA,0x21, ZERO, 0xC7,0x1E, SWAP, 0xCE,0x55, EXIT,
 
 /* EMIT */
 0x80|'T', 'I', 'M', 'E',
 #undef ROMDEF_LAST
-#define ROMDEF_EMIT 0xC94E
-#define ROMDEF_LAST 0xC94E
-4, 0xC9,0x38, 0, EMIT,
+#define ROMDEF_EMIT 0xC970
+#define ROMDEF_LAST 0xC970
+4, 0xC9,0x5A, 0, EMIT,
+
+/* EVALUATE */
+0x80|'E', 'T', 'A', 'U', 'L', 'A', 'V', 'E',
+#undef ROMDEF_LAST
+#define ROMDEF_EVALUATE 0xC97D
+#define ROMDEF_LAST 0xC97D
+8, 0xC9,0x70, 0, DOCOLONROM,
+TRUE, PUSHSOURCE, VM, ICHARLIT, offsetof(EnforthVM, source_len), PLUS, TWOSTORE, 0xC2,0x84, POPSOURCE, EXIT,
 
 /* EXECUTE */
 0x80|'E', 'T', 'U', 'C', 'E', 'X', 'E',
 #undef ROMDEF_LAST
-#define ROMDEF_EXECUTE 0xC95A
-#define ROMDEF_LAST 0xC95A
-7, 0xC9,0x4E, 0, EXECUTE,
+#define ROMDEF_EXECUTE 0xC994
+#define ROMDEF_LAST 0xC994
+7, 0xC9,0x7D, 0, EXECUTE,
 
 /* EXIT */
 0x80|'T', 'I', 'X', 'E',
 #undef ROMDEF_LAST
-#define ROMDEF_EXIT 0xC963
-#define ROMDEF_LAST 0xC963
-4, 0xC9,0x5A, 0, EXIT,
+#define ROMDEF_EXIT 0xC99D
+#define ROMDEF_LAST 0xC99D
+4, 0xC9,0x94, 0, EXIT,
 
 /* FALSE */
 0x80|'E', 'S', 'L', 'A', 'F',
 #undef ROMDEF_LAST
-#define ROMDEF_FALSE 0xC96D
-#define ROMDEF_LAST 0xC96D
-5, 0xC9,0x63, 0, FALSE,
+#define ROMDEF_FALSE 0xC9A7
+#define ROMDEF_LAST 0xC9A7
+5, 0xC9,0x9D, 0, FALSE,
 
 /* FFIS */
 0x80|'S', 'I', 'F', 'F',
 #undef ROMDEF_LAST
-#define ROMDEF_FFIS 0xC976
-#define ROMDEF_LAST 0xC976
-4, 0xC9,0x6D, 0, DOCOLONROM,
-VM, ICHARLIT, offsetof(EnforthVM, last_ffi), PLUS, FETCH, QDUP, IZBRANCH, 14, DUP, 0xC1,0x50, OVER, 0xC1,0x5A, 0xC2,0xD4, 0xCC,0xA4, IFETCH, IBRANCH, -15, EXIT,
+#define ROMDEF_FFIS 0xC9B0
+#define ROMDEF_LAST 0xC9B0
+4, 0xC9,0xA7, 0, DOCOLONROM,
+VM, ICHARLIT, offsetof(EnforthVM, last_ffi), PLUS, FETCH, QDUP, IZBRANCH, 14, DUP, 0xC1,0x49, OVER, 0xC1,0x53, 0xC2,0xC6, 0xCE,0x0C, IFETCH, IBRANCH, -15, EXIT,
 
 /* FIND */
 0x80|'D', 'N', 'I', 'F',
 #undef ROMDEF_LAST
-#define ROMDEF_FIND 0xC995
-#define ROMDEF_LAST 0xC995
-4, 0xC9,0x76, 0, DOCOLONROM,
-0xC7,0xD8, 0xC1,0x93, EXIT,
+#define ROMDEF_FIND 0xC9CF
+#define ROMDEF_LAST 0xC9CF
+4, 0xC9,0xB0, 0, DOCOLONROM,
+0xC7,0xD2, 0xC1,0x91, EXIT,
 
 /* FMSLASHMOD */
 0x80|'D', 'O', 'M', '/', 'M', 'F',
 #undef ROMDEF_LAST
-#define ROMDEF_FMSLASHMOD 0xC9A5
-#define ROMDEF_LAST 0xC9A5
-6, 0xC9,0x95, 0, DOCOLONROM,
-DUP, TOR, TWODUP, XOR, SWAP, ABS, DUP, TOR, SWAP, TOR, TOR, 0xC8,0x4D, RFROM, UMSLASHMOD, RFROM, ZEROLESS, IZBRANCH, 18, NEGATE, OVER, ZERONOTEQUALS, IZBRANCH, 9, ONEMINUS, SWAP, RFROM, SWAP, MINUS, SWAP, IBRANCH, 7, RFROM, DROP, IBRANCH, 3, RFROM, DROP, RFROM, ZEROLESS, IZBRANCH, 4, SWAP, NEGATE, SWAP, EXIT,
+#define ROMDEF_FMSLASHMOD 0xC9DF
+#define ROMDEF_LAST 0xC9DF
+6, 0xC9,0xCF, 0, DOCOLONROM,
+DUP, TOR, TWODUP, XOR, SWAP, ABS, DUP, TOR, SWAP, TOR, TOR, 0xC8,0x5A, RFROM, UMSLASHMOD, RFROM, ZEROLESS, IZBRANCH, 18, NEGATE, OVER, ZERONOTEQUALS, IZBRANCH, 9, ONEMINUS, SWAP, RFROM, SWAP, MINUS, SWAP, IBRANCH, 7, RFROM, DROP, IBRANCH, 3, RFROM, DROP, RFROM, ZEROLESS, IZBRANCH, 4, SWAP, NEGATE, SWAP, EXIT,
+
+/* HALT */
+0x80|'T', 'L', 'A', 'H',
+#undef ROMDEF_LAST
+#define ROMDEF_HALT 0xCA16
+#define ROMDEF_LAST 0xCA16
+4, 0xC9,0xDF, 0, DOCOLONROM,
+PHALT, EXIT,
 
 /* HERE */
 0x80|'E', 'R', 'E', 'H',
 #undef ROMDEF_LAST
-#define ROMDEF_HERE 0xC9DC
-#define ROMDEF_LAST 0xC9DC
-4, 0xC9,0xA5, 0, DOCOLONROM,
-0xC1,0x18, FETCH, EXIT,
+#define ROMDEF_HERE 0xCA21
+#define ROMDEF_LAST 0xCA21
+4, 0xCA,0x16, 0, DOCOLONROM,
+0xC1,0x20, FETCH, 0xC0,0x00, PLUS, EXIT,
 
 /* HEX */
 0x80|'X', 'E', 'H',
 #undef ROMDEF_LAST
-#define ROMDEF_HEX 0xC9E8
-#define ROMDEF_LAST 0xC9E8
-3, 0xC9,0xDC, 0, DOCOLONROM,
+#define ROMDEF_HEX 0xCA30
+#define ROMDEF_LAST 0xCA30
+3, 0xCA,0x21, 0, DOCOLONROM,
 ICHARLIT, 16, BASE, STORE, EXIT,
 
 /* HOLD */
 0x80|'D', 'L', 'O', 'H',
 #undef ROMDEF_LAST
-#define ROMDEF_HOLD 0xC9F6
-#define ROMDEF_LAST 0xC9F6
-4, 0xC9,0xE8, 0, DOCOLONROM,
-0xC2,0x65, FETCH, ONEMINUS, DUP, 0xC2,0x65, STORE, CSTORE, EXIT,
+#define ROMDEF_HOLD 0xCA3E
+#define ROMDEF_LAST 0xCA3E
+4, 0xCA,0x30, 0, DOCOLONROM,
+0xC2,0x5C, FETCH, ONEMINUS, DUP, 0xC2,0x5C, STORE, CSTORE, EXIT,
 
 /* I */
 0x80|'I',
 #undef ROMDEF_LAST
-#define ROMDEF_I 0xCA06
-#define ROMDEF_LAST 0xCA06
-1, 0xC9,0xF6, 0, I,
+#define ROMDEF_I 0xCA4E
+#define ROMDEF_LAST 0xCA4E
+1, 0xCA,0x3E, 0, I,
 
 /* IF */
 0x80|'F', 'I',
 #undef ROMDEF_LAST
-#define ROMDEF_IF 0xCA0D
-#define ROMDEF_LAST 0xCA0D
-0x80|2, 0xCA,0x06, 0, DOCOLONROM,
-ICHARLIT, ZBRANCH, 0xC7,0x96, 0xC9,0xDC, ZERO, 0xC7,0x34, EXIT,
+#define ROMDEF_IF 0xCA55
+#define ROMDEF_LAST 0xCA55
+0x80|2, 0xCA,0x4E, 0, DOCOLONROM,
+ICHARLIT, ZBRANCH, 0xC7,0x87, 0xCA,0x21, ZERO, 0xC7,0x1E, EXIT,
 
 /* IMMEDIATE */
 0x80|'E', 'T', 'A', 'I', 'D', 'E', 'M', 'M', 'I',
 #undef ROMDEF_LAST
-#define ROMDEF_IMMEDIATE 0xCA25
-#define ROMDEF_LAST 0xCA25
-9, 0xCA,0x0D, 0, DOCOLONROM,
-0xC2,0xF9, FETCH, 0xC0,0x6D, DUP, CFETCH, ICHARLIT, 128, OR, SWAP, CSTORE, EXIT,
+#define ROMDEF_IMMEDIATE 0xCA6D
+#define ROMDEF_LAST 0xCA6D
+9, 0xCA,0x55, 0, DOCOLONROM,
+0xC2,0xEB, FETCH, 0xC0,0x96, DUP, CFETCH, ICHARLIT, 128, OR, SWAP, CSTORE, EXIT,
+
+/* INCLUDE */
+0x80|'E', 'D', 'U', 'L', 'C', 'N', 'I',
+#undef ROMDEF_LAST
+#define ROMDEF_INCLUDE 0xCA86
+#define ROMDEF_LAST 0xCA86
+7, 0xCA,0x6D, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, 0xCA,0xB5, EXIT,
+
+/* INCLUDEFILE */
+0x80|'E', 'L', 'I', 'F', '-', 'E', 'D', 'U', 'L', 'C', 'N', 'I',
+#undef ROMDEF_LAST
+#define ROMDEF_INCLUDEFILE 0xCA9D
+#define ROMDEF_LAST 0xCA9D
+12, 0xCA,0x86, 0, DOCOLONROM,
+PUSHSOURCE, 0xCC,0xAB, IZBRANCH, 5, 0xC2,0x84, IBRANCH, -7, POPSOURCE, EXIT,
+
+/* INCLUDED */
+0x80|'D', 'E', 'D', 'U', 'L', 'C', 'N', 'I',
+#undef ROMDEF_LAST
+#define ROMDEF_INCLUDED 0xCAB5
+#define ROMDEF_LAST 0xCAB5
+8, 0xCA,0x9D, 0, DOCOLONROM,
+OPENSOURCE, IZBRANCH, 4, 0xCA,0x9D, EXIT, TYPE, 0xCE,0x0C, ICHARLIT, '?', EMIT, 0xC7,0xDF, ABORT, EXIT,
 
 /* INVERT */
 0x80|'T', 'R', 'E', 'V', 'N', 'I',
 #undef ROMDEF_LAST
-#define ROMDEF_INVERT 0xCA3D
-#define ROMDEF_LAST 0xCA3D
-6, 0xCA,0x25, 0, INVERT,
+#define ROMDEF_INVERT 0xCAD0
+#define ROMDEF_LAST 0xCAD0
+6, 0xCA,0xB5, 0, INVERT,
 
 /* J */
 0x80|'J',
 #undef ROMDEF_LAST
-#define ROMDEF_J 0xCA43
-#define ROMDEF_LAST 0xCA43
-1, 0xCA,0x3D, 0, J,
+#define ROMDEF_J 0xCAD6
+#define ROMDEF_LAST 0xCAD6
+1, 0xCA,0xD0, 0, J,
 
 /* KEY */
 0x80|'Y', 'E', 'K',
 #undef ROMDEF_LAST
-#define ROMDEF_KEY 0xCA4B
-#define ROMDEF_LAST 0xCA4B
-3, 0xCA,0x43, 0, DOCOLONROM,
-PAUSE, KEYQ, IZBRANCH, -3, PKEY, EXIT,
+#define ROMDEF_KEY 0xCADE
+#define ROMDEF_LAST 0xCADE
+3, 0xCA,0xD6, 0, DOCOLONROM,
+KEYQ, ZEROEQUALS, IZBRANCH, 7, 0xC0,0x0B, FETCH, BLOCKON, IBRANCH, -9, PKEY, EXIT,
 
 /* KEYQ */
 0x80|'?', 'Y', 'E', 'K',
 #undef ROMDEF_LAST
-#define ROMDEF_KEYQ 0xCA5A
-#define ROMDEF_LAST 0xCA5A
-4, 0xCA,0x4B, 0, KEYQ,
+#define ROMDEF_KEYQ 0xCAF3
+#define ROMDEF_LAST 0xCAF3
+4, 0xCA,0xDE, 0, KEYQ,
 
 /* LEAVE */
 0x80|'E', 'V', 'A', 'E', 'L',
 #undef ROMDEF_LAST
-#define ROMDEF_LEAVE 0xCA64
-#define ROMDEF_LAST 0xCA64
-0x80|5, 0xCA,0x5A, 0, DOCOLONROM,
-ICHARLIT, UNLOOP, 0xC7,0x96, ICHARLIT, BRANCH, 0xC7,0x96, 0xC9,0xDC, 0xC0,0x0B, FETCH, DUP, IZBRANCH, 5, 0xC9,0xDC, SWAP, MINUS, 0xC7,0x34, 0xC0,0x0B, STORE, EXIT,
+#define ROMDEF_LEAVE 0xCAFD
+#define ROMDEF_LAST 0xCAFD
+0x80|5, 0xCA,0xF3, 0, DOCOLONROM,
+ICHARLIT, UNLOOP, 0xC7,0x87, ICHARLIT, BRANCH, 0xC7,0x87, 0xCA,0x21, 0xC0,0x15, FETCH, DUP, IZBRANCH, 5, 0xCA,0x21, SWAP, MINUS, 0xC7,0x1E, 0xC0,0x15, STORE, EXIT,
 
 /* LITERAL */
 0x80|'L', 'A', 'R', 'E', 'T', 'I', 'L',
 #undef ROMDEF_LAST
-#define ROMDEF_LITERAL 0xCA8A
-#define ROMDEF_LAST 0xCA8A
-0x80|7, 0xCA,0x64, 0, DOCOLONROM,
-DUP, ICHARLIT, 255, INVERT, AND, ZEROEQUALS, IZBRANCH, 9, ICHARLIT, CHARLIT, 0xC7,0x34, 0xC7,0x34, IBRANCH, 7, ICHARLIT, LIT, 0xC7,0x34, 0xC4,0x9A, EXIT,
+#define ROMDEF_LITERAL 0xCB23
+#define ROMDEF_LAST 0xCB23
+0x80|7, 0xCA,0xFD, 0, DOCOLONROM,
+DUP, ICHARLIT, 255, INVERT, AND, ZEROEQUALS, IZBRANCH, 9, ICHARLIT, CHARLIT, 0xC7,0x1E, 0xC7,0x1E, IBRANCH, 7, ICHARLIT, LIT, 0xC7,0x1E, 0xC4,0x55, EXIT,
 
 /* LOAD */
 0x80|'D', 'A', 'O', 'L',
 #undef ROMDEF_LAST
-#define ROMDEF_LOAD 0xCAAA
-#define ROMDEF_LAST 0xCAAA
-4, 0xCA,0x8A, 0, LOAD,
+#define ROMDEF_LOAD 0xCB43
+#define ROMDEF_LAST 0xCB43
+4, 0xCB,0x23, 0, LOAD,
 
 /* LOOP */
 0x80|'P', 'O', 'O', 'L',
 #undef ROMDEF_LAST
-#define ROMDEF_LOOP 0xCAB3
-#define ROMDEF_LAST 0xCAB3
-0x80|4, 0xCA,0xAA, 0, DOCOLONROM,
-ICHARLIT, PLOOP, 0xC1,0x20, EXIT,
+#define ROMDEF_LOOP 0xCB4C
+#define ROMDEF_LAST 0xCB4C
+0x80|4, 0xCB,0x43, 0, DOCOLONROM,
+ICHARLIT, PLOOP, 0xC1,0x2B, EXIT,
 
 /* LSHIFT */
 0x80|'T', 'F', 'I', 'H', 'S', 'L',
 #undef ROMDEF_LAST
-#define ROMDEF_LSHIFT 0xCAC3
-#define ROMDEF_LAST 0xCAC3
-6, 0xCA,0xB3, 0, LSHIFT,
+#define ROMDEF_LSHIFT 0xCB5C
+#define ROMDEF_LAST 0xCB5C
+6, 0xCB,0x4C, 0, LSHIFT,
 
 /* MSTAR */
 0x80|'*', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MSTAR 0xCACA
-#define ROMDEF_LAST 0xCACA
-2, 0xCA,0xC3, 0, DOCOLONROM,
-TWODUP, XOR, ZEROLESS, TOR, ABS, SWAP, ABS, UMSTAR, RFROM, 0xC0,0x85, EXIT,
+#define ROMDEF_MSTAR 0xCB63
+#define ROMDEF_LAST 0xCB63
+2, 0xCB,0x5C, 0, DOCOLONROM,
+TWODUP, XOR, ZEROLESS, TOR, ABS, SWAP, ABS, UMSTAR, RFROM, 0xC0,0xB3, EXIT,
 
 /* MPLUS */
 0x80|'+', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MPLUS 0xCADD
-#define ROMDEF_LAST 0xCADD
-2, 0xCA,0xCA, 0, MPLUS,
+#define ROMDEF_MPLUS 0xCB76
+#define ROMDEF_LAST 0xCB76
+2, 0xCB,0x63, 0, MPLUS,
+
+/* MAILBOX */
+0x80|'X', 'O', 'B', 'L', 'I', 'A', 'M',
+#undef ROMDEF_LAST
+#define ROMDEF_MAILBOX 0xCB82
+#define ROMDEF_LAST 0xCB82
+7, 0xCB,0x76, 0, DOCOLONROM,
+DUP, ZEROEQUALS, IZBRANCH, 2, ABORT, 0xC7,0xEE, DUP, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, 0xC7,0x4F, 0xC6,0xBF, EXIT,
 
 /* MAX */
 0x80|'X', 'A', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MAX 0xCAE5
-#define ROMDEF_LAST 0xCAE5
-3, 0xCA,0xDD, 0, MAX,
+#define ROMDEF_MAX 0xCBA2
+#define ROMDEF_LAST 0xCBA2
+3, 0xCB,0x82, 0, MAX,
 
 /* MIN */
 0x80|'N', 'I', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MIN 0xCAED
-#define ROMDEF_LAST 0xCAED
-3, 0xCA,0xE5, 0, MIN,
+#define ROMDEF_MIN 0xCBAA
+#define ROMDEF_LAST 0xCBAA
+3, 0xCB,0xA2, 0, MIN,
 
 /* MOD */
 0x80|'D', 'O', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MOD 0xCAF5
-#define ROMDEF_LAST 0xCAF5
-3, 0xCA,0xED, 0, DOCOLONROM,
-0xC4,0xDE, DROP, EXIT,
+#define ROMDEF_MOD 0xCBB2
+#define ROMDEF_LAST 0xCBB2
+3, 0xCB,0xAA, 0, DOCOLONROM,
+0xC4,0xAB, DROP, EXIT,
 
 /* MOVE */
 0x80|'E', 'V', 'O', 'M',
 #undef ROMDEF_LAST
-#define ROMDEF_MOVE 0xCB02
-#define ROMDEF_LAST 0xCB02
-4, 0xCA,0xF5, 0, MOVE,
+#define ROMDEF_MOVE 0xCBBF
+#define ROMDEF_LAST 0xCBBF
+4, 0xCB,0xB2, 0, MOVE,
+
+/* MS */
+0x80|'S', 'M',
+#undef ROMDEF_LAST
+#define ROMDEF_MS 0xCBC6
+#define ROMDEF_LAST 0xCBC6
+2, 0xCB,0xBF, 0, MS,
 
 /* NEGATE */
 0x80|'E', 'T', 'A', 'G', 'E', 'N',
 #undef ROMDEF_LAST
-#define ROMDEF_NEGATE 0xCB0D
-#define ROMDEF_LAST 0xCB0D
-6, 0xCB,0x02, 0, NEGATE,
+#define ROMDEF_NEGATE 0xCBD1
+#define ROMDEF_LAST 0xCBD1
+6, 0xCB,0xC6, 0, NEGATE,
 
 /* NIP */
 0x80|'P', 'I', 'N',
 #undef ROMDEF_LAST
-#define ROMDEF_NIP 0xCB15
-#define ROMDEF_LAST 0xCB15
-3, 0xCB,0x0D, 0, NIP,
+#define ROMDEF_NIP 0xCBD9
+#define ROMDEF_LAST 0xCBD9
+3, 0xCB,0xD1, 0, NIP,
 
 /* OR */
 0x80|'R', 'O',
 #undef ROMDEF_LAST
-#define ROMDEF_OR 0xCB1C
-#define ROMDEF_LAST 0xCB1C
-2, 0xCB,0x15, 0, OR,
+#define ROMDEF_OR 0xCBE0
+#define ROMDEF_LAST 0xCBE0
+2, 0xCB,0xD9, 0, OR,
 
 /* OVER */
 0x80|'R', 'E', 'V', 'O',
 #undef ROMDEF_LAST
-#define ROMDEF_OVER 0xCB25
-#define ROMDEF_LAST 0xCB25
-4, 0xCB,0x1C, 0, OVER,
+#define ROMDEF_OVER 0xCBE9
+#define ROMDEF_LAST 0xCBE9
+4, 0xCB,0xE0, 0, OVER,
+
+/* PARSE */
+0x80|'E', 'S', 'R', 'A', 'P',
+#undef ROMDEF_LAST
+#define ROMDEF_PARSE 0xCBF3
+#define ROMDEF_LAST 0xCBF3
+5, 0xCB,0xE9, 0, PARSE,
 
 /* PARSEWORD */
 0x80|'D', 'R', 'O', 'W', '-', 'E', 'S', 'R', 'A', 'P',
 #undef ROMDEF_LAST
-#define ROMDEF_PARSEWORD 0xCB34
-#define ROMDEF_LAST 0xCB34
-10, 0xCB,0x25, 0, DOCOLONROM,
-TOR, 0xCC,0x94, 0xC5,0xF0, FETCH, 0xC4,0xF1, RFETCH, TOR, OVER, CFETCH, RFETCH, EQUALS, OVER, AND, IZBRANCH, 7, ICHARLIT, 1, 0xC4,0xF1, IBRANCH, -13, RFROM, DROP, OVER, SWAP, RFROM, TOR, DUP, ZEROEQUALS, IZBRANCH, 6, RFROM, TWODROP, FALSE, IBRANCH, 18, OVER, CFETCH, RFETCH, EQUALS, IZBRANCH, 6, RFROM, TWODROP, TRUE, IBRANCH, 7, ICHARLIT, 1, 0xC4,0xF1, IBRANCH, -25, OVER, 0xCC,0x94, DROP, MINUS, SWAP, IZBRANCH, 2, ONEPLUS, 0xC5,0xF0, STORE, OVER, MINUS, EXIT,
+#define ROMDEF_PARSEWORD 0xCC02
+#define ROMDEF_LAST 0xCC02
+10, 0xCB,0xF3, 0, PARSEWORD,
 
 /* PAUSE */
 0x80|'E', 'S', 'U', 'A', 'P',
 #undef ROMDEF_LAST
-#define ROMDEF_PAUSE 0xCB85
-#define ROMDEF_LAST 0xCB85
-5, 0xCB,0x34, 0, PAUSE,
+#define ROMDEF_PAUSE 0xCC0C
+#define ROMDEF_LAST 0xCC0C
+5, 0xCC,0x02, 0, PAUSE,
 
 /* POSTPONE */
 0x80|'E', 'N', 'O', 'P', 'T', 'S', 'O', 'P',
 #undef ROMDEF_LAST
-#define ROMDEF_POSTPONE 0xCB92
-#define ROMDEF_LAST 0xCB92
-0x80|8, 0xCB,0x85, 0, DOCOLONROM,
-0xC7,0x23, 0xCB,0x34, 0xC1,0x93, QDUP, ZEROEQUALS, IZBRANCH, 11, 0xCD,0x54, 0xCC,0xA4, ICHARLIT, '?', EMIT, 0xC7,0xE5, ABORT, ZEROLESS, IZBRANCH, 19, ICHARLIT, LIT, 0xC7,0x96, 0xC4,0x9A, ICHARLIT, ((uint8_t)((ROMDEF_COMPILECOMMA >> 8) & 0xff)), ICHARLIT, 8, LSHIFT, ICHARLIT, ((uint8_t)((ROMDEF_COMPILECOMMA     ) & 0xff)), OR, 0xC3,0xB7, IBRANCH, 3, 0xC7,0x96, EXIT,
+#define ROMDEF_POSTPONE 0xCC19
+#define ROMDEF_LAST 0xCC19
+0x80|8, 0xCC,0x0C, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, 0xC1,0x91, QDUP, ZEROEQUALS, IZBRANCH, 10, TYPE, 0xCE,0x0C, ICHARLIT, '?', EMIT, 0xC7,0xDF, ABORT, ZEROLESS, IZBRANCH, 19, ICHARLIT, LIT, 0xC7,0x87, 0xC4,0x55, ICHARLIT, ((uint8_t)((ROMDEF_COMPILECOMMA >> 8) & 0xff)), ICHARLIT, 8, LSHIFT, ICHARLIT, ((uint8_t)((ROMDEF_COMPILECOMMA     ) & 0xff)), OR, 0xC3,0x79, IBRANCH, 3, 0xC7,0x87, EXIT,
 
 /* QUIT */
 0x80|'T', 'I', 'U', 'Q',
 #undef ROMDEF_LAST
-#define ROMDEF_QUIT 0xCBC7
-#define ROMDEF_LAST 0xCBC7
-4, 0xCB,0x92, 0, DOCOLONROM,
-INITRP, ZERO, 0xCC,0xC6, STORE, 0xC3,0x79, DUP, 0xC3,0x83, 0xC6,0x89, 0xCC,0xA4, 0xC2,0x90, 0xC7,0xE5, 0xCC,0xC6, FETCH, ZEROEQUALS, IZBRANCH, 8, PISQUOTE, 3, 'o', 'k', ' ', 0xC2,0xD4, IBRANCH, -27,
+#define ROMDEF_QUIT 0xCC4C
+#define ROMDEF_LAST 0xCC4C
+4, 0xCC,0x19, 0, DOCOLONROM,
+INITRP, ZERO, 0xCE,0x2E, STORE, 0xCC,0xAB, DROP, 0xCE,0x0C, 0xC2,0x84, 0xC7,0xDF, 0xCE,0x2E, FETCH, ZEROEQUALS, IZBRANCH, 8, PISQUOTE, 3, 'o', 'k', ' ', 0xC2,0xC6, IBRANCH, -23,
 
 /* RFROM */
 0x80|'>', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_RFROM 0xCBEF
-#define ROMDEF_LAST 0xCBEF
-2, 0xCB,0xC7, 0, RFROM,
+#define ROMDEF_RFROM 0xCC70
+#define ROMDEF_LAST 0xCC70
+2, 0xCC,0x4C, 0, RFROM,
 
 /* RFETCH */
 0x80|'@', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_RFETCH 0xCBF6
-#define ROMDEF_LAST 0xCBF6
-2, 0xCB,0xEF, 0, RFETCH,
+#define ROMDEF_RFETCH 0xCC77
+#define ROMDEF_LAST 0xCC77
+2, 0xCC,0x70, 0, RFETCH,
+
+/* RECEIVE */
+0x80|'E', 'V', 'I', 'E', 'C', 'E', 'R',
+#undef ROMDEF_LAST
+#define ROMDEF_RECEIVE 0xCC83
+#define ROMDEF_LAST 0xCC83
+7, 0xCC,0x77, 0, DOCOLONROM,
+DUP, QRECEIVE, ZEROEQUALS, IZBRANCH, 5, DUP, PPARK, IBRANCH, -8, NIP, EXIT,
 
 /* RECURSE */
 0x80|'E', 'S', 'R', 'U', 'C', 'E', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_RECURSE 0xCC02
-#define ROMDEF_LAST 0xCC02
-0x80|7, 0xCB,0xF6, 0, DOCOLONROM,
-0xC2,0xF9, FETCH, 0xC3,0xB7, EXIT,
+#define ROMDEF_RECURSE 0xCC9A
+#define ROMDEF_LAST 0xCC9A
+0x80|7, 0xCC,0x83, 0, DOCOLONROM,
+0xC2,0xEB, FETCH, 0xC3,0x79, EXIT,
+
+/* REFILL */
+0x80|'L', 'L', 'I', 'F', 'E', 'R',
+#undef ROMDEF_LAST
+#define ROMDEF_REFILL 0xCCAB
+#define ROMDEF_LAST 0xCCAB
+6, 0xCC,0x9A, 0, DOCOLONROM,
+0xCD,0xFC, ZEROEQUALS, IZBRANCH, 19, 0xC3,0x3B, DUP, 0xC3,0x45, 0xC6,0x4A, VM, ICHARLIT, offsetof(EnforthVM, source_len), PLUS, TWOSTORE, ZERO, 0xC5,0xB9, STORE, TRUE, EXIT, PREFILL, EXIT,
 
 /* REPEAT */
 0x80|'T', 'A', 'E', 'P', 'E', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_REPEAT 0xCC13
-#define ROMDEF_LAST 0xCC13
-0x80|6, 0xCC,0x02, 0, DOCOLONROM,
-0xC6,0xCE, 0xCD,0x32, EXIT,
+#define ROMDEF_REPEAT 0xCCCF
+#define ROMDEF_LAST 0xCCCF
+0x80|6, 0xCC,0xAB, 0, DOCOLONROM,
+0xC6,0x93, 0xCE,0x55, EXIT,
 
 /* ROT */
 0x80|'T', 'O', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_ROT 0xCC20
-#define ROMDEF_LAST 0xCC20
-3, 0xCC,0x13, 0, ROT,
+#define ROMDEF_ROT 0xCCDC
+#define ROMDEF_LAST 0xCCDC
+3, 0xCC,0xCF, 0, ROT,
 
 /* RSHIFT */
 0x80|'T', 'F', 'I', 'H', 'S', 'R',
 #undef ROMDEF_LAST
-#define ROMDEF_RSHIFT 0xCC2B
-#define ROMDEF_LAST 0xCC2B
-6, 0xCC,0x20, 0, RSHIFT,
+#define ROMDEF_RSHIFT 0xCCE7
+#define ROMDEF_LAST 0xCCE7
+6, 0xCC,0xDC, 0, RSHIFT,
 
 /* SQUOTE */
 0x80|'"', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SQUOTE 0xCC32
-#define ROMDEF_LAST 0xCC32
-0x80|2, 0xCC,0x2B, 0, DOCOLONROM,
-ICHARLIT, '"', 0xCB,0x34, ICHARLIT, PSQUOTE, 0xC7,0x96, DUP, 0xC7,0x34, 0xC9,0xDC, OVER, 0xC6,0xFA, SWAP, MOVE, EXIT,
+#define ROMDEF_SQUOTE 0xCCEE
+#define ROMDEF_LAST 0xCCEE
+0x80|2, 0xCC,0xE7, 0, DOCOLONROM,
+ICHARLIT, '"', PARSE, ICHARLIT, PSQUOTE, 0xC7,0x87, DUP, 0xC7,0x1E, 0xCA,0x21, OVER, 0xC6,0xBF, SWAP, MOVE, EXIT,
 
 /* STOD */
 0x80|'D', '>', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_STOD 0xCC4D
-#define ROMDEF_LAST 0xCC4D
-3, 0xCC,0x32, 0, DOCOLONROM,
+#define ROMDEF_STOD 0xCD08
+#define ROMDEF_LAST 0xCD08
+3, 0xCC,0xEE, 0, DOCOLONROM,
 DUP, ZEROLESS, EXIT,
 
 /* SAVE */
 0x80|'E', 'V', 'A', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SAVE 0xCC59
-#define ROMDEF_LAST 0xCC59
-4, 0xCC,0x4D, 0, SAVE,
+#define ROMDEF_SAVE 0xCD14
+#define ROMDEF_LAST 0xCD14
+4, 0xCD,0x08, 0, SAVE,
+
+/* SEND */
+0x80|'D', 'N', 'E', 'S',
+#undef ROMDEF_LAST
+#define ROMDEF_SEND 0xCD1D
+#define ROMDEF_LAST 0xCD1D
+4, 0xCD,0x14, 0, DOCOLONROM,
+TWODUP, TRYSEND, ZEROEQUALS, IZBRANCH, 5, DUP, PPARK, IBRANCH, -8, TWODROP, EXIT,
 
 /* SIGN */
 0x80|'N', 'G', 'I', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SIGN 0xCC62
-#define ROMDEF_LAST 0xCC62
-4, 0xCC,0x59, 0, DOCOLONROM,
-ZEROLESS, IZBRANCH, 5, ICHARLIT, '-', 0xC9,0xF6, EXIT,
+#define ROMDEF_SIGN 0xCD31
+#define ROMDEF_LAST 0xCD31
+4, 0xCD,0x1D, 0, DOCOLONROM,
+ZEROLESS, IZBRANCH, 5, ICHARLIT, '-', 0xCA,0x3E, EXIT,
+
+/* SIZEDTASK */
+0x80|'K', 'S', 'A', 'T', '-', 'D', 'E', 'Z', 'I', 'S',
+#undef ROMDEF_LAST
+#define ROMDEF_SIZEDTASK 0xCD48
+#define ROMDEF_LAST 0xCD48
+10, 0xCD,0x31, 0, DOCOLONROM,
+OVER, ICHARLIT, 4, MINUS, ICHARLIT, 251, UGREATERTHAN, OVER, ICHARLIT, 255, UGREATERTHAN, OR, IZBRANCH, 2, ABORT, 0xCA,0x21, 0xC0,0x00, MINUS, 0xC2,0xDF, FETCH, 0xC4,0x55, TOR, TWODUP, PLUS, ICHARLIT, 4, PLUS, 0xC7,0x4F, RFETCH, PLUS, 0xC4,0x55, ICHARLIT, 10, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, TWODUP, ICHARLIT, 8, LSHIFT, OR, 0xC4,0x55, DUP, 0xC7,0x4F, 0xC6,0xBF, RFETCH, SWAP, ICHARLIT, 7, PLUS, 0xC7,0x4F, PLUS, TOR, ICHARLIT, 4, MINUS, 0xC7,0x4F, 0xC6,0xBF, 0xC5,0xA7, 0xC0,0x00, MINUS, 0xC4,0x55, RFROM, 0xC4,0x55, ZERO, 0xC4,0x55, ZERO, 0xC4,0x55, RFROM, 0xC2,0xDF, ATOMICSTORE, EXIT,
+
+/* SLEEPUNTIL */
+0x80|'L', 'I', 'T', 'N', 'U', '-', 'P', 'E', 'E', 'L', 'S',
+#undef ROMDEF_LAST
+#define ROMDEF_SLEEPUNTIL 0xCDBE
+#define ROMDEF_LAST 0xCDBE
+11, 0xCD,0x48, 0, SLEEPUNTIL,
 
 /* SMSLASHREM */
 0x80|'M', 'E', 'R', '/', 'M', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SMSLASHREM 0xCC75
-#define ROMDEF_LAST 0xCC75
-6, 0xCC,0x62, 0, DOCOLONROM,
-OVER, TOR, TWODUP, XOR, TOR, ABS, TOR, 0xC8,0x4D, RFROM, UMSLASHMOD, RFROM, 0xC0,0x90, SWAP, RFROM, 0xC0,0x90, SWAP, EXIT,
+#define ROMDEF_SMSLASHREM 0xCDC9
+#define ROMDEF_LAST 0xCDC9
+6, 0xCD,0xBE, 0, DOCOLONROM,
+OVER, TOR, TWODUP, XOR, TOR, ABS, TOR, 0xC8,0x5A, RFROM, UMSLASHMOD, RFROM, 0xC0,0xBE, SWAP, RFROM, 0xC0,0xBE, SWAP, EXIT,
 
 /* SOURCE */
 0x80|'E', 'C', 'R', 'U', 'O', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SOURCE 0xCC94
-#define ROMDEF_LAST 0xCC94
-6, 0xCC,0x75, 0, DOCOLONROM,
+#define ROMDEF_SOURCE 0xCDE8
+#define ROMDEF_LAST 0xCDE8
+6, 0xCD,0xC9, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, source_len), PLUS, TWOFETCH, EXIT,
 
+/* SOURCEID */
+0x80|'D', 'I', '-', 'E', 'C', 'R', 'U', 'O', 'S',
+#undef ROMDEF_LAST
+#define ROMDEF_SOURCEID 0xCDFC
+#define ROMDEF_LAST 0xCDFC
+9, 0xCD,0xE8, 0, DOCOLONROM,
+VM, ICHARLIT, offsetof(EnforthVM, source_id), PLUS, FETCH, EXIT,
+
 /* SPACE */
 0x80|'E', 'C', 'A', 'P', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SPACE 0xCCA4
-#define ROMDEF_LAST 0xCCA4
-5, 0xCC,0x94, 0, DOCOLONROM,
-0xC7,0x23, EMIT, EXIT,
+#define ROMDEF_SPACE 0xCE0C
+#define ROMDEF_LAST 0xCE0C
+5, 0xCD,0xFC, 0, DOCOLONROM,
+0xC7,0x00, EMIT, EXIT,
 
 /* SPACES */
 0x80|'S', 'E', 'C', 'A', 'P', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SPACES 0xCCB3
-#define ROMDEF_LAST 0xCCB3
-6, 0xCC,0xA4, 0, DOCOLONROM,
-QDUP, IZBRANCH, 6, 0xCC,0xA4, ONEMINUS, IBRANCH, -7, EXIT,
+#define ROMDEF_SPACES 0xCE1B
+#define ROMDEF_LAST 0xCE1B
+6, 0xCE,0x0C, 0, DOCOLONROM,
+QDUP, IZBRANCH, 6, 0xCE,0x0C, ONEMINUS, IBRANCH, -7, EXIT,
 
 /* STATE */
 0x80|'E', 'T', 'A', 'T', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_STATE 0xCCC6
-#define ROMDEF_LAST 0xCCC6
-5, 0xCC,0xB3, 0, DOCOLONROM,
+#define ROMDEF_STATE 0xCE2E
+#define ROMDEF_LAST 0xCE2E
+5, 0xCE,0x1B, 0, DOCOLONROM,
 VM, ICHARLIT, offsetof(EnforthVM, state), PLUS, EXIT,
 
 /* SWAP */
 0x80|'P', 'A', 'W', 'S',
 #undef ROMDEF_LAST
-#define ROMDEF_SWAP 0xCCD4
-#define ROMDEF_LAST 0xCCD4
-4, 0xCC,0xC6, 0, SWAP,
+#define ROMDEF_SWAP 0xCE3C
+#define ROMDEF_LAST 0xCE3C
+4, 0xCE,0x2E, 0, SWAP,
 
 /* TASK */
 0x80|'K', 'S', 'A', 'T',
 #undef ROMDEF_LAST
-#define ROMDEF_TASK 0xCCDD
-#define ROMDEF_LAST 0xCCDD
-4, 0xCC,0xD4, 0, DOCOLONROM,
-0xC9,0xDC, 0xC2,0xED, FETCH, 0xC4,0x9A, DUP, 0xC2,0xED, STORE, ICHARLIT, 8, 0xC7,0x5D, PLUS, ICHARLIT, 32, 0xC7,0x5D, PLUS, ICHARLIT, 20, 0xC7,0x5D, PLUS, 0xC4,0x9A, ICHARLIT, 10, 0xC4,0x9A, ICHARLIT, 5, 0xC7,0x5D, 0xC6,0xFA, ICHARLIT, 32, 0xC7,0x5D, 0xC6,0xFA, ICHARLIT, 20, 0xC7,0x5D, 0xC6,0xFA, 0xC5,0xDE, 0xC4,0x9A, 0xC2,0xED, FETCH, ICHARLIT, 8, 0xC7,0x5D, PLUS, ICHARLIT, 31, 0xC7,0x5D, PLUS, 0xC4,0x9A, ZERO, 0xC4,0x9A, ZERO, 0xC4,0x9A, EXIT,
+#define ROMDEF_TASK 0xCE45
+#define ROMDEF_LAST 0xCE45
+4, 0xCE,0x3C, 0, DOCOLONROM,
+ICHARLIT, kTaskDataStackSize, ICHARLIT, kTaskReturnStackSize, 0xCD,0x48, EXIT,
 
 /* THEN */
 0x80|'N', 'E', 'H', 'T',
 #undef ROMDEF_LAST
-#define ROMDEF_THEN 0xCD32
-#define ROMDEF_LAST 0xCD32
-0x80|4, 0xCC,0xDD, 0, DOCOLONROM,
-0xC9,0xDC, OVER, MINUS, SWAP, CSTORE, EXIT,
+#define ROMDEF_THEN 0xCE55
+#define ROMDEF_LAST 0xCE55
+0x80|4, 0xCE,0x45, 0, DOCOLONROM,
+0xCA,0x21, OVER, MINUS, SWAP, CSTORE, EXIT,
+
+/* TICKS */
+0x80|'S', 'K', 'C', 'I', 'T',
+#undef ROMDEF_LAST
+#define ROMDEF_TICKS 0xCE66
+#define ROMDEF_LAST 0xCE66
+5, 0xCE,0x55, 0, TICKS,
+
+/* TIMESLICE */
+0x80|'E', 'C', 'I', 'L', 'S', '-', 'E', 'M', 'I', 'T',
+#undef ROMDEF_LAST
+#define ROMDEF_TIMESLICE 0xCE75
+#define ROMDEF_LAST 0xCE75
+10, 0xCE,0x66, 0, DOCOLONROM,
+VM, ICHARLIT, offsetof(EnforthVM, time_slice), PLUS, EXIT,
 
 /* TRUE */
 0x80|'E', 'U', 'R', 'T',
 #undef ROMDEF_LAST
-#define ROMDEF_TRUE 0xCD42
-#define ROMDEF_LAST 0xCD42
-4, 0xCD,0x32, 0, TRUE,
+#define ROMDEF_TRUE 0xCE83
+#define ROMDEF_LAST 0xCE83
+4, 0xCE,0x75, 0, TRUE,
+
+/* TRYSEND */
+0x80|'D', 'N', 'E', 'S', '-', 'Y', 'R', 'T',
+#undef ROMDEF_LAST
+#define ROMDEF_TRYSEND 0xCE90
+#define ROMDEF_LAST 0xCE90
+8, 0xCE,0x83, 0, TRYSEND,
 
 /* TUCK */
 0x80|'K', 'C', 'U', 'T',
 #undef ROMDEF_LAST
-#define ROMDEF_TUCK 0xCD4B
-#define ROMDEF_LAST 0xCD4B
-4, 0xCD,0x42, 0, TUCK,
+#define ROMDEF_TUCK 0xCE99
+#define ROMDEF_LAST 0xCE99
+4, 0xCE,0x90, 0, TUCK,
+
+/* TURNKEY */
+0x80|'Y', 'E', 'K', 'N', 'R', 'U', 'T',
+#undef ROMDEF_LAST
+#define ROMDEF_TURNKEY 0xCEA5
+#define ROMDEF_LAST 0xCEA5
+7, 0xCE,0x99, 0, DOCOLONROM,
+0xC0,0x24, STORE, EXIT,
 
 /* TYPE */
 0x80|'E', 'P', 'Y', 'T',
 #undef ROMDEF_LAST
-#define ROMDEF_TYPE 0xCD54
-#define ROMDEF_LAST 0xCD54
-4, 0xCD,0x4B, 0, DOCOLONROM,
-OVER, PLUS, SWAP, TWODUP, NOTEQUALS, IZBRANCH, 7, DUP, CFETCH, EMIT, ONEPLUS, IBRANCH, -9, TWODROP, EXIT,
+#define ROMDEF_TYPE 0xCEB2
+#define ROMDEF_LAST 0xCEB2
+4, 0xCE,0xA5, 0, TYPE,
 
 /* UDOT */
 0x80|'.', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UDOT 0xCD6A
-#define ROMDEF_LAST 0xCD6A
-2, 0xCD,0x54, 0, DOCOLONROM,
-ZERO, 0xC5,0xB8, 0xC4,0x24, 0xC4,0x10, 0xCD,0x54, 0xCC,0xA4, EXIT,
+#define ROMDEF_UDOT 0xCEB9
+#define ROMDEF_LAST 0xCEB9
+2, 0xCE,0xB2, 0, DOCOLONROM,
+ZERO, ZERO, DDOTR, 0xCE,0x0C, EXIT,
+
+/* UDOTR */
+0x80|'R', '.', 'U',
+#undef ROMDEF_LAST
+#define ROMDEF_UDOTR 0xCEC7
+#define ROMDEF_LAST 0xCEC7
+3, 0xCE,0xB9, 0, DOCOLONROM,
+ZERO, SWAP, DDOTR, EXIT,
 
 /* ULESSTHAN */
 0x80|'<', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_ULESSTHAN 0xCD7D
-#define ROMDEF_LAST 0xCD7D
-2, 0xCD,0x6A, 0, ULESSTHAN,
+#define ROMDEF_ULESSTHAN 0xCED2
+#define ROMDEF_LAST 0xCED2
+2, 0xCE,0xC7, 0, ULESSTHAN,
 
 /* UGREATERTHAN */
 0x80|'>', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UGREATERTHAN 0xCD84
-#define ROMDEF_LAST 0xCD84
-2, 0xCD,0x7D, 0, UGREATERTHAN,
+#define ROMDEF_UGREATERTHAN 0xCED9
+#define ROMDEF_LAST 0xCED9
+2, 0xCE,0xD2, 0, UGREATERTHAN,
 
 /* UDDOT */
 0x80|'.', 'D', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UDDOT 0xCD8C
-#define ROMDEF_LAST 0xCD8C
-3, 0xCD,0x84, 0, DOCOLONROM,
-0xC5,0xB8, 0xC4,0x24, 0xC4,0x10, 0xCD,0x54, 0xCC,0xA4, EXIT,
+#define ROMDEF_UDDOT 0xCEE1
+#define ROMDEF_LAST 0xCEE1
+3, 0xCE,0xD9, 0, DOCOLONROM,
+0xC5,0x85, 0xC3,0xE2, 0xC3,0xD2, TYPE, 0xCE,0x0C, EXIT,
 
 /* UMSTAR */
 0x80|'*', 'M', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UMSTAR 0xCD9F
-#define ROMDEF_LAST 0xCD9F
-3, 0xCD,0x8C, 0, UMSTAR,
+#define ROMDEF_UMSTAR 0xCEF3
+#define ROMDEF_LAST 0xCEF3
+3, 0xCE,0xE1, 0, UMSTAR,
 
 /* UMSLASHMOD */
 0x80|'D', 'O', 'M', '/', 'M', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UMSLASHMOD 0xCDAA
-#define ROMDEF_LAST 0xCDAA
-6, 0xCD,0x9F, 0, UMSLASHMOD,
+#define ROMDEF_UMSLASHMOD 0xCEFE
+#define ROMDEF_LAST 0xCEFE
+6, 0xCE,0xF3, 0, UMSLASHMOD,
 
 /* UNLOOP */
 0x80|'P', 'O', 'O', 'L', 'N', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UNLOOP 0xCDB5
-#define ROMDEF_LAST 0xCDB5
-6, 0xCD,0xAA, 0, UNLOOP,
+#define ROMDEF_UNLOOP 0xCF09
+#define ROMDEF_LAST 0xCF09
+6, 0xCE,0xFE, 0, UNLOOP,
 
 /* UNTIL */
 0x80|'L', 'I', 'T', 'N', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UNTIL 0xCDBF
-#define ROMDEF_LAST 0xCDBF
-0x80|5, 0xCD,0xB5, 0, DOCOLONROM,
-ICHARLIT, ZBRANCH, 0xC7,0x96, 0xC9,0xDC, MINUS, 0xC7,0x34, EXIT,
+#define ROMDEF_UNTIL 0xCF13
+#define ROMDEF_LAST 0xCF13
+0x80|5, 0xCF,0x09, 0, DOCOLONROM,
+ICHARLIT, ZBRANCH, 0xC7,0x87, 0xCA,0x21, MINUS, 0xC7,0x1E, EXIT,
 
 /* UNUSED */
 0x80|'D', 'E', 'S', 'U', 'N', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_UNUSED 0xCDD4
-#define ROMDEF_LAST 0xCDD4
-6, 0xCD,0xBF, 0, DOCOLONROM,
-VM, ICHARLIT, offsetof(EnforthVM, dictionary), PLUS, FETCH, VM, ICHARLIT, offsetof(EnforthVM, dictionary_size), PLUS, FETCH, PLUS, 0xC9,0xDC, MINUS, EXIT,
+#define ROMDEF_UNUSED 0xCF28
+#define ROMDEF_LAST 0xCF28
+6, 0xCF,0x13, 0, DOCOLONROM,
+VM, ICHARLIT, offsetof(EnforthVM, dictionary), PLUS, FETCH, VM, ICHARLIT, offsetof(EnforthVM, dictionary_size), PLUS, FETCH, PLUS, 0xCA,0x21, MINUS, EXIT,
 
 /* USE */
 0x80|':', 'E', 'S', 'U',
 #undef ROMDEF_LAST
-#define ROMDEF_USE 0xCDEC
-#define ROMDEF_LAST 0xCDEC
-4, 0xCD,0xD4, 0, DOCOLONROM,
-0xC7,0x23, 0xCB,0x34, DUP, ZEROEQUALS, IZBRANCH, 2, ABORT, TWODUP, 0xC1,0x6C, ZEROEQUALS, IZBRANCH, 11, 0xCD,0x54, 0xCC,0xA4, ICHARLIT, '?', EMIT, 0xC7,0xE5, ABORT, 0xC9,0xDC, 0xC0,0x79, ROT, ICHARLIT, 32, OR, 0xC7,0x34, 0xC2,0xF9, FETCH, 0xC3,0xB7, 0xC2,0xF9, STORE, ICHARLIT, DOFFI0, OVER, 0xC1,0x46, PLUS, 0xC3,0xB7, 0xC6,0xE2, 0xC4,0x9A, DROP, EXIT,
+#define ROMDEF_USE 0xCF40
+#define ROMDEF_LAST 0xCF40
+4, 0xCF,0x28, 0, DOCOLONROM,
+0xC7,0x00, PARSEWORD, DUP, ZEROEQUALS, IZBRANCH, 2, ABORT, FINDROMFFI, IZBRANCH, 3, DROP, EXIT, TWODUP, 0xC1,0x65, ZEROEQUALS, IZBRANCH, 10, TYPE, 0xCE,0x0C, ICHARLIT, '?', EMIT, 0xC7,0xDF, ABORT, 0xCA,0x21, 0xC0,0xA7, ROT, ICHARLIT, 32, OR, 0xC7,0x1E, 0xC2,0xEB, FETCH, 0xC3,0x79, 0xC2,0xEB, STORE, ICHARLIT, DOFFI, 0xC3,0x79, 0xC6,0xA7, 0xC4,0x55, ZERO, 0xC4,0x55, DROP, EXIT,
 
 /* VARIABLE */
 0x80|'E', 'L', 'B', 'A', 'I', 'R', 'A', 'V',
 #undef ROMDEF_LAST
-#define ROMDEF_VARIABLE 0xCE32
-#define ROMDEF_LAST 0xCE32
-8, 0xCD,0xEC, 0, DOCOLONROM,
-0xC7,0xF4, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xFA, ICHARLIT, DOVARIABLE, 0xC3,0xB7, ZERO, 0xC4,0x9A, EXIT,
+#define ROMDEF_VARIABLE 0xCF88
+#define ROMDEF_LAST 0xCF88
+8, 0xCF,0x40, 0, DOCOLONROM,
+0xC7,0xEE, ZERO, ONEMINUS, ONEMINUS, 0xC6,0xBF, ICHARLIT, DOVARIABLE, 0xC3,0x79, ZERO, 0xC4,0x55, EXIT,
 
 /* WHILE */
 0x80|'E', 'L', 'I', 'H', 'W',
 #undef ROMDEF_LAST
-#define ROMDEF_WHILE 0xCE4B
-#define ROMDEF_LAST 0xCE4B
-0x80|5, 0xCE,0x32, 0, DOCOLONROM,
-0xCA,0x0D, SWAP, EXIT,
+#define ROMDEF_WHILE 0xCFA1
+#define ROMDEF_LAST 0xCFA1
+0x80|5, 0xCF,0x88, 0, DOCOLONROM,
+0xCA,0x55, SWAP, EXIT,
 
 /* WORDS */
 0x80|'S', 'D', 'R', 'O', 'W',
 #undef ROMDEF_LAST
-#define ROMDEF_WORDS 0xCE59
-#define ROMDEF_LAST 0xCE59
-5, 0xCE,0x4B, 0, DOCOLONROM,
-0xC2,0xF9, FETCH, QDUP, IZBRANCH, 59, DUP, 0xC1,0x3A, IZBRANCH, 16, DUP, 0xC0,0x64, DUP, 0xC1,0x50, SWAP, 0xC1,0x5A, 0xC2,0xD4, 0xCC,0xA4, IBRANCH, 35, DUP, 0xC0,0x9F, ICHARLIT, 64, AND, ZEROEQUALS, IZBRANCH, 28, DUP, DUP, 0xC3,0x0C, OVER, SWAP, MINUS, SWAP, TWODUP, NOTEQUALS, IZBRANCH, 11, ONEMINUS, DUP, 0xC0,0x9F, ICHARLIT, 127, AND, EMIT, IBRANCH, -13, TWODROP, 0xCC,0xA4, 0xC3,0x03, IBRANCH, -60, EXIT,
+#define ROMDEF_WORDS 0xCFAF
+#define ROMDEF_LAST 0xCFAF
+5, 0xCF,0xA1, 0, DOCOLONROM,
+0xC2,0xEB, FETCH, QDUP, IZBRANCH, 59, DUP, 0xC1,0x3D, IZBRANCH, 16, DUP, 0xC0,0x8D, DUP, 0xC1,0x49, SWAP, 0xC1,0x53, 0xC2,0xC6, 0xCE,0x0C, IBRANCH, 35, DUP, 0xC0,0xCD, ICHARLIT, 64, AND, ZEROEQUALS, IZBRANCH, 28, DUP, DUP, 0xC2,0xFE, OVER, SWAP, MINUS, SWAP, TWODUP, NOTEQUALS, IZBRANCH, 11, ONEMINUS, DUP, 0xC0,0xCD, ICHARLIT, 127, AND, EMIT, IBRANCH, -13, TWODROP, 0xCE,0x0C, 0xC2,0xF5, IBRANCH, -60, EXIT,
 
 /* XOR */
 0x80|'R', 'O', 'X',
 #undef ROMDEF_LAST
-#define ROMDEF_XOR 0xCEA2
-#define ROMDEF_LAST 0xCEA2
-3, 0xCE,0x59, 0, XOR,
+#define ROMDEF_XOR 0xCFF8
+#define ROMDEF_LAST 0xCFF8
+3, 0xCF,0xAF, 0, XOR,
 
 /* LTBRACKET */
 0x80|'[',
 #undef ROMDEF_LAST
-#define ROMDEF_LTBRACKET 0xCEA8
-#define ROMDEF_LAST 0xCEA8
-0x80|1, 0xCE,0xA2, 0, DOCOLONROM,
-FALSE, 0xCC,0xC6, STORE, EXIT,
+#define ROMDEF_LTBRACKET 0xCFFE
+#define ROMDEF_LAST 0xCFFE
+0x80|1, 0xCF,0xF8, 0, DOCOLONROM,
+FALSE, 0xCE,0x2E, STORE, EXIT,
 
 /* BRACKETTICK */
 0x80|']', '\'', '[',
 #undef ROMDEF_LAST
-#define ROMDEF_BRACKETTICK 0xCEB5
-#define ROMDEF_LAST 0xCEB5
-0x80|3, 0xCE,0xA8, 0, DOCOLONROM,
-0xC4,0x33, ICHARLIT, LIT, 0xC7,0x96, 0xC4,0x9A, EXIT,
+#define ROMDEF_BRACKETTICK 0xD00B
+#define ROMDEF_LAST 0xD00B
+0x80|3, 0xCF,0xFE, 0, DOCOLONROM,
+0xC3,0xF1, ICHARLIT, LIT, 0xC7,0x87, 0xC4,0x55, EXIT,
 
 /* BRACKETCHAR */
 0x80|']', 'R', 'A', 'H', 'C', '[',
 #undef ROMDEF_LAST
-#define ROMDEF_BRACKETCHAR 0xCEC9
-#define ROMDEF_LAST 0xCEC9
-0x80|6, 0xCE,0xB5, 0, DOCOLONROM,
-0xC7,0x6B, ICHARLIT, CHARLIT, 0xC7,0x96, 0xC7,0x34, EXIT,
+#define ROMDEF_BRACKETCHAR 0xD01F
+#define ROMDEF_LAST 0xD01F
+0x80|6, 0xD0,0x0B, 0, DOCOLONROM,
+0xC7,0x5D, ICHARLIT, CHARLIT, 0xC7,0x87, 0xC7,0x1E, EXIT,
 
 /* BACKSLASH */
 0x80|'\\',
 #undef ROMDEF_LAST
-#define ROMDEF_BACKSLASH 0xCED8
-#define ROMDEF_LAST 0xCED8
-0x80|1, 0xCE,0xC9, 0, DOCOLONROM,
-0xCC,0x94, NIP, 0xC5,0xF0, STORE, EXIT,
+#define ROMDEF_BACKSLASH 0xD02E
+#define ROMDEF_LAST 0xD02E
+0x80|1, 0xD0,0x1F, 0, DOCOLONROM,
+ICHARLIT, 10, PARSE, TWODROP, EXIT,
 
 /* RTBRACKET */
 0x80|']',
 #undef ROMDEF_LAST
-#define ROMDEF_RTBRACKET 0xCEE5
-#define ROMDEF_LAST 0xCEE5
-1, 0xCE,0xD8, 0, DOCOLONROM,
-TRUE, 0xCC,0xC6, STORE, EXIT,
+#define ROMDEF_RTBRACKET 0xD039
+#define ROMDEF_LAST 0xD039
+1, 0xD0,0x2E, 0, DOCOLONROM,
+TRUE, 0xCE,0x2E, STORE, EXIT,
 
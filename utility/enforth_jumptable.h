@@ -1,6 +1,8 @@
 &&TICKROMDEF,
 &&PPLUSLOOP,
 &&PQDO,
+&&PACCEPT,
+&&PAWAIT,
 &&PDO,
 &&PHALT,
 &&PILOOP,
@@ -8,21 +10,30 @@
 &&PKEY,
 &&LIT,
 &&PLOOP,
+&&PPARK,
+&&PREFILL,
 &&PSQUOTE,
 &&ZBRANCH,
+&&PUSHSOURCE,
 &&BRANCH,
 &&CHARLIT,
+&&FINDROMFFI,
+&&HLDEND,
 &&IFETCH,
 &&IBRANCH,
 &&ICFETCH,
 &&ICHARLIT,
 &&INITRP,
 &&IZBRANCH,
+&&NUMBERQ,
+&&OPENSOURCE,
+&&POPSOURCE,
 &&VM,
 &&STORE,
 &&PLUS,
 &&PLUSSTORE,
 &&MINUS,
+&&DOTFFISTATS,
 &&ZERO,
 &&ZEROLESS,
 &&ZERONOTEQUALS,
@@ -45,15 +56,23 @@
 &&NOTEQUALS,
 &&EQUALS,
 &&GREATERTHAN,
+&&TONUMBER,
 &&TOR,
+&&QDEQUEUE,
 &&QDUP,
+&&QRECEIVE,
 &&FETCH,
 &&ABORT,
 &&ABS,
 &&AND,
+&&ATOMICSTORE,
+&&ATOMICFETCH,
 &&BASE,
+&&BLOCKON,
 &&CSTORE,
 &&CFETCH,
+&&CAS,
+&&DDOTR,
 &&DEPTH,
 &&DROP,
 &&DUP,
@@ -71,19 +90,26 @@
 &&MAX,
 &&MIN,
 &&MOVE,
+&&MS,
 &&NEGATE,
 &&NIP,
 &&OR,
 &&OVER,
+&&PARSE,
+&&PARSEWORD,
 &&PAUSE,
 &&RFROM,
 &&RFETCH,
 &&ROT,
 &&RSHIFT,
 &&SAVE,
+&&SLEEPUNTIL,
 &&SWAP,
+&&TICKS,
 &&TRUE,
+&&TRYSEND,
 &&TUCK,
+&&TYPE,
 &&ULESSTHAN,
 &&UGREATERTHAN,
 &&UMSTAR,
@@ -92,21 +118,3 @@
 &&XOR,
 0,
 0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
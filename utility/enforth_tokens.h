@@ -1,92 +1,118 @@
 TICKROMDEF = 0x00,
 PPLUSLOOP = 0x01,
 PQDO = 0x02,
-PDO = 0x03,
-PHALT = 0x04,
-PILOOP = 0x05,
-PISQUOTE = 0x06,
-PKEY = 0x07,
-LIT = 0x08,
-PLOOP = 0x09,
-PSQUOTE = 0x0a,
-ZBRANCH = 0x0b,
-BRANCH = 0x0c,
-CHARLIT = 0x0d,
-IFETCH = 0x0e,
-IBRANCH = 0x0f,
-ICFETCH = 0x10,
-ICHARLIT = 0x11,
-INITRP = 0x12,
-IZBRANCH = 0x13,
-VM = 0x14,
-STORE = 0x15,
-PLUS = 0x16,
-PLUSSTORE = 0x17,
-MINUS = 0x18,
-ZERO = 0x19,
-ZEROLESS = 0x1a,
-ZERONOTEQUALS = 0x1b,
-ZEROEQUALS = 0x1c,
-ONEPLUS = 0x1d,
-ONEMINUS = 0x1e,
-TWOSTORE = 0x1f,
-TWOSTAR = 0x20,
-TWOSLASH = 0x21,
-TWOTOR = 0x22,
-TWOFETCH = 0x23,
-TWODROP = 0x24,
-TWODUP = 0x25,
-TWONIP = 0x26,
-TWOOVER = 0x27,
-TWORFROM = 0x28,
-TWORFETCH = 0x29,
-TWOSWAP = 0x2a,
-LESSTHAN = 0x2b,
-NOTEQUALS = 0x2c,
-EQUALS = 0x2d,
-GREATERTHAN = 0x2e,
-TOR = 0x2f,
-QDUP = 0x30,
-FETCH = 0x31,
-ABORT = 0x32,
-ABS = 0x33,
-AND = 0x34,
-BASE = 0x35,
-CSTORE = 0x36,
-CFETCH = 0x37,
-DEPTH = 0x38,
-DROP = 0x39,
-DUP = 0x3a,
-EMIT = 0x3b,
-EXECUTE = 0x3c,
-EXIT = 0x3d,
-FALSE = 0x3e,
-I = 0x3f,
-INVERT = 0x40,
-J = 0x41,
-KEYQ = 0x42,
-LOAD = 0x43,
-LSHIFT = 0x44,
-MPLUS = 0x45,
-MAX = 0x46,
-MIN = 0x47,
-MOVE = 0x48,
-NEGATE = 0x49,
-NIP = 0x4a,
-OR = 0x4b,
-OVER = 0x4c,
-PAUSE = 0x4d,
-RFROM = 0x4e,
-RFETCH = 0x4f,
-ROT = 0x50,
-RSHIFT = 0x51,
-SAVE = 0x52,
-SWAP = 0x53,
-TRUE = 0x54,
-TUCK = 0x55,
-ULESSTHAN = 0x56,
-UGREATERTHAN = 0x57,
-UMSTAR = 0x58,
-UMSLASHMOD = 0x59,
-UNLOOP = 0x5a,
-XOR = 0x5b,
+PACCEPT = 0x03,
+PAWAIT = 0x04,
+PDO = 0x05,
+PHALT = 0x06,
+PILOOP = 0x07,
+PISQUOTE = 0x08,
+PKEY = 0x09,
+LIT = 0x0a,
+PLOOP = 0x0b,
+PPARK = 0x0c,
+PREFILL = 0x0d,
+PSQUOTE = 0x0e,
+ZBRANCH = 0x0f,
+PUSHSOURCE = 0x10,
+BRANCH = 0x11,
+CHARLIT = 0x12,
+FINDROMFFI = 0x13,
+HLDEND = 0x14,
+IFETCH = 0x15,
+IBRANCH = 0x16,
+ICFETCH = 0x17,
+ICHARLIT = 0x18,
+INITRP = 0x19,
+IZBRANCH = 0x1a,
+NUMBERQ = 0x1b,
+OPENSOURCE = 0x1c,
+POPSOURCE = 0x1d,
+VM = 0x1e,
+STORE = 0x1f,
+PLUS = 0x20,
+PLUSSTORE = 0x21,
+MINUS = 0x22,
+DOTFFISTATS = 0x23,
+ZERO = 0x24,
+ZEROLESS = 0x25,
+ZERONOTEQUALS = 0x26,
+ZEROEQUALS = 0x27,
+ONEPLUS = 0x28,
+ONEMINUS = 0x29,
+TWOSTORE = 0x2a,
+TWOSTAR = 0x2b,
+TWOSLASH = 0x2c,
+TWOTOR = 0x2d,
+TWOFETCH = 0x2e,
+TWODROP = 0x2f,
+TWODUP = 0x30,
+TWONIP = 0x31,
+TWOOVER = 0x32,
+TWORFROM = 0x33,
+TWORFETCH = 0x34,
+TWOSWAP = 0x35,
+LESSTHAN = 0x36,
+NOTEQUALS = 0x37,
+EQUALS = 0x38,
+GREATERTHAN = 0x39,
+TONUMBER = 0x3a,
+TOR = 0x3b,
+QDEQUEUE = 0x3c,
+QDUP = 0x3d,
+QRECEIVE = 0x3e,
+FETCH = 0x3f,
+ABORT = 0x40,
+ABS = 0x41,
+AND = 0x42,
+ATOMICSTORE = 0x43,
+ATOMICFETCH = 0x44,
+BASE = 0x45,
+BLOCKON = 0x46,
+CSTORE = 0x47,
+CFETCH = 0x48,
+CAS = 0x49,
+DDOTR = 0x4a,
+DEPTH = 0x4b,
+DROP = 0x4c,
+DUP = 0x4d,
+EMIT = 0x4e,
+EXECUTE = 0x4f,
+EXIT = 0x50,
+FALSE = 0x51,
+I = 0x52,
+INVERT = 0x53,
+J = 0x54,
+KEYQ = 0x55,
+LOAD = 0x56,
+LSHIFT = 0x57,
+MPLUS = 0x58,
+MAX = 0x59,
+MIN = 0x5a,
+MOVE = 0x5b,
+MS = 0x5c,
+NEGATE = 0x5d,
+NIP = 0x5e,
+OR = 0x5f,
+OVER = 0x60,
+PARSE = 0x61,
+PARSEWORD = 0x62,
+PAUSE = 0x63,
+RFROM = 0x64,
+RFETCH = 0x65,
+ROT = 0x66,
+RSHIFT = 0x67,
+SAVE = 0x68,
+SLEEPUNTIL = 0x69,
+SWAP = 0x6a,
+TICKS = 0x6b,
+TRUE = 0x6c,
+TRYSEND = 0x6d,
+TUCK = 0x6e,
+TYPE = 0x6f,
+ULESSTHAN = 0x70,
+UGREATERTHAN = 0x71,
+UMSTAR = 0x72,
+UMSLASHMOD = 0x73,
+UNLOOP = 0x74,
+XOR = 0x75,